@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwmechanics/pathgrid.hpp"
+
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/loadpgrd.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace MWMechanics;
+
+    // Optional content file to take pathgrids from instead of generated ones
+    constexpr const char* contentEnvironmentVariable = "OPENMW_BENCHMARK_PATHGRID_CONTENT";
+
+    // Similar to autogenerated pathgrids: points on a lattice connected to the neighbours with some gaps
+    ESM::Pathgrid generatePathgrid(int side, auto& random)
+    {
+        constexpr int granularity = 256;
+        std::uniform_int_distribution<int> offset(-granularity / 4, granularity / 4);
+        std::bernoulli_distribution hasEdge(0.8);
+        ESM::Pathgrid result;
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x)
+                result.mPoints.emplace_back(
+                    x * granularity + offset(random), y * granularity + offset(random), offset(random));
+        const auto connect = [&](std::size_t a, std::size_t b) {
+            if (!hasEdge(random))
+                return;
+            result.mEdges.push_back(ESM::Pathgrid::Edge{ a, b });
+            result.mEdges.push_back(ESM::Pathgrid::Edge{ b, a });
+        };
+        for (int y = 0; y < side; ++y)
+        {
+            for (int x = 0; x < side; ++x)
+            {
+                const std::size_t index = static_cast<std::size_t>(y * side + x);
+                if (x + 1 < side)
+                    connect(index, index + 1);
+                if (y + 1 < side)
+                    connect(index, index + static_cast<std::size_t>(side));
+            }
+        }
+        return result;
+    }
+
+    std::vector<ESM::Pathgrid> loadPathgrids(const std::filesystem::path& path)
+    {
+        std::vector<ESM::Pathgrid> result;
+        ESM::ESMReader esm;
+        esm.open(path);
+        while (esm.hasMoreRecs())
+        {
+            const ESM::NAME name = esm.getRecName();
+            esm.getRecHeader();
+            if (name.toInt() != ESM::REC_PGRD)
+            {
+                esm.skipRecord();
+                continue;
+            }
+            ESM::Pathgrid pathgrid;
+            bool isDeleted = false;
+            pathgrid.load(esm, isDeleted);
+            if (!isDeleted && !pathgrid.mPoints.empty())
+                result.push_back(std::move(pathgrid));
+        }
+        return result;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> generateConnectedPairs(
+        const PathgridGraph& graph, std::size_t count, auto& random)
+    {
+        const std::size_t size = graph.getPathgrid()->mPoints.size();
+        std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+        std::vector<std::pair<std::size_t, std::size_t>> result;
+        for (std::size_t i = 0; i < count * 16 && result.size() < count; ++i)
+        {
+            const std::size_t start = distribution(random);
+            const std::size_t end = distribution(random);
+            if (graph.isPointConnected(start, end))
+                result.emplace_back(start, end);
+        }
+        return result;
+    }
+
+    void runSearches(benchmark::State& state, const std::vector<ESM::Pathgrid>& pathgrids)
+    {
+        std::minstd_rand random;
+        std::vector<PathgridGraph> graphs;
+        graphs.reserve(pathgrids.size());
+        std::vector<std::vector<std::pair<std::size_t, std::size_t>>> pairs;
+        for (const ESM::Pathgrid& pathgrid : pathgrids)
+        {
+            const PathgridGraph& graph = graphs.emplace_back(pathgrid);
+            pairs.push_back(generateConnectedPairs(graph, 64, random));
+        }
+        std::size_t graph = 0;
+        std::size_t pair = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            if (pair >= pairs[graph].size())
+            {
+                pair = 0;
+                graph = (graph + 1) % graphs.size();
+                if (pairs[graph].empty())
+                    continue;
+            }
+            const auto [start, end] = pairs[graph][pair++];
+            benchmark::DoNotOptimize(graphs[graph].aStarSearch(start, end));
+        }
+    }
+
+    void aStarSearchGenerated(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<ESM::Pathgrid> pathgrids;
+        for (int i = 0; i < 16; ++i)
+            pathgrids.push_back(generatePathgrid(static_cast<int>(state.range(0)), random));
+        runSearches(state, pathgrids);
+    }
+
+    void aStarSearchContent(benchmark::State& state)
+    {
+        const char* const path = std::getenv(contentEnvironmentVariable);
+        if (path == nullptr)
+        {
+            state.SkipWithError("OPENMW_BENCHMARK_PATHGRID_CONTENT is not set");
+            return;
+        }
+        const std::vector<ESM::Pathgrid> pathgrids = loadPathgrids(path);
+        if (pathgrids.empty())
+        {
+            state.SkipWithError("No pathgrids found");
+            return;
+        }
+        runSearches(state, pathgrids);
+    }
+}
+
+BENCHMARK(aStarSearchGenerated)->Arg(4)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK(aStarSearchContent);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,451 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/simulationrecording.hpp"
+#include "apps/openmw/mwphysics/simulationreplay.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esm3/readerscache.hpp>
+#include <components/esmloader/esmdata.hpp>
+#include <components/esmloader/load.hpp>
+#include <components/fallback/fallback.hpp>
+#include <components/fallback/validate.hpp>
+#include <components/files/collections.hpp>
+#include <components/files/configurationmanager.hpp>
+#include <components/files/multidircollection.hpp>
+#include <components/misc/convert.hpp>
+#include <components/misc/strings/algorithm.hpp>
+#include <components/platform/platform.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapemanager.hpp>
+#include <components/resource/foreachbulletobject.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/niffilemanager.hpp>
+#include <components/resource/scenemanager.hpp>
+#include <components/settings/settings.hpp>
+#include <components/toutf8/toutf8.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/registerarchives.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    namespace bpo = boost::program_options;
+
+    using namespace MWPhysics;
+
+    using StringsVector = std::vector<std::string>;
+
+    constexpr unsigned maxThreads = 8;
+
+    constexpr int framesCount = 120;
+
+    SimulationReplay& getReplay()
+    {
+        // Bullet supports limited number of threads over the process lifetime so they are never recreated
+        static SimulationReplay replay(maxThreads);
+        return replay;
+    }
+
+    bpo::options_description makeOptionsDescription()
+    {
+        bpo::options_description result;
+        auto addOption = result.add_options();
+        addOption("help", "print help message");
+
+        addOption("data",
+            bpo::value<Files::MaybeQuotedPathContainer>()
+                ->default_value(Files::MaybeQuotedPathContainer(), "data")
+                ->multitoken()
+                ->composing(),
+            "set data directories (later directories have higher priority)");
+
+        addOption("data-local",
+            bpo::value<Files::MaybeQuotedPathContainer::value_type>()->default_value(
+                Files::MaybeQuotedPathContainer::value_type(), ""),
+            "set local data directory (highest priority)");
+
+        addOption("fallback-archive",
+            bpo::value<StringsVector>()->default_value(StringsVector(), "fallback-archive")->multitoken()->composing(),
+            "set fallback BSA archives (later archives have higher priority)");
+
+        addOption("content", bpo::value<StringsVector>()->default_value(StringsVector(), "")->multitoken()->composing(),
+            "content file(s): esm/esp, or omwgame/omwaddon/omwscripts");
+
+        addOption("encoding", bpo::value<std::string>()->default_value("win1252"), "content files encoding");
+
+        addOption("fallback",
+            bpo::value<Fallback::FallbackMap>()->default_value(Fallback::FallbackMap(), "")->multitoken()->composing(),
+            "fallback values");
+
+        addOption("cell",
+            bpo::value<StringsVector>()
+                ->default_value(StringsVector{ "-3,-2", "-2,-2", "-3,-3", "-2,-3" }, "Balmora")
+                ->multitoken()
+                ->composing(),
+            "cells to load collision data from: interior cell name or exterior cell grid position as x,y");
+
+        Files::ConfigurationManager::addCommonOptions(result);
+
+        return result;
+    }
+
+    struct CellFilter
+    {
+        std::vector<std::string> mInteriors;
+        std::vector<std::pair<int, int>> mExteriors;
+
+        explicit CellFilter(const StringsVector& cells)
+        {
+            for (const std::string& cell : cells)
+            {
+                const std::size_t separator = cell.find(',');
+                int x = 0;
+                int y = 0;
+                if (separator != std::string::npos
+                    && std::from_chars(cell.data(), cell.data() + separator, x).ec == std::errc()
+                    && std::from_chars(cell.data() + separator + 1, cell.data() + cell.size(), y).ec == std::errc())
+                    mExteriors.emplace_back(x, y);
+                else
+                    mInteriors.push_back(cell);
+            }
+        }
+
+        bool operator()(const ESM::Cell& cell) const
+        {
+            if (cell.isExterior())
+                return std::find(mExteriors.begin(), mExteriors.end(),
+                           std::make_pair(static_cast<int>(cell.getGridX()), static_cast<int>(cell.getGridY())))
+                    != mExteriors.end();
+            return std::any_of(mInteriors.begin(), mInteriors.end(),
+                [&](const std::string& name) { return Misc::StringUtils::ciEqual(name, cell.mName); });
+        }
+    };
+
+    // Same triangulation for all cells, the difference with btHeightfieldTerrainShape is not important here
+    void addTerrain(const std::vector<ESM::Land>& lands, int cellX, int cellY, std::vector<osg::Vec3f>& triangles)
+    {
+        const auto land = std::find_if(
+            lands.begin(), lands.end(), [&](const ESM::Land& v) { return v.mX == cellX && v.mY == cellY; });
+
+        std::optional<ESM::Land::LandData> landData;
+        if (land != lands.end() && (land->mDataTypes & ESM::Land::DATA_VHGT) != 0)
+            land->loadData(ESM::Land::DATA_VHGT, landData.emplace());
+
+        constexpr int size = ESM::Land::LAND_SIZE;
+        constexpr float step = static_cast<float>(ESM::Land::REAL_SIZE) / (size - 1);
+        const osg::Vec2f origin(static_cast<float>(cellX * ESM::Land::REAL_SIZE),
+            static_cast<float>(cellY * ESM::Land::REAL_SIZE));
+        const auto vertex = [&](int x, int y) {
+            const float height = landData.has_value() ? landData->mHeights[y * size + x]
+                                                      : static_cast<float>(ESM::Land::DEFAULT_HEIGHT);
+            return osg::Vec3f(origin.x() + x * step, origin.y() + y * step, height);
+        };
+
+        for (int y = 0; y + 1 < size; ++y)
+            for (int x = 0; x + 1 < size; ++x)
+            {
+                triangles.push_back(vertex(x, y));
+                triangles.push_back(vertex(x + 1, y));
+                triangles.push_back(vertex(x + 1, y + 1));
+                triangles.push_back(vertex(x, y));
+                triangles.push_back(vertex(x + 1, y + 1));
+                triangles.push_back(vertex(x, y + 1));
+            }
+    }
+
+    std::vector<RecordedObject> loadWorld(bpo::variables_map& variables, const bpo::options_description& desc)
+    {
+        Files::ConfigurationManager config;
+        config.processPaths(variables, std::filesystem::current_path());
+        config.readConfiguration(variables, desc);
+
+        const std::string encoding(variables["encoding"].as<std::string>());
+        ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(encoding));
+
+        Files::PathContainer dataDirs(asPathContainer(variables["data"].as<Files::MaybeQuotedPathContainer>()));
+
+        auto local = variables["data-local"].as<Files::MaybeQuotedPathContainer::value_type>();
+        if (!local.empty())
+            dataDirs.push_back(std::move(local));
+
+        config.filterOutNonExistingPaths(dataDirs);
+
+        const auto& resDir = variables["resources"].as<Files::MaybeQuotedPath>();
+        dataDirs.insert(dataDirs.begin(), resDir / "vfs");
+        const Files::Collections fileCollections(dataDirs);
+        const auto& archives = variables["fallback-archive"].as<StringsVector>();
+        const auto& contentFiles = variables["content"].as<StringsVector>();
+
+        Fallback::Map::init(variables["fallback"].as<Fallback::FallbackMap>().mMap);
+
+        VFS::Manager vfs;
+
+        VFS::registerArchives(&vfs, fileCollections, archives, true, &encoder.getStatelessEncoder());
+
+        Settings::Manager::load(config);
+
+        ESM::ReadersCache readers;
+        EsmLoader::Query query;
+        query.mLoadActivators = true;
+        query.mLoadCells = true;
+        query.mLoadContainers = true;
+        query.mLoadDoors = true;
+        query.mLoadGameSettings = true;
+        query.mLoadLands = true;
+        query.mLoadStatics = true;
+        const EsmLoader::EsmData esmData
+            = EsmLoader::loadEsmData(query, contentFiles, fileCollections, readers, &encoder);
+
+        constexpr double expiryDelay = 0;
+        Resource::ImageManager imageManager(&vfs, expiryDelay);
+        Resource::NifFileManager nifFileManager(&vfs, &encoder.getStatelessEncoder());
+        Resource::BgsmFileManager bgsmFileManager(&vfs, expiryDelay);
+        Resource::SceneManager sceneManager(&vfs, &imageManager, &nifFileManager, &bgsmFileManager, expiryDelay);
+        Resource::BulletShapeManager bulletShapeManager(&vfs, &sceneManager, &nifFileManager, expiryDelay);
+
+        const CellFilter filter(variables["cell"].as<StringsVector>());
+
+        std::vector<RecordedObject> result;
+
+        for (const ESM::Cell& cell : esmData.mCells)
+        {
+            if (!cell.isExterior() || !filter(cell))
+                continue;
+            RecordedObject& terrain = result.emplace_back();
+            terrain.mId = static_cast<std::uint32_t>(result.size() - 1);
+            terrain.mCollisionGroup = CollisionType_HeightMap;
+            terrain.mCollisionMask = CollisionType_Actor | CollisionType_Projectile;
+            addTerrain(esmData.mLands, cell.getGridX(), cell.getGridY(), terrain.mTriangles);
+        }
+
+        Resource::forEachBulletObject(readers, vfs, bulletShapeManager, esmData, filter,
+            [&](const ESM::Cell& /*cell*/, const Resource::BulletObject& object) {
+                // Visual collision objects don't collide with actors
+                if (object.mShape->mCollisionShape == nullptr
+                    || object.mShape->mVisualCollisionType != Resource::VisualCollisionType::None)
+                    return;
+                const osg::ref_ptr<Resource::BulletShapeInstance> instance = Resource::makeInstance(object.mShape);
+                instance->setLocalScaling(btVector3(object.mScale, object.mScale, object.mScale));
+                RecordedObject recorded;
+                recorded.mId = static_cast<std::uint32_t>(result.size());
+                recorded.mCollisionGroup = CollisionType_World;
+                recorded.mCollisionMask = CollisionType_Actor | CollisionType_Projectile;
+                if (!collectTriangles(*instance->mCollisionShape, Misc::Convert::makeBulletTransform(object.mPosition),
+                        recorded.mTriangles))
+                    Log(Debug::Warning) << "Collision shape of " << object.mShape->mFileName
+                                        << " is partially supported";
+                if (!recorded.mTriangles.empty())
+                    result.push_back(std::move(recorded));
+            });
+
+        return result;
+    }
+
+    // Walkable surfaces to spawn actors on
+    std::vector<osg::Vec3f> findFloors(const std::vector<RecordedObject>& world)
+    {
+        std::vector<osg::Vec3f> result;
+        for (const RecordedObject& object : world)
+            for (std::size_t i = 0; i + 2 < object.mTriangles.size(); i += 3)
+            {
+                const osg::Vec3f& a = object.mTriangles[i];
+                const osg::Vec3f& b = object.mTriangles[i + 1];
+                const osg::Vec3f& c = object.mTriangles[i + 2];
+                osg::Vec3f normal = (b - a) ^ (c - a);
+                if (normal.normalize() == 0)
+                    continue;
+                if (std::abs(normal.z()) > 0.7f)
+                    result.push_back((a + b + c) / 3);
+            }
+        return result;
+    }
+
+    // Crowd of actors walking in random directions starting from random floors of the loaded cells
+    std::vector<RecordedFrame> generateFrames(const std::vector<RecordedObject>& world, int actorsCount)
+    {
+        constexpr float halfExtentsZ = 66;
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> angle(0, 2 * std::numbers::pi_v<float>);
+
+        RecordedFrame first;
+        first.mSteps = 1;
+        first.mPhysicsDt = 1.0f / 60;
+        first.mResetWorld = true;
+        first.mWorld = world;
+
+        const std::vector<osg::Vec3f> floors = findFloors(world);
+        if (floors.empty())
+            return {};
+        std::uniform_int_distribution<std::size_t> floor(0, floors.size() - 1);
+
+        for (int i = 0; i < actorsCount; ++i)
+        {
+            // Let the actor fall on the floor to not start inside of it
+            const osg::Vec3f position = floors[floor(random)] + osg::Vec3f(0, 0, 10);
+            first.mActors.push_back(RecordedActor{
+                .mId = static_cast<std::uint32_t>(i),
+                .mShape = RecordedActorShape::Box,
+                .mHalfExtents = osg::Vec3f(29, 28, halfExtentsZ),
+                .mMargin = 0.001f,
+                .mCollisionObjectPosition = position + osg::Vec3f(0, 0, halfExtentsZ),
+                .mCollisionObjectRotation = osg::Quat(),
+                .mCollisionGroup = CollisionType_Actor,
+                .mCollisionMask = CollisionType_Default,
+                .mPosition = position,
+                .mSwimLevel = -100000,
+                .mSlowFall = 1,
+                .mRotation = osg::Vec2f(0, angle(random)),
+                .mMovement = osg::Vec3f(0, 150, 0),
+                .mWaterlevel = -100000,
+                .mHalfExtentsZ = halfExtentsZ,
+                .mOldHeight = position.z(),
+            });
+        }
+
+        // Each frame starts where the previous one has ended
+        std::vector<RecordedFrame> result;
+        result.push_back(std::move(first));
+        for (int i = 0; i < framesCount; ++i)
+        {
+            RecordedFrame& frame = result.back();
+            frame.mResultPositions = getReplay().replay(frame, 1);
+            if (i + 1 == framesCount)
+                break;
+            RecordedFrame next = frame;
+            next.mResetWorld = false;
+            next.mWorld.clear();
+            next.mResultPositions.clear();
+            for (std::size_t j = 0; j < next.mActors.size(); ++j)
+            {
+                RecordedActor& actor = next.mActors[j];
+                const osg::Vec3f position = frame.mResultPositions[j];
+                actor.mCollisionObjectPosition += position - actor.mPosition;
+                actor.mPosition = position;
+                actor.mOldHeight = position.z();
+            }
+            result.push_back(std::move(next));
+        }
+        return result;
+    }
+
+    std::vector<std::vector<osg::Vec3f>> replay(
+        const std::vector<RecordedFrame>& frames, unsigned threads, LockingPolicy lockingPolicy)
+    {
+        std::vector<std::vector<osg::Vec3f>> result;
+        result.reserve(frames.size());
+        for (const RecordedFrame& frame : frames)
+            result.push_back(getReplay().replay(frame, threads, lockingPolicy));
+        return result;
+    }
+
+    void replayCells(benchmark::State& state, const std::vector<RecordedObject>& world,
+        std::map<int, std::vector<RecordedFrame>>& framesCache)
+    {
+        const int actors = static_cast<int>(state.range(0));
+        const unsigned threads = static_cast<unsigned>(state.range(1));
+        const LockingPolicy lockingPolicy = static_cast<LockingPolicy>(state.range(2));
+        if (threads > getReplay().getMaxThreads())
+        {
+            state.SkipWithError("Bullet does not support this number of threads");
+            return;
+        }
+
+        auto it = framesCache.find(actors);
+        if (it == framesCache.end())
+            it = framesCache.emplace(actors, generateFrames(world, actors)).first;
+        const std::vector<RecordedFrame>& frames = it->second;
+        if (frames.empty())
+        {
+            state.SkipWithError("Loaded cells have no floor to place actors on");
+            return;
+        }
+
+        // Actors are moved independently within a step so results must depend neither on the number of threads nor
+        // on the locking policy
+        if (replay(frames, 1, LockingPolicy::NoLocks) != replay(frames, threads, lockingPolicy))
+        {
+            state.SkipWithError("Replay results depend on the number of threads or locking policy");
+            return;
+        }
+
+        std::size_t steps = 0;
+        std::size_t actorSteps = 0;
+        for (const RecordedFrame& frame : frames)
+        {
+            steps += frame.mSteps;
+            actorSteps += frame.mSteps * frame.mActors.size();
+        }
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(replay(frames, threads, lockingPolicy));
+
+        state.counters["steps"]
+            = benchmark::Counter(static_cast<double>(steps * state.iterations()), benchmark::Counter::kIsRate);
+        state.counters["actor_steps"]
+            = benchmark::Counter(static_cast<double>(actorSteps * state.iterations()), benchmark::Counter::kIsRate);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Platform::init();
+
+    benchmark::Initialize(&argc, argv);
+
+    const bpo::options_description desc = makeOptionsDescription();
+    bpo::variables_map variables;
+    bpo::store(bpo::command_line_parser(argc, argv).options(desc).allow_unregistered().run(), variables);
+    bpo::notify(variables);
+
+    if (variables.find("help") != variables.end())
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    const std::vector<RecordedObject> world = loadWorld(variables, desc);
+    if (world.empty())
+    {
+        std::cerr << "No collision data is found for the given cells" << std::endl;
+        return 1;
+    }
+
+    std::size_t triangles = 0;
+    for (const RecordedObject& object : world)
+        triangles += object.mTriangles.size() / 3;
+    Log(Debug::Info) << "Loaded " << world.size() << " collision objects with " << triangles << " triangles";
+
+    std::map<int, std::vector<RecordedFrame>> framesCache;
+
+    benchmark::RegisterBenchmark("replayCells",
+        [&](benchmark::State& state) { replayCells(state, world, framesCache); })
+        ->ArgNames({ "actors", "threads", "locking" })
+        ->ArgsProduct({ { 64, 256 }, { 1, 2, 4, 8 },
+            { static_cast<int>(LockingPolicy::NoLocks), static_cast<int>(LockingPolicy::ExclusiveLocksOnly),
+                static_cast<int>(LockingPolicy::AllowSharedLocks) } });
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwphysics/heightfieldshape.hpp"
+
+#include <components/bullethelpers/heightfield.hpp>
+
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace MWPhysics;
+
+#if BT_BULLET_VERSION < 310
+    using Height = btScalar;
+#else
+    using Height = float;
+#endif
+
+    constexpr int verts = 65;
+    constexpr int size = 8192;
+    constexpr int queriesCount = 4096;
+    const btVector3 actorHalfExtents(29, 28, 66);
+
+    enum class ShapeType
+    {
+        Bullet,
+        HeightFieldShape,
+    };
+
+    struct Query
+    {
+        btVector3 mFrom;
+        btVector3 mTo;
+    };
+
+    float getHeight(float x, float y)
+    {
+        return 1500 * std::sin(x / 1100) * std::cos(y / 900) + 200 * std::sin(x / 190 + y / 230);
+    }
+
+    struct Terrain
+    {
+        std::vector<Height> mHeights;
+        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        btCollisionObject mObject;
+
+        explicit Terrain(ShapeType type)
+        {
+            const float step = static_cast<float>(size) / (verts - 1);
+            mHeights.reserve(verts * verts);
+            for (int y = 0; y < verts; ++y)
+                for (int x = 0; x < verts; ++x)
+                    mHeights.push_back(getHeight(x * step, y * step));
+            const float minHeight = *std::min_element(mHeights.begin(), mHeights.end());
+            const float maxHeight = *std::max_element(mHeights.begin(), mHeights.end());
+
+            switch (type)
+            {
+                case ShapeType::Bullet:
+#if BT_BULLET_VERSION < 310
+                    mShape = std::make_unique<btHeightfieldTerrainShape>(
+                        verts, verts, mHeights.data(), 1, minHeight, maxHeight, 2, PHY_FLOAT, false);
+#else
+                    mShape = std::make_unique<btHeightfieldTerrainShape>(
+                        verts, verts, mHeights.data(), minHeight, maxHeight, 2, false);
+#endif
+                    mShape->setUseDiamondSubdivision(true);
+                    break;
+                case ShapeType::HeightFieldShape:
+                    mShape = std::make_unique<HeightFieldShape>(verts, mHeights.data(), minHeight, maxHeight);
+                    break;
+            }
+
+            mShape->setLocalScaling(btVector3(step, step, 1));
+#if BT_BULLET_VERSION >= 289
+            mShape->buildAccelerator();
+#endif
+            mObject.setCollisionShape(mShape.get());
+            mObject.setWorldTransform(btTransform(
+                btQuaternion::getIdentity(), BulletHelpers::getHeightfieldShift(0, 0, size, minHeight, maxHeight)));
+        }
+    };
+
+    // Actors ground checks and one frame movements along the ground
+    std::vector<Query> generateActorQueries()
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> coordinate(0, size);
+        std::uniform_real_distribution<float> angle(0, 2 * std::numbers::pi_v<float>);
+        std::vector<Query> result;
+        result.reserve(queriesCount);
+        for (int i = 0; i < queriesCount; ++i)
+        {
+            const float x = coordinate(random);
+            const float y = coordinate(random);
+            const btVector3 center(x, y, getHeight(x, y) + actorHalfExtents.z() + 1);
+            if (i % 2 == 0)
+            {
+                result.push_back(Query{ center, center - btVector3(0, 0, 64) });
+                continue;
+            }
+            const float direction = angle(random);
+            result.push_back(Query{ center, center + btVector3(std::cos(direction), std::sin(direction), 0) * 2.5f });
+        }
+        return result;
+    }
+
+    // Vertical rays to find the ground and camera rays looking at the terrain
+    std::vector<Query> generateRayQueries()
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> coordinate(0, size);
+        std::uniform_real_distribution<float> angle(0, 2 * std::numbers::pi_v<float>);
+        std::vector<Query> result;
+        result.reserve(queriesCount);
+        for (int i = 0; i < queriesCount; ++i)
+        {
+            const float x = coordinate(random);
+            const float y = coordinate(random);
+            const btVector3 from(x, y, getHeight(x, y) + 200);
+            if (i % 2 == 0)
+            {
+                result.push_back(Query{ from, from - btVector3(0, 0, 10000) });
+                continue;
+            }
+            const float direction = angle(random);
+            result.push_back(
+                Query{ from, from + btVector3(std::cos(direction), std::sin(direction), -0.3f) * 4000.0f });
+        }
+        return result;
+    }
+
+    btScalar rayTest(Terrain& terrain, const Query& query)
+    {
+        btCollisionWorld::ClosestRayResultCallback callback(query.mFrom, query.mTo);
+        btCollisionWorld::rayTestSingle(btTransform(btQuaternion::getIdentity(), query.mFrom),
+            btTransform(btQuaternion::getIdentity(), query.mTo), &terrain.mObject, terrain.mShape.get(),
+            terrain.mObject.getWorldTransform(), callback);
+        return callback.m_closestHitFraction;
+    }
+
+    btScalar convexSweepTest(Terrain& terrain, const btConvexShape& shape, const Query& query)
+    {
+        btCollisionWorld::ClosestConvexResultCallback callback(query.mFrom, query.mTo);
+        btCollisionWorld::objectQuerySingle(&shape, btTransform(btQuaternion::getIdentity(), query.mFrom),
+            btTransform(btQuaternion::getIdentity(), query.mTo), &terrain.mObject, terrain.mShape.get(),
+            terrain.mObject.getWorldTransform(), callback, 0);
+        return callback.m_closestHitFraction;
+    }
+
+    std::unique_ptr<btBoxShape> makeActorShape()
+    {
+        auto result = std::make_unique<btBoxShape>(actorHalfExtents);
+        result->setMargin(0.001f);
+        return result;
+    }
+
+    template <class F>
+    std::vector<btScalar> runQueries(const std::vector<Query>& queries, F&& f)
+    {
+        std::vector<btScalar> result;
+        result.reserve(queries.size());
+        for (const Query& query : queries)
+            result.push_back(f(query));
+        return result;
+    }
+
+    template <class F>
+    void runBenchmark(benchmark::State& state, const std::vector<Query>& queries, F&& f)
+    {
+        Terrain bullet(ShapeType::Bullet);
+        Terrain terrain(static_cast<ShapeType>(state.range(0)));
+
+        // Both shapes have to find the same hits
+        const std::vector<btScalar> expected
+            = runQueries(queries, [&](const Query& query) { return f(bullet, query); });
+        const std::vector<btScalar> actual
+            = runQueries(queries, [&](const Query& query) { return f(terrain, query); });
+        if (expected != actual)
+        {
+            state.SkipWithError("Results are different from btHeightfieldTerrainShape");
+            return;
+        }
+
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(f(terrain, queries[i]));
+            if (++i == queries.size())
+                i = 0;
+        }
+
+        state.counters["hits"] = static_cast<double>(
+            std::count_if(actual.begin(), actual.end(), [](btScalar v) { return v < 1; }));
+    }
+
+    void heightFieldRayTest(benchmark::State& state)
+    {
+        static const std::vector<Query> queries = generateRayQueries();
+        runBenchmark(state, queries, [](Terrain& terrain, const Query& query) { return rayTest(terrain, query); });
+    }
+
+    void heightFieldConvexSweepTest(benchmark::State& state)
+    {
+        static const std::vector<Query> queries = generateActorQueries();
+        const std::unique_ptr<btBoxShape> actorShape = makeActorShape();
+        runBenchmark(state, queries,
+            [&](Terrain& terrain, const Query& query) { return convexSweepTest(terrain, *actorShape, query); });
+    }
+}
+
+BENCHMARK(heightFieldRayTest)
+    ->Arg(static_cast<int>(ShapeType::Bullet))
+    ->Arg(static_cast<int>(ShapeType::HeightFieldShape));
+BENCHMARK(heightFieldConvexSweepTest)
+    ->Arg(static_cast<int>(ShapeType::Bullet))
+    ->Arg(static_cast<int>(ShapeType::HeightFieldShape));
+
+BENCHMARK_MAIN();
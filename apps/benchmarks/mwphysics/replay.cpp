@@ -0,0 +1,202 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/simulationrecording.hpp"
+#include "apps/openmw/mwphysics/simulationreplay.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace MWPhysics;
+
+    // Optional recording made with OPENMW_PHYSICS_RECORDING to replay instead of the generated one
+    constexpr const char* recordingEnvironmentVariable = "OPENMW_BENCHMARK_PHYSICS_RECORDING";
+
+    constexpr unsigned maxThreads = 8;
+
+    SimulationReplay& getReplay()
+    {
+        // Bullet supports limited number of threads over the process lifetime so they are never recreated
+        static SimulationReplay replay(maxThreads);
+        return replay;
+    }
+
+    void addBox(const osg::Vec3f& center, const osg::Vec3f& halfExtents, std::vector<osg::Vec3f>& triangles)
+    {
+        constexpr int indices[] = { 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6, 0, 2, 6,
+            0, 6, 4, 1, 5, 7, 1, 7, 3 };
+        for (const int index : indices)
+        {
+            const float x = (index & 1) ? -halfExtents.x() : halfExtents.x();
+            const float y = (index & 2) ? -halfExtents.y() : halfExtents.y();
+            const float z = (index & 4) ? -halfExtents.z() : halfExtents.z();
+            triangles.push_back(center + osg::Vec3f(x, y, z));
+        }
+    }
+
+    // Crowd of actors walking in random directions over flat ground between the buildings
+    std::vector<RecordedFrame> generateFrames(int actorsCount, int framesCount)
+    {
+        constexpr float size = 8192;
+        constexpr float halfExtentsZ = 66;
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> coordinate(-size / 2, size / 2);
+        std::uniform_real_distribution<float> angle(0, 2 * std::numbers::pi_v<float>);
+
+        RecordedFrame first;
+        first.mSteps = 1;
+        first.mPhysicsDt = 1.0f / 60;
+        first.mResetWorld = true;
+
+        RecordedObject& ground = first.mWorld.emplace_back();
+        ground.mCollisionGroup = CollisionType_HeightMap;
+        ground.mCollisionMask = CollisionType_Actor | CollisionType_Projectile;
+        ground.mTriangles = { osg::Vec3f(-size, -size, 0), osg::Vec3f(size, -size, 0), osg::Vec3f(size, size, 0),
+            osg::Vec3f(-size, -size, 0), osg::Vec3f(size, size, 0), osg::Vec3f(-size, size, 0) };
+
+        RecordedObject& buildings = first.mWorld.emplace_back();
+        buildings.mId = 1;
+        buildings.mCollisionGroup = CollisionType_World;
+        buildings.mCollisionMask = CollisionType_Actor | CollisionType_Projectile;
+        for (int i = 0; i < 64; ++i)
+            addBox(osg::Vec3f(coordinate(random), coordinate(random), 256), osg::Vec3f(256, 256, 256),
+                buildings.mTriangles);
+
+        for (int i = 0; i < actorsCount; ++i)
+        {
+            const osg::Vec3f position(coordinate(random), coordinate(random), 0);
+            first.mActors.push_back(RecordedActor{
+                .mId = static_cast<std::uint32_t>(i),
+                .mShape = RecordedActorShape::Box,
+                .mHalfExtents = osg::Vec3f(29, 28, halfExtentsZ),
+                .mMargin = 0.001f,
+                .mCollisionObjectPosition = position + osg::Vec3f(0, 0, halfExtentsZ),
+                .mCollisionObjectRotation = osg::Quat(),
+                .mCollisionGroup = CollisionType_Actor,
+                .mCollisionMask = CollisionType_Default,
+                .mPosition = position,
+                .mIsOnGround = true,
+                .mSwimLevel = -1000,
+                .mSlowFall = 1,
+                .mRotation = osg::Vec2f(0, angle(random)),
+                .mMovement = osg::Vec3f(0, 150, 0),
+                .mWaterlevel = -1000,
+                .mHalfExtentsZ = halfExtentsZ,
+                .mOldHeight = position.z(),
+                .mWasOnGround = true,
+            });
+        }
+
+        // Each frame starts where the previous one has ended
+        std::vector<RecordedFrame> result;
+        result.push_back(std::move(first));
+        for (int i = 0; i < framesCount; ++i)
+        {
+            RecordedFrame& frame = result.back();
+            frame.mResultPositions = getReplay().replay(frame, 1);
+            if (i + 1 == framesCount)
+                break;
+            RecordedFrame next = frame;
+            next.mResetWorld = false;
+            next.mWorld.clear();
+            next.mResultPositions.clear();
+            for (std::size_t j = 0; j < next.mActors.size(); ++j)
+            {
+                RecordedActor& actor = next.mActors[j];
+                const osg::Vec3f position = frame.mResultPositions[j];
+                actor.mCollisionObjectPosition += position - actor.mPosition;
+                actor.mPosition = position;
+                actor.mOldHeight = position.z();
+            }
+            result.push_back(std::move(next));
+        }
+        return result;
+    }
+
+    std::vector<std::vector<osg::Vec3f>> replay(const std::vector<RecordedFrame>& frames, unsigned threads)
+    {
+        std::vector<std::vector<osg::Vec3f>> result;
+        result.reserve(frames.size());
+        for (const RecordedFrame& frame : frames)
+            result.push_back(getReplay().replay(frame, threads));
+        return result;
+    }
+
+    void runReplay(benchmark::State& state, const std::vector<RecordedFrame>& frames)
+    {
+        const unsigned threads = static_cast<unsigned>(state.range(0));
+        if (threads > getReplay().getMaxThreads())
+        {
+            state.SkipWithError("Bullet does not support this number of threads");
+            return;
+        }
+
+        // Actors are moved independently within a step so results must not depend on the number of threads
+        if (replay(frames, 1) != replay(frames, threads))
+        {
+            state.SkipWithError("Replay results depend on the number of threads");
+            return;
+        }
+
+        std::size_t steps = 0;
+        std::size_t actorSteps = 0;
+        for (const RecordedFrame& frame : frames)
+        {
+            steps += frame.mSteps;
+            actorSteps += frame.mSteps * frame.mActors.size();
+        }
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(replay(frames, threads));
+
+        state.counters["steps"] = benchmark::Counter(
+            static_cast<double>(steps * state.iterations()), benchmark::Counter::kIsRate);
+        state.counters["actor_steps"] = benchmark::Counter(
+            static_cast<double>(actorSteps * state.iterations()), benchmark::Counter::kIsRate);
+    }
+
+    void replayGenerated(benchmark::State& state)
+    {
+        static const std::vector<RecordedFrame> frames = generateFrames(256, 120);
+        runReplay(state, frames);
+    }
+
+    void replayRecording(benchmark::State& state)
+    {
+        const char* const path = std::getenv(recordingEnvironmentVariable);
+        if (path == nullptr)
+        {
+            state.SkipWithError("OPENMW_BENCHMARK_PHYSICS_RECORDING is not set");
+            return;
+        }
+        const std::vector<RecordedFrame> frames = readSimulationRecording(path);
+        if (frames.empty())
+        {
+            state.SkipWithError("Recording has no frames");
+            return;
+        }
+
+        // Replay can't be bit exact with the game because static geometry is recorded as triangle meshes
+        float maxError = 0;
+        for (const RecordedFrame& frame : frames)
+        {
+            const std::vector<osg::Vec3f> positions = getReplay().replay(frame, 1);
+            for (std::size_t i = 0; i < positions.size() && i < frame.mResultPositions.size(); ++i)
+                maxError = std::max(maxError, (positions[i] - frame.mResultPositions[i]).length());
+        }
+
+        runReplay(state, frames);
+
+        state.counters["max_error"] = maxError;
+    }
+}
+
+BENCHMARK(replayGenerated)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(replayRecording)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <components/nifosg/controller.hpp>
+#include <components/nifosg/quantizedkeys.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    using namespace NifOsg;
+
+    constexpr std::size_t tracksCount = 64;
+    constexpr float keysPerSecond = 15;
+    constexpr float frameDuration = 1.0f / 60;
+
+    std::vector<Nif::QuaternionKeyMapPtr> generateTracks(std::size_t keysCount)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<double> angle(-std::numbers::pi, std::numbers::pi);
+        std::vector<Nif::QuaternionKeyMapPtr> result;
+        for (std::size_t i = 0; i < tracksCount; ++i)
+        {
+            auto keys = std::make_shared<Nif::QuaternionKeyMap>();
+            keys->mInterpolationType = Nif::InterpolationType_Linear;
+            keys->mKeys.reserve(keysCount);
+            for (std::size_t j = 0; j < keysCount; ++j)
+                keys->mKeys.emplace_back(static_cast<float>(j) / keysPerSecond,
+                    Nif::KeyT<osg::Quat>{ osg::Quat(angle(random), osg::Vec3f(0, 0, 1), angle(random),
+                        osg::Vec3f(1, 0, 0), angle(random), osg::Vec3f(0, 1, 0)) });
+            result.push_back(std::move(keys));
+        }
+        return result;
+    }
+
+    template <class Interpolator>
+    std::size_t getKeysSize(const Nif::QuaternionKeyMap& keys, const Interpolator& interpolator)
+    {
+        if constexpr (std::is_same_v<Interpolator, QuantizedQuaternionInterpolator>)
+            return interpolator.getKeysSize();
+        else
+            return sizeof(keys) + keys.mKeys.capacity() * sizeof(Nif::QuaternionKeyMap::MapType::value_type);
+    }
+
+    // Samples all tracks of a skeleton frame by frame like a playing animation does
+    template <class Interpolator>
+    void sampleRotations(benchmark::State& state)
+    {
+        const std::size_t keysCount = static_cast<std::size_t>(state.range(0));
+        const std::vector<Nif::QuaternionKeyMapPtr> tracks = generateTracks(keysCount);
+        std::vector<Interpolator> interpolators;
+        std::size_t keysSize = 0;
+        for (const Nif::QuaternionKeyMapPtr& keys : tracks)
+        {
+            interpolators.emplace_back(keys);
+            keysSize += getKeysSize(*keys, interpolators.back());
+        }
+        const float duration = static_cast<float>(keysCount - 1) / keysPerSecond;
+
+        float time = 0;
+        for (auto _ : state)
+        {
+            for (const Interpolator& interpolator : interpolators)
+            {
+                osg::Quat rotation = interpolator.interpKey(time);
+                benchmark::DoNotOptimize(rotation);
+            }
+            time += frameDuration;
+            if (time > duration)
+                time = 0;
+        }
+
+        state.counters["samples"] = benchmark::Counter(
+            static_cast<double>(tracksCount * state.iterations()), benchmark::Counter::kIsRate);
+        state.counters["bytes_per_key"]
+            = benchmark::Counter(static_cast<double>(keysSize) / static_cast<double>(tracksCount * keysCount));
+    }
+}
+
+BENCHMARK_TEMPLATE(sampleRotations, QuaternionInterpolator)->Arg(30)->Arg(300)->Arg(3000);
+BENCHMARK_TEMPLATE(sampleRotations, QuantizedQuaternionInterpolator)->Arg(30)->Arg(300)->Arg(3000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,281 @@
+#include <benchmark/benchmark.h>
+
+#include <components/files/constrainedfilestream.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/riggeometry.hpp>
+#include <components/sceneutil/skinning.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <osg/NodeVisitor>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    // Optional skinned mesh like meshes/b/B_N_Dark Elf_M_Skins.nif to benchmark instead of the generated one
+    constexpr const char* nifEnvironmentVariable = "OPENMW_BENCHMARK_SKINNED_NIF";
+
+    struct Mesh
+    {
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<osg::Vec3f> mNormals;
+        std::vector<osg::Vec4f> mTangents;
+        SkinInfluences mInfluences;
+        std::vector<osg::Matrixf> mBoneMatrices;
+    };
+
+    struct SkinnedVertices
+    {
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<osg::Vec3f> mNormals;
+        std::vector<osg::Vec4f> mTangents;
+    };
+
+    std::vector<osg::Matrixf> generateBoneMatrices(std::size_t count, std::minstd_rand& random)
+    {
+        std::uniform_real_distribution<float> angle(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
+        std::uniform_real_distribution<float> offset(-10, 10);
+        std::vector<osg::Matrixf> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.push_back(osg::Matrixf::rotate(angle(random), osg::Vec3f(0, 0, 1))
+                * osg::Matrixf::rotate(angle(random), osg::Vec3f(1, 0, 0))
+                * osg::Matrixf::translate(offset(random), offset(random), offset(random)));
+        return result;
+    }
+
+    // Cylinder with each vertex influenced by up to 4 neighbouring bones along the axis
+    Mesh generateMesh(std::size_t verticesCount, std::size_t bonesCount)
+    {
+        constexpr std::size_t ringSize = 32;
+        constexpr float height = 128;
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> bonesPerVertex(1, 4);
+
+        Mesh result;
+        std::vector<BoneWeights> influences;
+        for (std::size_t i = 0; i < verticesCount; ++i)
+        {
+            const float angle = 2 * std::numbers::pi_v<float> * static_cast<float>(i % ringSize) / ringSize;
+            const float z = height * static_cast<float>(i / ringSize) / static_cast<float>(verticesCount / ringSize);
+            const osg::Vec3f normal(std::cos(angle), std::sin(angle), 0);
+            result.mPositions.push_back(normal * 16 + osg::Vec3f(0, 0, z));
+            result.mNormals.push_back(normal);
+            result.mTangents.emplace_back(-normal.y(), normal.x(), 0, 1);
+
+            const std::size_t firstBone = std::min(
+                static_cast<std::size_t>(z / height * static_cast<float>(bonesCount)), bonesCount - 1);
+            const std::size_t count = std::min(bonesPerVertex(random), bonesCount - firstBone);
+            BoneWeights& weights = influences.emplace_back();
+            for (std::size_t j = 0; j < count; ++j)
+                weights.emplace_back(firstBone + j, 1.0f / static_cast<float>(count));
+        }
+        result.mInfluences = groupSkinInfluences(influences);
+        result.mBoneMatrices = generateBoneMatrices(bonesCount, random);
+        return result;
+    }
+
+    class CollectRigGeometries : public osg::NodeVisitor
+    {
+    public:
+        std::vector<const RigGeometry*> mResult;
+
+        CollectRigGeometries()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+        {
+        }
+
+        void apply(osg::Drawable& drawable) override
+        {
+            if (const RigGeometry* const rig = dynamic_cast<const RigGeometry*>(&drawable))
+                mResult.push_back(rig);
+        }
+    };
+
+    std::vector<Mesh> loadNif(const char* path)
+    {
+        VFS::Manager vfs;
+        Resource::ImageManager imageManager(&vfs, 0);
+        Resource::BgsmFileManager materialManager(&vfs, 0);
+        Nif::NIFFile file(VFS::Path::Normalized(path));
+        Nif::Reader reader(file, nullptr);
+        reader.parse(Files::openConstrainedFileStream(path));
+        const osg::ref_ptr<osg::Node> node = NifOsg::Loader::load(file, &imageManager, &materialManager);
+
+        CollectRigGeometries visitor;
+        node->accept(visitor);
+
+        std::minstd_rand random;
+        std::vector<Mesh> result;
+        for (const RigGeometry* rig : visitor.mResult)
+        {
+            const osg::ref_ptr<osg::Geometry> source = rig->getSourceGeometry();
+            const auto* const positions = static_cast<const osg::Vec3Array*>(source->getVertexArray());
+            const auto* const normals = static_cast<const osg::Vec3Array*>(source->getNormalArray());
+            const auto* const tangents = dynamic_cast<const osg::Vec4Array*>(source->getTexCoordArray(7));
+
+            Mesh& mesh = result.emplace_back();
+            mesh.mPositions.assign(positions->begin(), positions->end());
+            if (normals != nullptr)
+                mesh.mNormals.assign(normals->begin(), normals->end());
+            if (tangents != nullptr)
+                mesh.mTangents.assign(tangents->begin(), tangents->end());
+            mesh.mInfluences = rig->getInfluences();
+
+            std::size_t bonesCount = 0;
+            for (const auto& [weights, vertices] : mesh.mInfluences)
+                for (const auto& [index, weight] : weights)
+                    bonesCount = std::max(bonesCount, index + 1);
+            mesh.mBoneMatrices = generateBoneMatrices(bonesCount, random);
+        }
+        return result;
+    }
+
+    SkinnedVertices makeSkinnedVertices(const Mesh& mesh)
+    {
+        return SkinnedVertices{
+            .mPositions = mesh.mPositions,
+            .mNormals = mesh.mNormals,
+            .mTangents = mesh.mTangents,
+        };
+    }
+
+    // Implementation used before the kernel was extracted
+    void skinReference(const Mesh& mesh, const osg::Matrixf& transform, SkinnedVertices& result)
+    {
+        for (const auto& [influences, vertices] : mesh.mInfluences)
+        {
+            osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+
+            for (const auto& [index, weight] : influences)
+            {
+                const float* boneMatPtr = mesh.mBoneMatrices[index].ptr();
+                float* resultMatPtr = resultMat.ptr();
+                for (int i = 0; i < 16; ++i, ++resultMatPtr, ++boneMatPtr)
+                    if (i % 4 != 3)
+                        *resultMatPtr += *boneMatPtr * weight;
+            }
+
+            resultMat *= transform;
+
+            for (unsigned short vertex : vertices)
+            {
+                result.mPositions[vertex] = resultMat.preMult(mesh.mPositions[vertex]);
+                if (!mesh.mNormals.empty())
+                    result.mNormals[vertex] = osg::Matrixf::transform3x3(mesh.mNormals[vertex], resultMat);
+                if (!mesh.mTangents.empty())
+                {
+                    const osg::Vec4f& srcTangent = mesh.mTangents[vertex];
+                    const osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(
+                        osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
+                    result.mTangents[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
+                }
+            }
+        }
+    }
+
+    void skin(const Mesh& mesh, const osg::Matrixf& transform, SkinnedVertices& result)
+    {
+        const SkinSource source{
+            .mPositions = mesh.mPositions.data(),
+            .mNormals = mesh.mNormals.empty() ? nullptr : mesh.mNormals.data(),
+            .mTangents = mesh.mTangents.empty() ? nullptr : mesh.mTangents.data(),
+        };
+        const SkinDestination destination{
+            .mPositions = result.mPositions.data(),
+            .mNormals = result.mNormals.empty() ? nullptr : result.mNormals.data(),
+            .mTangents = result.mTangents.empty() ? nullptr : result.mTangents.data(),
+        };
+        skinVertices(mesh.mInfluences, mesh.mBoneMatrices, transform, source, destination);
+    }
+
+    bool isClose(const SkinnedVertices& lhs, const SkinnedVertices& rhs)
+    {
+        constexpr float maxError = 1e-3f;
+        for (std::size_t i = 0; i < lhs.mPositions.size(); ++i)
+            if ((lhs.mPositions[i] - rhs.mPositions[i]).length() > maxError)
+                return false;
+        for (std::size_t i = 0; i < lhs.mNormals.size(); ++i)
+            if ((lhs.mNormals[i] - rhs.mNormals[i]).length() > maxError)
+                return false;
+        for (std::size_t i = 0; i < lhs.mTangents.size(); ++i)
+            if ((lhs.mTangents[i] - rhs.mTangents[i]).length() > maxError)
+                return false;
+        return true;
+    }
+
+    template <auto skinFunction>
+    void runSkinning(benchmark::State& state, const std::vector<Mesh>& meshes)
+    {
+        const osg::Matrixf transform = osg::Matrixf::scale(1.1f, 1.1f, 1.1f) * osg::Matrixf::translate(1, 2, 3);
+
+        std::vector<SkinnedVertices> results;
+        std::size_t vertices = 0;
+        for (const Mesh& mesh : meshes)
+        {
+            SkinnedVertices& expected = results.emplace_back(makeSkinnedVertices(mesh));
+            SkinnedVertices actual = expected;
+            skinReference(mesh, transform, expected);
+            skinFunction(mesh, transform, actual);
+            if (!isClose(expected, actual))
+            {
+                state.SkipWithError("Skinning result differs from the reference implementation");
+                return;
+            }
+            vertices += mesh.mPositions.size();
+        }
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < meshes.size(); ++i)
+                skinFunction(meshes[i], transform, results[i]);
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["vertices"] = benchmark::Counter(
+            static_cast<double>(vertices * state.iterations()), benchmark::Counter::kIsRate);
+    }
+
+    template <auto skinFunction>
+    void skinGenerated(benchmark::State& state)
+    {
+        const std::vector<Mesh> meshes{ generateMesh(static_cast<std::size_t>(state.range(0)), 24) };
+        runSkinning<skinFunction>(state, meshes);
+    }
+
+    template <auto skinFunction>
+    void skinNif(benchmark::State& state)
+    {
+        const char* const path = std::getenv(nifEnvironmentVariable);
+        if (path == nullptr)
+        {
+            state.SkipWithError("OPENMW_BENCHMARK_SKINNED_NIF is not set");
+            return;
+        }
+        const std::vector<Mesh> meshes = loadNif(path);
+        if (meshes.empty())
+        {
+            state.SkipWithError("NIF file has no skinned meshes");
+            return;
+        }
+        runSkinning<skinFunction>(state, meshes);
+    }
+}
+
+BENCHMARK_TEMPLATE(skinGenerated, skinReference)->Arg(1024)->Arg(4096)->Arg(16384);
+BENCHMARK_TEMPLATE(skinGenerated, skin)->Arg(1024)->Arg(4096)->Arg(16384);
+BENCHMARK_TEMPLATE(skinNif, skinReference);
+BENCHMARK_TEMPLATE(skinNif, skin);
+
+BENCHMARK_MAIN();
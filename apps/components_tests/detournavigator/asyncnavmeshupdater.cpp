@@ -513,6 +513,38 @@ namespace
         EXPECT_EQ(queue.size(), 0);
     }
 
+    TEST_F(DetourNavigatorSpatialJobQueueTest, pop_should_return_job_for_priority_tile_first)
+    {
+        std::list<Job> jobs;
+        SpatialJobQueue queue;
+
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(0, 0),
+            ChangeType::update, mProcessTime));
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(2, 0),
+            ChangeType::update, mProcessTime));
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(3, 0),
+            ChangeType::update, mProcessTime));
+
+        const PriorityTiles priorityTiles{
+            { TilePosition(2, 0), mProcessTime },
+            { TilePosition(3, 0), mProcessTime },
+        };
+
+        const auto job1 = queue.pop(mPlayerTile, priorityTiles);
+        ASSERT_TRUE(job1.has_value());
+        EXPECT_EQ((*job1)->mChangedTile, TilePosition(2, 0));
+
+        const auto job2 = queue.pop(mPlayerTile, priorityTiles);
+        ASSERT_TRUE(job2.has_value());
+        EXPECT_EQ((*job2)->mChangedTile, TilePosition(3, 0));
+
+        const auto job3 = queue.pop(mPlayerTile, priorityTiles);
+        ASSERT_TRUE(job3.has_value());
+        EXPECT_EQ((*job3)->mChangedTile, TilePosition(0, 0));
+
+        EXPECT_EQ(queue.size(), 0);
+    }
+
     struct DetourNavigatorJobQueueTest : DetourNavigatorSpatialJobQueueTest
     {
     };
@@ -675,6 +707,62 @@ namespace
         EXPECT_EQ(queue.getStats().mRemoving, 1);
     }
 
+    TEST_F(DetourNavigatorJobQueueTest, pop_should_return_prioritized_tile_before_nearest_to_player_tile)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        std::list<Job> jobs;
+
+        JobQueue queue;
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(0, 0),
+            ChangeType::update, mProcessTime));
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(1, 0),
+            ChangeType::update, mProcessTime));
+        queue.prioritize(TilePosition(1, 0), now + std::chrono::seconds(1));
+
+        EXPECT_EQ(queue.getStats().mPriorityTiles, 1);
+
+        const auto job = queue.pop(mPlayerTile, now);
+        ASSERT_TRUE(job.has_value());
+        EXPECT_EQ((*job)->mChangedTile, TilePosition(1, 0));
+    }
+
+    TEST_F(DetourNavigatorJobQueueTest, pop_should_ignore_expired_prioritized_tile)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        std::list<Job> jobs;
+
+        JobQueue queue;
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(0, 0),
+            ChangeType::update, mProcessTime));
+        queue.push(jobs.emplace(jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, TilePosition(1, 0),
+            ChangeType::update, mProcessTime));
+        queue.prioritize(TilePosition(1, 0), now);
+
+        const auto job = queue.pop(mPlayerTile, now);
+        ASSERT_TRUE(job.has_value());
+        EXPECT_EQ((*job)->mChangedTile, TilePosition(0, 0));
+        EXPECT_EQ(queue.getStats().mPriorityTiles, 0);
+    }
+
+    TEST_F(DetourNavigatorJobQueueTest, update_should_cancel_jobs_and_priority_for_out_of_range_tiles)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        std::list<Job> jobs;
+
+        JobQueue queue;
+        queue.push(jobs.emplace(
+            jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, mChangedTile, ChangeType::update, mProcessTime));
+        queue.prioritize(mChangedTile, now + std::chrono::seconds(1));
+
+        queue.update(TilePosition(10, 10), mMaxTiles, now);
+
+        EXPECT_EQ(queue.getStats().mCancelled, 1);
+        EXPECT_EQ(queue.getStats().mPriorityTiles, 0);
+    }
+
     TEST_F(DetourNavigatorJobQueueTest, clear_should_remove_all)
     {
         const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
@@ -807,6 +807,27 @@ namespace
             << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_coarse_path_should_follow_navmesh_changes)
+    {
+        const HeightfieldPlane plane{ 100 };
+        const int cellSize = heightfieldTileSize * 8;
+        const osg::Vec3f start(100, 100, 100);
+        const osg::Vec3f end(1000, 1000, 100);
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane, nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+
+        EXPECT_THAT(findCoarsePath(*mNavigator, mAgentBounds, start, end, Flag_walk), Not(IsEmpty()));
+
+        mNavigator->removeHeightfield(mCellPosition, nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+
+        EXPECT_THAT(findCoarsePath(*mNavigator, mAgentBounds, start, end, Flag_walk), IsEmpty());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, for_not_reachable_destination_find_path_should_provide_partial_path)
     {
         const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
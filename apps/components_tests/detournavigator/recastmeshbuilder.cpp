@@ -321,6 +321,32 @@ namespace
         EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), std::vector<AreaType>({ AreaType_ground }));
     }
 
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, with_bounds_add_transformed_geometry_should_filter_by_bounds)
+    {
+        mBounds.mMin = osg::Vec2f(-3, -3);
+        mBounds.mMax = osg::Vec2f(-2, -2);
+        btTriangleMesh mesh;
+        mesh.addTriangle(btVector3(-1, -1, 0), btVector3(-1, 1, 0), btVector3(1, -1, 0));
+        mesh.addTriangle(btVector3(-3, -3, 0), btVector3(-3, -2, 0), btVector3(-2, -3, 0));
+        btBvhTriangleMeshShape shape(&mesh, true);
+        const std::optional<TransformedGeometry> geometry
+            = makeTransformedGeometry(shape, btTransform::getIdentity(), AreaType_ground);
+        ASSERT_TRUE(geometry.has_value());
+        EXPECT_EQ(geometry->mTriangles.size(), 2);
+        RecastMeshBuilder builder(mBounds);
+        builder.addGeometry(*geometry);
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_EQ(recastMesh->getMesh().getVertices(),
+            std::vector<float>({
+                -3, -3, 0, // vertex 0
+                -3, -2, 0, // vertex 1
+                -2, -3, 0, // vertex 2
+            }))
+            << recastMesh->getMesh().getVertices();
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), std::vector<int>({ 2, 1, 0 }));
+        EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), std::vector<AreaType>({ AreaType_ground }));
+    }
+
     TEST_F(
         DetourNavigatorRecastMeshBuilderTest, with_bounds_add_rotated_by_x_bhv_triangle_shape_should_filter_by_bounds)
     {
@@ -561,4 +587,61 @@ namespace
         expected.mMinY = 1;
         EXPECT_EQ(recastMesh->getHeightfields(), std::vector<Heightfield>({ expected }));
     }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, add_dynamic_object_should_add_layers)
+    {
+        btTriangleMesh staticMesh;
+        staticMesh.addTriangle(btVector3(-1, -1, 0), btVector3(-1, 1, 0), btVector3(1, -1, 0));
+        btBvhTriangleMeshShape staticShape(&staticMesh, true);
+        btTriangleMesh dynamicMesh;
+        dynamicMesh.addTriangle(btVector3(-3, -3, 0), btVector3(-3, -2, 0), btVector3(-2, -3, 0));
+        btBvhTriangleMeshShape dynamicShape(&dynamicMesh, true);
+        RecastMeshBuilder builder(mBounds);
+        builder.addObject(static_cast<const btCollisionShape&>(staticShape), btTransform::getIdentity(),
+            AreaType_ground, mSource, mObjectTransform);
+        builder.setDynamic(true);
+        builder.addObject(static_cast<const btCollisionShape&>(dynamicShape), btTransform::getIdentity(),
+            AreaType_ground, mSource, mObjectTransform);
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_EQ(recastMesh->getMesh().getVertices(),
+            std::vector<float>({
+                -3, -3, 0, // vertex 0
+                -3, -2, 0, // vertex 1
+                -2, -3, 0, // vertex 2
+                -1, -1, 0, // vertex 3
+                -1, 1, 0, // vertex 4
+                1, -1, 0, // vertex 5
+            }))
+            << recastMesh->getMesh().getVertices();
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), std::vector<int>({ 2, 1, 0, 5, 4, 3 }));
+        ASSERT_TRUE(recastMesh->getLayers().has_value());
+        const RecastMeshLayers& layers = *recastMesh->getLayers();
+        ASSERT_NE(layers.mStatic, nullptr);
+        EXPECT_EQ(layers.mStatic->getVertices(),
+            std::vector<float>({
+                -1, -1, 0, // vertex 0
+                -1, 1, 0, // vertex 1
+                1, -1, 0, // vertex 2
+            }))
+            << layers.mStatic->getVertices();
+        EXPECT_EQ(layers.mDynamic.getVertices(),
+            std::vector<float>({
+                -3, -3, 0, // vertex 0
+                -3, -2, 0, // vertex 1
+                -2, -3, 0, // vertex 2
+            }))
+            << layers.mDynamic.getVertices();
+    }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, without_dynamic_objects_should_not_add_layers)
+    {
+        btTriangleMesh mesh;
+        mesh.addTriangle(btVector3(-1, -1, 0), btVector3(-1, 1, 0), btVector3(1, -1, 0));
+        btBvhTriangleMeshShape shape(&mesh, true);
+        RecastMeshBuilder builder(mBounds);
+        builder.addObject(static_cast<const btCollisionShape&>(shape), btTransform::getIdentity(), AreaType_ground,
+            mSource, mObjectTransform);
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_FALSE(recastMesh->getLayers().has_value());
+    }
 }
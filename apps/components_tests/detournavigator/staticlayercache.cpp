@@ -0,0 +1,114 @@
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/staticlayercache.hpp>
+#include <components/detournavigator/stats.hpp>
+
+#include <Recast.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    std::vector<std::tuple<int, int, unsigned, unsigned, unsigned>> getSpans(const rcHeightfield& solid)
+    {
+        std::vector<std::tuple<int, int, unsigned, unsigned, unsigned>> result;
+        for (int y = 0; y < solid.height; ++y)
+            for (int x = 0; x < solid.width; ++x)
+                for (const rcSpan* span = solid.spans[x + y * solid.width]; span != nullptr; span = span->next)
+                    result.emplace_back(x, y, span->smin, span->smax, span->area);
+        return result;
+    }
+
+    struct DetourNavigatorStaticLayerCacheTest : Test
+    {
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(1, 2, 3) };
+        const TilePosition mTilePosition{ 0, 0 };
+        const Version mVersion{ 0, 0 };
+        const float mMinZ = -10;
+        const float mMaxZ = 10;
+        rcContext mContext{ false };
+        const std::shared_ptr<const Mesh> mStatic = std::make_shared<const Mesh>(std::vector<int>{ 0, 1, 2 },
+            std::vector<float>{ 0, 0, 0, 1, 0, 0, 0, 1, 0 }, std::vector<AreaType>{ AreaType_ground });
+        const RecastMesh mRecastMesh{ mVersion, Mesh({}, {}, {}), {}, {}, {}, {},
+            RecastMeshLayers{ .mStatic = mStatic, .mDynamic = Mesh({}, {}, {}) } };
+        rcHeightfield mSolid;
+
+        DetourNavigatorStaticLayerCacheTest()
+        {
+            initEmpty(mSolid);
+            if (!rcAddSpan(&mContext, mSolid, 1, 2, 3, 4, 5, 1) || !rcAddSpan(&mContext, mSolid, 1, 2, 7, 9, 1, 1)
+                || !rcAddSpan(&mContext, mSolid, 3, 0, 1, 2, 3, 1))
+                throw std::runtime_error("Failed to add span");
+        }
+
+        void initEmpty(rcHeightfield& solid)
+        {
+            const float bmin[] = { 0, 0, 0 };
+            const float bmax[] = { 4, 4, 4 };
+            if (!rcCreateHeightfield(&mContext, solid, 4, 4, bmin, bmax, 1, 1))
+                throw std::runtime_error("Failed to create heightfield");
+        }
+    };
+
+    TEST_F(DetourNavigatorStaticLayerCacheTest, restore_for_empty_cache_should_return_false)
+    {
+        StaticLayerCache cache(1);
+        rcHeightfield solid;
+        initEmpty(solid);
+        EXPECT_FALSE(cache.restore(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ, mContext, solid));
+        EXPECT_EQ(cache.getStats().mGetCount, 1);
+        EXPECT_EQ(cache.getStats().mHitCount, 0);
+    }
+
+    TEST_F(DetourNavigatorStaticLayerCacheTest, restore_should_add_stored_spans)
+    {
+        StaticLayerCache cache(1);
+        cache.store(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ, mSolid);
+        rcHeightfield solid;
+        initEmpty(solid);
+        ASSERT_TRUE(cache.restore(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ, mContext, solid));
+        EXPECT_EQ(getSpans(solid), getSpans(mSolid));
+        EXPECT_EQ(cache.getStats().mHitCount, 1);
+    }
+
+    TEST_F(DetourNavigatorStaticLayerCacheTest, restore_for_different_z_bounds_should_return_false)
+    {
+        StaticLayerCache cache(1);
+        cache.store(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ, mSolid);
+        rcHeightfield solid;
+        initEmpty(solid);
+        EXPECT_FALSE(cache.restore(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ + 1, mContext, solid));
+    }
+
+    TEST_F(DetourNavigatorStaticLayerCacheTest, restore_for_different_static_layer_should_return_false)
+    {
+        StaticLayerCache cache(1);
+        cache.store(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ, mSolid);
+        const RecastMesh recastMesh(mVersion, Mesh({}, {}, {}), {}, {}, {}, {},
+            RecastMeshLayers{
+                .mStatic = std::make_shared<const Mesh>(Mesh({}, {}, {})),
+                .mDynamic = Mesh({}, {}, {}),
+            });
+        rcHeightfield solid;
+        initEmpty(solid);
+        EXPECT_FALSE(cache.restore(mAgentBounds, mTilePosition, recastMesh, mMinZ, mMaxZ, mContext, solid));
+    }
+
+    TEST_F(DetourNavigatorStaticLayerCacheTest, store_should_remove_least_recently_used_items_above_limit)
+    {
+        StaticLayerCache cache(1);
+        cache.store(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ, mSolid);
+        cache.store(mAgentBounds, TilePosition(1, 1), mRecastMesh, mMinZ, mMaxZ, mSolid);
+        EXPECT_EQ(cache.getStats().mItems, 1);
+        rcHeightfield solid;
+        initEmpty(solid);
+        EXPECT_FALSE(cache.restore(mAgentBounds, mTilePosition, mRecastMesh, mMinZ, mMaxZ, mContext, solid));
+    }
+}
@@ -1,6 +1,8 @@
 
 #include <components/detournavigator/debug.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
 #include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/stats.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
 
 #include <BulletCollision/CollisionShapes/btBoxShape.h>
@@ -577,4 +579,102 @@ namespace
             for (int y = -1; y < 1; ++y)
                 EXPECT_NE(manager.getMesh(mWorldspace, TilePosition(x, y)), nullptr) << x << " " << y;
     }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, add_object_covering_multiple_tiles_should_share_geometry)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(
+            ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        EXPECT_EQ(manager.getStats().mGeometry.mItems, 1);
+        ASSERT_NE(manager.getMesh(mWorldspace, TilePosition(-1, -1)), nullptr);
+        EXPECT_GT(manager.getStats().mGeometry.mMemory, 0);
+        EXPECT_GT(manager.getStats().mMemory, manager.getStats().mGeometry.mMemory);
+        for (int x = -1; x < 1; ++x)
+            for (int y = -1; y < 1; ++y)
+                if (x != -1 || y != -1)
+                    ASSERT_NE(manager.getMesh(mWorldspace, TilePosition(x, y)), nullptr);
+        const TileCachedRecastMeshManagerStats stats = manager.getStats();
+        EXPECT_EQ(stats.mGeometry.mGetCount, 4);
+        EXPECT_EQ(stats.mGeometry.mHitCount, 3);
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, shared_geometry_should_be_dropped_when_all_tiles_got_it)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(
+            ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        for (int x = -1; x < 1; ++x)
+            for (int y = -1; y < 1; ++y)
+                ASSERT_NE(manager.getMesh(mWorldspace, TilePosition(x, y)), nullptr);
+        EXPECT_EQ(manager.getStats().mGeometry.mItems, 1);
+        EXPECT_EQ(manager.getStats().mGeometry.mMemory, 0);
+        manager.takeChangedTiles(nullptr);
+        ASSERT_NE(manager.getMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        EXPECT_EQ(manager.getStats().mGeometry.mMemory, 0);
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, objects_with_same_shape_and_transform_should_share_geometry)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        ASSERT_TRUE(
+            manager.addObject(ObjectId(1), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        ASSERT_TRUE(
+            manager.addObject(ObjectId(2), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        EXPECT_EQ(manager.getStats().mGeometry.mItems, 1);
+        manager.removeObject(ObjectId(1), nullptr);
+        EXPECT_EQ(manager.getStats().mGeometry.mItems, 1);
+        manager.removeObject(ObjectId(2), nullptr);
+        EXPECT_EQ(manager.getStats().mGeometry.mItems, 0);
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_mesh_for_shared_geometry_should_match_not_shared)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        const btTransform transform(btQuaternion(btVector3(0, 0, 1), 0.5), btVector3(10, 20, 0));
+        ASSERT_TRUE(manager.addObject(ObjectId(&boxShape), shape, transform, AreaType::AreaType_ground, nullptr));
+        const std::shared_ptr<RecastMesh> recastMesh = manager.getMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(recastMesh, nullptr);
+        RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings, TilePosition(0, 0)));
+        builder.addObject(static_cast<const btCollisionShape&>(boxShape), transform, AreaType::AreaType_ground,
+            mInstance->getSource(), mObjectTransform);
+        const std::shared_ptr<RecastMesh> expected = std::move(builder).create(recastMesh->getVersion());
+        EXPECT_EQ(recastMesh->getMesh().getVertices(), expected->getMesh().getVertices());
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), expected->getMesh().getIndices());
+        EXPECT_EQ(recastMesh->getMesh().getAreaTypes(), expected->getMesh().getAreaTypes());
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_mesh_for_moved_object_should_return_mesh_with_layers)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(
+            ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        {
+            const std::shared_ptr<RecastMesh> recastMesh = manager.getMesh(mWorldspace, TilePosition(0, 0));
+            ASSERT_NE(recastMesh, nullptr);
+            EXPECT_FALSE(recastMesh->getLayers().has_value());
+        }
+        const btTransform transform(btMatrix3x3::getIdentity(), btVector3(1, 2, 3));
+        ASSERT_TRUE(manager.updateObject(ObjectId(&boxShape), transform, AreaType::AreaType_ground, nullptr));
+        manager.takeChangedTiles(nullptr);
+        const std::shared_ptr<RecastMesh> recastMesh = manager.getMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(recastMesh, nullptr);
+        ASSERT_TRUE(recastMesh->getLayers().has_value());
+        EXPECT_EQ(recastMesh->getLayers()->mStatic->getTrianglesCount(), 0);
+        EXPECT_EQ(recastMesh->getLayers()->mDynamic.getTrianglesCount(), recastMesh->getMesh().getTrianglesCount());
+    }
 }
@@ -0,0 +1,63 @@
+#include <components/detournavigator/tilegraph.hpp>
+
+#include <osg/io_utils>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    void addBidirectionalPortal(TileGraph& graph, const TilePosition& a, const TilePosition& b, Flags flags)
+    {
+        const osg::Vec3f position((a.x() + b.x()) * 0.5f, 0, (a.y() + b.y()) * 0.5f);
+        graph.addPortal(a, b, position, flags, flags);
+        graph.addPortal(b, a, position, flags, flags);
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_path_for_empty_graph_should_return_empty)
+    {
+        const TileGraph graph;
+        EXPECT_EQ(graph.findPath(TilePosition(0, 0), TilePosition(2, 0), Flag_walk), std::vector<osg::Vec3f>());
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_path_should_return_portals_between_tiles)
+    {
+        TileGraph graph;
+        addBidirectionalPortal(graph, TilePosition(0, 0), TilePosition(1, 0), Flag_walk);
+        addBidirectionalPortal(graph, TilePosition(1, 0), TilePosition(2, 0), Flag_walk);
+        EXPECT_EQ(graph.findPath(TilePosition(0, 0), TilePosition(2, 0), Flag_walk),
+            (std::vector<osg::Vec3f>{ osg::Vec3f(0.5f, 0, 0), osg::Vec3f(1.5f, 0, 0) }));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_path_should_go_around_missing_connections)
+    {
+        TileGraph graph;
+        addBidirectionalPortal(graph, TilePosition(0, 0), TilePosition(0, 1), Flag_walk);
+        addBidirectionalPortal(graph, TilePosition(0, 1), TilePosition(1, 1), Flag_walk);
+        addBidirectionalPortal(graph, TilePosition(1, 1), TilePosition(1, 0), Flag_walk);
+        EXPECT_EQ(graph.findPath(TilePosition(0, 0), TilePosition(1, 0), Flag_walk),
+            (std::vector<osg::Vec3f>{ osg::Vec3f(0, 0, 0.5f), osg::Vec3f(0.5f, 0, 1), osg::Vec3f(1, 0, 0.5f) }));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_path_should_ignore_portals_with_not_included_flags)
+    {
+        TileGraph graph;
+        addBidirectionalPortal(graph, TilePosition(0, 0), TilePosition(1, 0), Flag_walk);
+        addBidirectionalPortal(graph, TilePosition(1, 0), TilePosition(2, 0), Flag_swim);
+        EXPECT_EQ(graph.findPath(TilePosition(0, 0), TilePosition(2, 0), Flag_walk),
+            std::vector<osg::Vec3f>{ osg::Vec3f(0.5f, 0, 0) });
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_path_to_unreachable_tile_should_lead_to_nearest_reachable)
+    {
+        TileGraph graph;
+        addBidirectionalPortal(graph, TilePosition(0, 0), TilePosition(1, 0), Flag_walk);
+        addBidirectionalPortal(graph, TilePosition(0, 0), TilePosition(-1, 0), Flag_walk);
+        EXPECT_EQ(graph.findPath(TilePosition(0, 0), TilePosition(5, 0), Flag_walk),
+            std::vector<osg::Vec3f>{ osg::Vec3f(0.5f, 0, 0) });
+    }
+}
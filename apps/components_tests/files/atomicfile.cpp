@@ -0,0 +1,51 @@
+#include <components/files/atomicfile.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+
+    std::string readFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    bool writeText(const std::filesystem::path& path, const std::string& text)
+    {
+        return Files::writeFileAtomically(path, [&](std::ostream& stream) { return static_cast<bool>(stream << text); });
+    }
+
+    TEST(FilesWriteFileAtomicallyTest, shouldReplaceFileContent)
+    {
+        const std::filesystem::path path = outputFilePath("atomicfile_replace");
+        ASSERT_TRUE(writeText(path, "first"));
+        ASSERT_TRUE(writeText(path, "second"));
+        EXPECT_EQ(readFile(path), "second");
+    }
+
+    TEST(FilesWriteFileAtomicallyTest, shouldKeepPreviousFileWhenWriteFails)
+    {
+        const std::filesystem::path path = outputFilePath("atomicfile_fail");
+        ASSERT_TRUE(writeText(path, "first"));
+        EXPECT_FALSE(Files::writeFileAtomically(path, [](std::ostream& stream) {
+            stream << "partial";
+            return false;
+        }));
+        EXPECT_EQ(readFile(path), "first");
+        std::size_t files = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(path.parent_path()))
+            if (entry.path().filename().string().starts_with("atomicfile_fail"))
+                ++files;
+        EXPECT_EQ(files, 1u);
+    }
+}
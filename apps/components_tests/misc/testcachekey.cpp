@@ -0,0 +1,39 @@
+#include <components/misc/cachekey.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+
+    TEST(MiscAppendToKeyTest, shouldAppendIntegersInLittleEndianByteOrder)
+    {
+        std::string key;
+        Misc::appendToKey(key, std::uint16_t{ 0x0102 });
+        Misc::appendToKey(key, -1);
+        EXPECT_EQ(key, std::string("\x02\x01\xff\xff\xff\xff", 6));
+    }
+
+    TEST(MiscAppendToKeyTest, shouldGiveSameKeyForPositiveAndNegativeZero)
+    {
+        std::string positive;
+        Misc::appendToKey(positive, 0.0f);
+        std::string negative;
+        Misc::appendToKey(negative, -0.0f);
+        EXPECT_EQ(positive, negative);
+    }
+
+    TEST(MiscAppendStringToKeyTest, shouldSeparateAdjacentStrings)
+    {
+        std::string first;
+        Misc::appendStringToKey(first, "ab");
+        Misc::appendStringToKey(first, "c");
+        std::string second;
+        Misc::appendStringToKey(second, "a");
+        Misc::appendStringToKey(second, "bc");
+        EXPECT_NE(first, second);
+    }
+}
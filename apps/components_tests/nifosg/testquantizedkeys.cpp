@@ -0,0 +1,54 @@
+#include <components/nifosg/controller.hpp>
+#include <components/nifosg/quantizedkeys.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/io_utils>
+
+#include <cmath>
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    Nif::QuaternionKeyMapPtr makeKeys(Nif::InterpolationType type)
+    {
+        auto keys = std::make_shared<Nif::QuaternionKeyMap>();
+        keys->mInterpolationType = type;
+        const osg::Vec3f axis = osg::Vec3f(1, 2, 3) / osg::Vec3f(1, 2, 3).length();
+        for (int i = 0; i < 8; ++i)
+            keys->mKeys.emplace_back(static_cast<float>(i) * 0.5f, Nif::KeyT<osg::Quat>{ osg::Quat(i * 0.7, axis) });
+        return keys;
+    }
+
+    void expectNear(const osg::Quat& actual, const osg::Quat& expected)
+    {
+        // Both represent the same rotation when their dot product is close to 1 or -1
+        const double dot = actual.x() * expected.x() + actual.y() * expected.y() + actual.z() * expected.z()
+            + actual.w() * expected.w();
+        EXPECT_NEAR(std::abs(dot), 1.0, 1e-6) << actual << " " << expected;
+    }
+
+    TEST(NifOsgQuantizedQuaternionInterpolatorTest, emptyShouldReturnDefaultValue)
+    {
+        const osg::Quat defaultValue(0.5, osg::Vec3f(0, 0, 1));
+        const QuantizedQuaternionInterpolator interpolator(nullptr, defaultValue);
+        EXPECT_TRUE(interpolator.empty());
+        EXPECT_EQ(interpolator.interpKey(1), defaultValue);
+    }
+
+    TEST(NifOsgQuantizedQuaternionInterpolatorTest, shouldMatchQuaternionInterpolator)
+    {
+        for (const Nif::InterpolationType type : { Nif::InterpolationType_Linear, Nif::InterpolationType_Constant })
+        {
+            const Nif::QuaternionKeyMapPtr keys = makeKeys(type);
+            const QuaternionInterpolator expected(keys);
+            const QuantizedQuaternionInterpolator actual(keys);
+            // Forward, backward and jumping sampling use different key lookup
+            for (const float time : { -1.0f, 0.0f, 0.1f, 0.2f, 0.5f, 0.75f, 1.9f, 1.2f, 0.3f, 3.5f, 10.0f })
+                expectNear(actual.interpKey(time), expected.interpKey(time));
+        }
+    }
+}
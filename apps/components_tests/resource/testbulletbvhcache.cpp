@@ -0,0 +1,78 @@
+#include <components/resource/bulletbvhcache.hpp>
+#include <components/resource/bulletshape.hpp>
+#include <components/testing/util.hpp>
+
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <tuple>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        std::unique_ptr<TriangleMeshShape> makeShape(bool buildBvh)
+        {
+            auto mesh = std::make_unique<btTriangleMesh>();
+            for (int x = 0; x < 16; ++x)
+                for (int y = 0; y < 16; ++y)
+                {
+                    const btScalar z = static_cast<btScalar>((x * 7 + y * 3) % 5);
+                    mesh->addTriangle(btVector3(x, y, z), btVector3(x + 1, y, z), btVector3(x + 1, y + 1, z));
+                    mesh->addTriangle(btVector3(x, y, z), btVector3(x + 1, y + 1, z), btVector3(x, y + 1, z));
+                }
+            auto shape = std::make_unique<TriangleMeshShape>(mesh.get(), true, buildBvh);
+            std::ignore = mesh.release();
+            return shape;
+        }
+
+        btScalar rayTest(TriangleMeshShape& shape, const btVector3& from, const btVector3& to)
+        {
+            btCollisionObject object;
+            object.setCollisionShape(&shape);
+            btCollisionWorld::ClosestRayResultCallback callback(from, to);
+            btCollisionWorld::rayTestSingle(btTransform(btMatrix3x3::getIdentity(), from),
+                btTransform(btMatrix3x3::getIdentity(), to), &object, &shape, object.getWorldTransform(), callback);
+            return callback.m_closestHitFraction;
+        }
+
+        TEST(ResourceBulletBvhCacheTest, loadShouldReturnFalseForAbsentFile)
+        {
+            const BulletBvhCache cache(TestingOpenMW::currentTestDirPath());
+            const std::unique_ptr<TriangleMeshShape> shape = makeShape(false);
+            EXPECT_FALSE(cache.load("key", *shape));
+            EXPECT_EQ(shape->getOptimizedBvh(), nullptr);
+        }
+
+        TEST(ResourceBulletBvhCacheTest, loadShouldReturnStoredBvh)
+        {
+            const BulletBvhCache cache(TestingOpenMW::currentTestDirPath());
+            const std::unique_ptr<TriangleMeshShape> built = makeShape(true);
+            cache.store("key", *built);
+            const std::unique_ptr<TriangleMeshShape> loaded = makeShape(false);
+            ASSERT_TRUE(cache.load("key", *loaded));
+            ASSERT_NE(loaded->getOptimizedBvh(), nullptr);
+            EXPECT_FALSE(loaded->getOwnsBvh());
+            for (int i = 0; i < 16; ++i)
+            {
+                const btVector3 from(i + 0.5f, 15.5f - i, 10);
+                const btVector3 to(i + 0.5f, 15.5f - i, -10);
+                EXPECT_EQ(rayTest(*loaded, from, to), rayTest(*built, from, to)) << i;
+            }
+        }
+
+        TEST(ResourceBulletBvhCacheTest, loadShouldReturnFalseForDifferentKey)
+        {
+            const BulletBvhCache cache(TestingOpenMW::currentTestDirPath());
+            cache.store("key", *makeShape(true));
+            const std::unique_ptr<TriangleMeshShape> shape = makeShape(false);
+            EXPECT_FALSE(cache.load("other", *shape));
+        }
+    }
+}
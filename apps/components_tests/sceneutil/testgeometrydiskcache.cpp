@@ -0,0 +1,176 @@
+#include <components/sceneutil/geometrydiskcache.hpp>
+#include <components/testing/util.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/StateSet>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        template <class T>
+        osg::ref_ptr<T> makeArray(std::initializer_list<typename T::ElementDataType> values)
+        {
+            osg::ref_ptr<T> result = new T;
+            for (const auto& value : values)
+                result->push_back(value);
+            return result;
+        }
+
+        template <class T>
+        osg::ref_ptr<T> makeDrawElements(GLenum mode, std::initializer_list<typename T::value_type> indices)
+        {
+            osg::ref_ptr<T> result = new T(mode);
+            for (const auto index : indices)
+                result->push_back(index);
+            return result;
+        }
+
+        template <class T>
+        std::vector<typename T::ElementDataType> getElements(const osg::Array* array)
+        {
+            const T* const typed = dynamic_cast<const T*>(array);
+            if (typed == nullptr)
+                return {};
+            return std::vector<typename T::ElementDataType>(typed->begin(), typed->end());
+        }
+
+        osg::ref_ptr<osg::Geometry> makeGeometry(osg::StateSet* stateSet)
+        {
+            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+            geometry->setVertexArray(makeArray<osg::Vec3Array>(
+                { osg::Vec3f(0, 0, 0), osg::Vec3f(1, 0, 0), osg::Vec3f(1, 1, 2), osg::Vec3f(0, 1, 2) }));
+            geometry->setStateSet(stateSet);
+            geometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLE_FAN, 0, 4));
+            return geometry;
+        }
+
+        struct SceneUtilGeometryDiskCacheTest : Test
+        {
+            std::array<osg::ref_ptr<osg::StateSet>, 3> mStateSetRefs{ new osg::StateSet, new osg::StateSet,
+                new osg::StateSet };
+            std::array<osg::StateSet*, 3> mStateSets{ mStateSetRefs[0].get(), mStateSetRefs[1].get(),
+                mStateSetRefs[2].get() };
+            const GeometryDiskCache mCache{ TestingOpenMW::currentTestDirPath() };
+        };
+
+        TEST_F(SceneUtilGeometryDiskCacheTest, loadShouldRestoreAllArraysAndPrimitiveSets)
+        {
+            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+            geometry->setVertexArray(makeArray<osg::Vec3Array>(
+                { osg::Vec3f(0, 0, 0), osg::Vec3f(1, 0, 0), osg::Vec3f(1, 1, 2), osg::Vec3f(0, 1, 2) }));
+            geometry->setNormalArray(makeArray<osg::Vec3Array>({ osg::Vec3f(0, 0, 1) }), osg::Array::BIND_OVERALL);
+            const osg::ref_ptr<osg::Vec4ubArray> colors = makeArray<osg::Vec4ubArray>({ osg::Vec4ub(1, 2, 3, 4),
+                osg::Vec4ub(5, 6, 7, 8), osg::Vec4ub(9, 10, 11, 12), osg::Vec4ub(13, 14, 15, 16) });
+            colors->setNormalize(true);
+            geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+            geometry->setTexCoordArray(1,
+                makeArray<osg::Vec2Array>({ osg::Vec2f(0, 0), osg::Vec2f(1, 0), osg::Vec2f(1, 1), osg::Vec2f(0, 1) }),
+                osg::Array::BIND_PER_VERTEX);
+            geometry->setVertexAttribArray(
+                2, makeArray<osg::FloatArray>({ 0.25f, 0.5f, 0.75f, 1 }), osg::Array::BIND_PER_VERTEX);
+            geometry->addPrimitiveSet(makeDrawElements<osg::DrawElementsUByte>(GL_TRIANGLES, { 0, 1, 2 }));
+            geometry->addPrimitiveSet(makeDrawElements<osg::DrawElementsUShort>(GL_TRIANGLES, { 0, 2, 3 }));
+            geometry->addPrimitiveSet(makeDrawElements<osg::DrawElementsUInt>(GL_LINES, { 3, 0 }));
+            geometry->addPrimitiveSet(new osg::DrawArrays(GL_POINTS, 1, 2));
+            geometry->setNodeMask(0x4);
+            osg::ref_ptr<osg::Group> group = new osg::Group;
+            group->addChild(geometry);
+            ASSERT_TRUE(mCache.store("key", *group, mStateSets));
+
+            const osg::ref_ptr<osg::Group> loaded = mCache.load("key", mStateSets);
+
+            ASSERT_NE(loaded, nullptr);
+            ASSERT_EQ(loaded->getNumChildren(), 1u);
+            const osg::Geometry* const result = loaded->getChild(0)->asGeometry();
+            ASSERT_NE(result, nullptr);
+            EXPECT_EQ(result->getNodeMask(), 0x4u);
+            EXPECT_EQ(getElements<osg::Vec3Array>(result->getVertexArray()),
+                getElements<osg::Vec3Array>(geometry->getVertexArray()));
+            EXPECT_EQ(getElements<osg::Vec3Array>(result->getNormalArray()),
+                getElements<osg::Vec3Array>(geometry->getNormalArray()));
+            EXPECT_EQ(result->getNormalArray()->getBinding(), osg::Array::BIND_OVERALL);
+            EXPECT_EQ(getElements<osg::Vec4ubArray>(result->getColorArray()),
+                getElements<osg::Vec4ubArray>(geometry->getColorArray()));
+            EXPECT_TRUE(result->getColorArray()->getNormalize());
+            EXPECT_EQ(result->getSecondaryColorArray(), nullptr);
+            EXPECT_EQ(result->getFogCoordArray(), nullptr);
+            EXPECT_EQ(result->getTexCoordArray(0), nullptr);
+            EXPECT_EQ(getElements<osg::Vec2Array>(result->getTexCoordArray(1)),
+                getElements<osg::Vec2Array>(geometry->getTexCoordArray(1)));
+            EXPECT_EQ(getElements<osg::FloatArray>(result->getVertexAttribArray(2)),
+                getElements<osg::FloatArray>(geometry->getVertexAttribArray(2)));
+
+            ASSERT_EQ(result->getNumPrimitiveSets(), 4u);
+            for (unsigned i = 0; i < 3; ++i)
+            {
+                const osg::DrawElements* const expected = geometry->getPrimitiveSet(i)->getDrawElements();
+                const osg::DrawElements* const actual = result->getPrimitiveSet(i)->getDrawElements();
+                ASSERT_NE(actual, nullptr) << i;
+                EXPECT_EQ(actual->getType(), expected->getType()) << i;
+                EXPECT_EQ(actual->getMode(), expected->getMode()) << i;
+                ASSERT_EQ(actual->getNumIndices(), expected->getNumIndices()) << i;
+                for (unsigned j = 0; j < expected->getNumIndices(); ++j)
+                    EXPECT_EQ(actual->index(j), expected->index(j)) << i << ' ' << j;
+            }
+            const auto* const drawArrays = dynamic_cast<const osg::DrawArrays*>(result->getPrimitiveSet(3));
+            ASSERT_NE(drawArrays, nullptr);
+            EXPECT_EQ(drawArrays->getMode(), static_cast<GLenum>(GL_POINTS));
+            EXPECT_EQ(drawArrays->getFirst(), 1);
+            EXPECT_EQ(drawArrays->getCount(), 2);
+        }
+
+        TEST_F(SceneUtilGeometryDiskCacheTest, loadShouldMapStateSetsByIndexInGivenList)
+        {
+            osg::ref_ptr<osg::Group> group = new osg::Group;
+            osg::ref_ptr<osg::Group> child = new osg::Group;
+            child->setStateSet(mStateSets[2]);
+            child->addChild(makeGeometry(mStateSets[0]));
+            child->addChild(makeGeometry(nullptr));
+            group->addChild(child);
+            ASSERT_TRUE(mCache.store("key", *group, mStateSets));
+
+            // State sets of another run are different objects in the same order
+            const std::array<osg::ref_ptr<osg::StateSet>, 3> otherRefs{ new osg::StateSet, new osg::StateSet,
+                new osg::StateSet };
+            const std::array<osg::StateSet*, 3> other{ otherRefs[0].get(), otherRefs[1].get(), otherRefs[2].get() };
+            const osg::ref_ptr<osg::Group> loaded = mCache.load("key", other);
+
+            ASSERT_NE(loaded, nullptr);
+            ASSERT_EQ(loaded->getNumChildren(), 1u);
+            const osg::Group* const loadedChild = loaded->getChild(0)->asGroup();
+            ASSERT_NE(loadedChild, nullptr);
+            EXPECT_EQ(loadedChild->getStateSet(), other[2]);
+            ASSERT_EQ(loadedChild->getNumChildren(), 2u);
+            EXPECT_EQ(loadedChild->getChild(0)->getStateSet(), other[0]);
+            EXPECT_EQ(loadedChild->getChild(1)->getStateSet(), nullptr);
+        }
+
+        TEST_F(SceneUtilGeometryDiskCacheTest, loadShouldReturnNullptrForDifferentNumberOfStateSets)
+        {
+            osg::ref_ptr<osg::Group> group = new osg::Group;
+            group->addChild(makeGeometry(mStateSets[0]));
+            ASSERT_TRUE(mCache.store("key", *group, mStateSets));
+
+            EXPECT_EQ(mCache.load("key", std::span(mStateSets).first(2)), nullptr);
+        }
+
+        TEST_F(SceneUtilGeometryDiskCacheTest, storeShouldReturnFalseForStateSetAbsentInList)
+        {
+            osg::ref_ptr<osg::Group> group = new osg::Group;
+            group->addChild(makeGeometry(new osg::StateSet));
+
+            EXPECT_FALSE(mCache.store("key", *group, mStateSets));
+        }
+    }
+}
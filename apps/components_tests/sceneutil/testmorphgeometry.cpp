@@ -0,0 +1,41 @@
+#include <components/sceneutil/morphgeometry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        TEST(SceneUtilBlendMorphTargetsTest, shouldApplyWeightedDenseAndSparseOffsetsToBasePositions)
+        {
+            const std::vector<osg::Vec3f> base{ osg::Vec3f(0, 0, 0), osg::Vec3f(1, 1, 1), osg::Vec3f(2, 2, 2) };
+            const std::vector<osg::Vec3f> dense{ osg::Vec3f(1, 0, 0), osg::Vec3f(0, 1, 0), osg::Vec3f(0, 0, 1) };
+            const std::vector<unsigned> sparseIndices{ 2 };
+            const std::vector<osg::Vec3f> sparse{ osg::Vec3f(4, 0, 0) };
+            osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array(base.begin(), base.end());
+            osg::ref_ptr<osg::Vec3Array> denseOffsets = new osg::Vec3Array(dense.begin(), dense.end());
+            osg::ref_ptr<osg::UIntArray> indices = new osg::UIntArray(sparseIndices.begin(), sparseIndices.end());
+            osg::ref_ptr<osg::Vec3Array> sparseOffsets = new osg::Vec3Array(sparse.begin(), sparse.end());
+            const MorphGeometry::MorphTargetList targets{
+                MorphGeometry::MorphTarget(positions, 0),
+                MorphGeometry::MorphTarget(denseOffsets, 0.5f),
+                MorphGeometry::MorphTarget(indices, sparseOffsets, 0.25f),
+                MorphGeometry::MorphTarget(denseOffsets, 0),
+            };
+            std::vector<osg::Vec3f> result(positions->size());
+
+            blendMorphTargets(targets, result.data());
+
+            const std::vector<osg::Vec3f> expected{
+                osg::Vec3f(0.5f, 0, 0),
+                osg::Vec3f(1, 1.5f, 1),
+                osg::Vec3f(3, 2, 2.5f),
+            };
+            EXPECT_EQ(result, expected);
+        }
+    }
+}
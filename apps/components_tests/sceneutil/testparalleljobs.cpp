@@ -0,0 +1,46 @@
+#include <components/sceneutil/paralleljobs.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        TEST(SceneUtilRunParallelJobsTest, shouldCallJobOnceForEachIndex)
+        {
+            const osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(3);
+            std::vector<std::atomic_int> calls(1000);
+
+            runParallelJobs(workQueue.get(), calls.size(), [&](std::size_t i) { ++calls[i]; });
+
+            for (const std::atomic_int& v : calls)
+                EXPECT_EQ(v, 1);
+        }
+
+        TEST(SceneUtilRunParallelJobsTest, shouldCallJobsOnCallingThreadWithoutWorkQueue)
+        {
+            const std::thread::id caller = std::this_thread::get_id();
+            std::vector<std::thread::id> threads(10);
+
+            runParallelJobs(nullptr, threads.size(), [&](std::size_t i) { threads[i] = std::this_thread::get_id(); });
+
+            for (const std::thread::id& v : threads)
+                EXPECT_EQ(v, caller);
+        }
+
+        TEST(SceneUtilRunParallelJobsTest, shouldNotCallJobForZeroCount)
+        {
+            const osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(1);
+            bool called = false;
+
+            runParallelJobs(workQueue.get(), 0, [&](std::size_t) { called = true; });
+
+            EXPECT_FALSE(called);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include <components/sceneutil/skinning.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        TEST(SceneUtilGroupSkinInfluencesTest, shouldGroupVerticesWithSameWeightsAndDropUnweighted)
+        {
+            const std::vector<BoneWeights> influences{
+                { { 0, 1.0f } },
+                {},
+                { { 0, 0.5f }, { 1, 0.5f } },
+                { { 0, 1.0f } },
+            };
+            const SkinInfluences expected{
+                { { { 0, 0.5f }, { 1, 0.5f } }, { 2 } },
+                { { { 0, 1.0f } }, { 0, 3 } },
+            };
+            EXPECT_EQ(groupSkinInfluences(influences), expected);
+        }
+
+        TEST(SceneUtilSkinVerticesTest, shouldBlendBoneMatricesAndApplyTransform)
+        {
+            const SkinInfluences influences{
+                { { { 0, 0.5f }, { 1, 0.5f } }, { 0 } },
+                { { { 2, 1.0f } }, { 1 } },
+            };
+            // Missing bones have zero matrix
+            const std::vector<osg::Matrixf> boneMatrices{
+                osg::Matrixf::translate(2, 0, 0),
+                osg::Matrixf::translate(0, 4, 0),
+                osg::Matrixf(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0),
+            };
+            const osg::Matrixf transform = osg::Matrixf::rotate(osg::PI_2f, osg::Vec3f(0, 0, 1));
+            const std::vector<osg::Vec3f> sourcePositions{ osg::Vec3f(1, 0, 0), osg::Vec3f(1, 1, 1) };
+            const std::vector<osg::Vec3f> sourceNormals{ osg::Vec3f(1, 0, 0), osg::Vec3f(0, 0, 1) };
+            std::vector<osg::Vec3f> positions(2);
+            std::vector<osg::Vec3f> normals(2);
+
+            skinVertices(influences, boneMatrices, transform,
+                SkinSource{ .mPositions = sourcePositions.data(), .mNormals = sourceNormals.data() },
+                SkinDestination{ .mPositions = positions.data(), .mNormals = normals.data() });
+
+            for (const auto& [position, expected] : { std::pair{ positions[0], osg::Vec3f(-2, 2, 0) },
+                     std::pair{ positions[1], osg::Vec3f(0, 0, 0) }, std::pair{ normals[0], osg::Vec3f(0, 1, 0) } })
+            {
+                EXPECT_NEAR(position.x(), expected.x(), 1e-5f);
+                EXPECT_NEAR(position.y(), expected.y(), 1e-5f);
+                EXPECT_NEAR(position.z(), expected.z(), 1e-5f);
+            }
+        }
+    }
+}
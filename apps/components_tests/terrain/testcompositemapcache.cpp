@@ -0,0 +1,89 @@
+#include <components/terrain/compositemapcache.hpp>
+
+#include <osg/Image>
+#include <osg/Texture>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace Terrain
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        osg::ref_ptr<osg::Image> makeImage(int width, int height)
+        {
+            osg::ref_ptr<osg::Image> image = new osg::Image;
+            image->allocateImage(width, height, 1, GL_RGB, GL_UNSIGNED_BYTE);
+            return image;
+        }
+
+        void setPixel(osg::Image& image, int x, int y, unsigned char r, unsigned char g, unsigned char b)
+        {
+            unsigned char* pixel = image.data(x, y);
+            pixel[0] = r;
+            pixel[1] = g;
+            pixel[2] = b;
+        }
+
+        std::uint16_t readUInt16(const unsigned char* data)
+        {
+            return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+        }
+
+        std::uint32_t readUInt32(const unsigned char* data)
+        {
+            return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8)
+                | (static_cast<std::uint32_t>(data[2]) << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+        }
+
+        TEST(TerrainCompressDxt1Test, shouldCreateFullMipmapChain)
+        {
+            const osg::ref_ptr<osg::Image> image = makeImage(8, 8);
+            std::memset(image->data(), 0, image->getTotalSizeInBytes());
+
+            const osg::ref_ptr<osg::Image> result = compressDxt1(*image);
+
+            EXPECT_EQ(result->getPixelFormat(), static_cast<GLenum>(GL_COMPRESSED_RGB_S3TC_DXT1_EXT));
+            EXPECT_EQ(result->s(), 8);
+            EXPECT_EQ(result->t(), 8);
+            ASSERT_EQ(result->getNumMipmapLevels(), 4u);
+            EXPECT_EQ(result->getMipmapOffset(1), 32u);
+            EXPECT_EQ(result->getMipmapOffset(2), 40u);
+            EXPECT_EQ(result->getMipmapOffset(3), 48u);
+        }
+
+        TEST(TerrainCompressDxt1Test, shouldUseSingleColorForUniformBlock)
+        {
+            const osg::ref_ptr<osg::Image> image = makeImage(4, 4);
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x)
+                    setPixel(*image, x, y, 255, 0, 255);
+
+            const osg::ref_ptr<osg::Image> result = compressDxt1(*image);
+
+            EXPECT_EQ(readUInt16(result->data()), 0xf81f);
+            EXPECT_EQ(readUInt16(result->data() + 2), 0xf81f);
+            EXPECT_EQ(readUInt32(result->data() + 4), 0u);
+        }
+
+        TEST(TerrainCompressDxt1Test, shouldMapPixelsToNearestEndpoints)
+        {
+            const osg::ref_ptr<osg::Image> image = makeImage(4, 4);
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x)
+                {
+                    const unsigned char value = x < 2 ? 0 : 255;
+                    setPixel(*image, x, y, value, value, value);
+                }
+
+            const osg::ref_ptr<osg::Image> result = compressDxt1(*image);
+
+            EXPECT_GT(readUInt16(result->data()), readUInt16(result->data() + 2));
+            EXPECT_EQ(readUInt32(result->data() + 4), 0x05050505u);
+        }
+    }
+}
@@ -346,6 +346,12 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
     mStereoManager->updateSettings(Settings::camera().mNearClip, Settings::camera().mViewingDistance);
 
     mViewer->eventTraversal();
+
+    {
+        ScopedProfile<UserStatsType::Animation> profile(frameStart, frameNumber, *timer, *stats);
+        mWorld->prepareAnimations();
+    }
+
     mViewer->updateTraversal();
 
     // update focus object for GUI
@@ -17,6 +17,7 @@
 #include "luamanagerimp.hpp"
 #include "objectlists.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace
@@ -51,6 +52,25 @@ namespace
 
         return ignore;
     }
+
+    MWPhysics::RayCastingRequest parseRayCastingRequest(const sol::table& request)
+    {
+        MWPhysics::RayCastingRequest result;
+        result.mFrom = request.get<osg::Vec3f>("from");
+        result.mTo = request.get<osg::Vec3f>("to");
+        result.mIgnore = parseIgnoreList<MWWorld::ConstPtr>(request);
+        result.mMask = request.get<sol::optional<int>>("collisionType").value_or(result.mMask);
+        result.mRadius = std::max(request.get<sol::optional<float>>("radius").value_or(0), 0.f);
+        if (result.mRadius > 0)
+        {
+            for (const auto& ptr : result.mIgnore)
+            {
+                if (!ptr.isEmpty())
+                    throw std::logic_error("Currently castRays doesn't support `ignore` when radius > 0");
+            }
+        }
+        return result;
+    }
 }
 
 namespace sol
@@ -134,6 +154,14 @@ namespace MWLua
                 return rayCasting->castSphere(from, to, radius, collisionType);
             }
         };
+        api["castRays"] = [](const sol::table& requests) {
+            std::vector<MWPhysics::RayCastingRequest> parsed;
+            parsed.reserve(requests.size());
+            for (std::size_t i = 1; i <= requests.size(); ++i)
+                parsed.push_back(parseRayCastingRequest(requests.get<sol::table>(i)));
+            const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
+            return sol::as_table(rayCasting->castRays(parsed));
+        };
         // TODO: async raycasting
         /*api["asyncCastRay"] = [luaManager = context.mLuaManager](
             const Callback& luaCallback, const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table>
@@ -423,10 +423,14 @@ namespace MWMechanics
         std::back_insert_iterator<std::deque<osg::Vec3f>> out)
     {
         const MWBase::World& world = *MWBase::Environment::get().getWorld();
-        const DetourNavigator::Navigator& navigator = *world.getNavigator();
+        DetourNavigator::Navigator& navigator = *world.getNavigator();
         const DetourNavigator::Status status = DetourNavigator::findPath(
             navigator, agentBounds, startPoint, endPoint, flags, areaCosts, endTolerance, checkpoints, out);
 
+        // Missing or outdated tiles could be a reason for not complete path so build them first
+        if (status != DetourNavigator::Status::Success && status != DetourNavigator::Status::NavMeshNotFound)
+            navigator.prioritizePath(agentBounds, startPoint, endPoint);
+
         if (pathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
             return DetourNavigator::Status::Success;
 
@@ -454,7 +458,15 @@ namespace MWMechanics
         if (distance <= maxDistance)
             return buildPath(
                 actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
+        // Detailed path is built only to the farthest reachable point of a coarse path over navmesh tiles
+        auto end = startPoint + startToEnd * maxDistance / distance;
+        for (const osg::Vec3f& point :
+            DetourNavigator::findCoarsePath(*navigator, agentBounds, startPoint, endPoint, flags))
+        {
+            if ((point - startPoint).length() > maxDistance)
+                break;
+            end = point;
+        }
         buildPath(actor, startPoint, end, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
     }
 }
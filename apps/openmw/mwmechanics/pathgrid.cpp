@@ -1,8 +1,9 @@
 #include "pathgrid.hpp"
 
 #include <algorithm>
-#include <list>
-#include <set>
+#include <functional>
+#include <limits>
+#include <queue>
 
 namespace
 {
@@ -45,6 +46,11 @@ namespace
     }
 
     constexpr size_t NoIndex = static_cast<size_t>(-1);
+
+    constexpr std::uint16_t NoNextPoint = std::numeric_limits<std::uint16_t>::max();
+
+    // Shortest path trees take up to points count squared memory, most of pathgrids are smaller
+    constexpr size_t MaxPointsForShortestPathTrees = 256;
 }
 
 namespace MWMechanics
@@ -182,12 +188,15 @@ namespace MWMechanics
             // forward path of the edge
             neighbour.index = edge.mV1;
             mGraph[edge.mV0].edges.push_back(neighbour);
+            mGraph[edge.mV1].reverseEdges.push_back(ConnectedPoint{ edge.mV0, neighbour.cost });
             // reverse path of the edge
             // NOTE: These are redundant, ESM already contains the required reverse paths
             // neighbour.index = edge.mV0;
             // mGraph[edge.mV1].edges.push_back(neighbour);
         }
         Builder(*this);
+        if (mGraph.size() <= MaxPointsForShortestPathTrees)
+            mShortestPathTrees.resize(mGraph.size());
     }
 
     const PathgridGraph PathgridGraph::sEmpty = {};
@@ -223,15 +232,13 @@ namespace MWMechanics
      *   start, goal - pathgrid point indexes (for this cell)
      *
      * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
+     *   openset - point indexes to be traversed with future estimated costs,
+     *             lowest cost at the top
      *   closedset - point indexes already traversed
      *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
      *
-     * TODO: An interesting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
+     * Small pathgrids use cached shortest path trees instead, see
+     * getShortestPathTree.
      */
     std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const size_t start, const size_t goal) const
     {
@@ -241,59 +248,50 @@ namespace MWMechanics
             return path; // there is no path, return an empty path
         }
 
+        if (!mShortestPathTrees.empty())
+            return searchByShortestPathTree(start, goal);
+
         size_t graphSize = mGraph.size();
         std::vector<float> gScore(graphSize, -1);
-        std::vector<float> fScore(graphSize, -1);
         std::vector<size_t> graphParent(graphSize, NoIndex);
+        std::vector<bool> closedset(graphSize, false);
 
-        // gScore & fScore keep costs for each pathgrid point in mPoints
+        // gScore keeps costs for each pathgrid point in mPoints
         gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
 
-        std::list<size_t> openset;
-        std::set<size_t> closedset;
-        openset.push_back(start);
+        // lowest fScore is at the top, outdated entries are skipped when popped
+        std::priority_queue<std::pair<float, size_t>, std::vector<std::pair<float, size_t>>, std::greater<>> openset;
+        openset.emplace(costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]), start);
 
         size_t current = start;
 
         while (!openset.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            current = openset.top().second;
+            openset.pop();
+
+            if (closedset[current])
+                continue;
 
             if (current == goal)
                 break;
 
-            closedset.insert(current); // remember we've been here
+            closedset[current] = true; // remember we've been here
 
             // check all edges for the current point index
             for (const auto& edge : mGraph[current].edges)
             {
-                if (!closedset.contains(edge.index))
+                const size_t dest = edge.index;
+                if (closedset[dest])
+                    continue; // traversed this edge destination already, try the next edge
+                const float tentativeG = gScore[current] + edge.cost;
+                if (gScore[dest] < 0 || tentativeG < gScore[dest])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    size_t dest = edge.index;
-                    float tentativeG = gScore[current] + edge.cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if (!isInOpenSet || tentativeG < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentativeG;
-                        fScore[dest] = tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
-                        if (!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            auto it = openset.begin();
-                            for (; it != openset.end(); ++it)
-                            {
-                                if (fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    graphParent[dest] = current;
+                    gScore[dest] = tentativeG;
+                    openset.emplace(
+                        tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]), dest);
+                }
             }
         }
 
@@ -311,4 +309,62 @@ namespace MWMechanics
         path.push_front(mPathgrid->mPoints[start]);
         return path;
     }
+
+    /*
+     * Dijkstra search from the goal over reversed edges. Gives the shortest
+     * path from any point to the goal so all following searches to the same
+     * goal only have to follow the tree.
+     */
+    const std::vector<std::uint16_t>& PathgridGraph::getShortestPathTree(const size_t goal) const
+    {
+        std::vector<std::uint16_t>& tree = mShortestPathTrees[goal];
+        if (!tree.empty())
+            return tree;
+
+        tree.resize(mGraph.size(), NoNextPoint);
+        std::vector<float> cost(mGraph.size(), std::numeric_limits<float>::max());
+        std::priority_queue<std::pair<float, size_t>, std::vector<std::pair<float, size_t>>, std::greater<>> queue;
+
+        cost[goal] = 0;
+        tree[goal] = static_cast<std::uint16_t>(goal);
+        queue.emplace(0.0f, goal);
+
+        while (!queue.empty())
+        {
+            const auto [currentCost, current] = queue.top();
+            queue.pop();
+
+            if (currentCost > cost[current])
+                continue;
+
+            for (const auto& edge : mGraph[current].reverseEdges)
+            {
+                const float newCost = currentCost + edge.cost;
+                if (newCost >= cost[edge.index])
+                    continue;
+                cost[edge.index] = newCost;
+                tree[edge.index] = static_cast<std::uint16_t>(current);
+                queue.emplace(newCost, edge.index);
+            }
+        }
+
+        return tree;
+    }
+
+    std::deque<ESM::Pathgrid::Point> PathgridGraph::searchByShortestPathTree(
+        const size_t start, const size_t goal) const
+    {
+        const std::vector<std::uint16_t>& tree = getShortestPathTree(goal);
+        std::deque<ESM::Pathgrid::Point> path;
+        size_t current = start;
+        path.push_back(mPathgrid->mPoints[start]);
+        while (current != goal)
+        {
+            current = tree[current];
+            if (current == NoNextPoint)
+                return {};
+            path.push_back(mPathgrid->mPoints[current]);
+        }
+        return path;
+    }
 }
@@ -1,7 +1,9 @@
 #ifndef GAME_MWMECHANICS_PATHGRID_H
 #define GAME_MWMECHANICS_PATHGRID_H
 
+#include <cstdint>
 #include <deque>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -31,6 +33,9 @@ namespace MWMechanics
         // cells) coordinates
         //
         // NOTE: if start equals end an empty path is returned
+        //
+        // For small pathgrids uses shortest path tree to the end point which is built on
+        // the first search and reused by the following ones. Not thread safe.
         std::deque<ESM::Pathgrid::Point> aStarSearch(const size_t start, const size_t end) const;
 
         static const PathgridGraph sEmpty;
@@ -50,6 +55,7 @@ namespace MWMechanics
         {
             int componentId;
             std::vector<ConnectedPoint> edges; // neighbours
+            std::vector<ConnectedPoint> reverseEdges; // points having edge to this one
         };
 
         // componentId is an integer indicating the groups of connected
@@ -62,6 +68,14 @@ namespace MWMechanics
         //   all other pathgrid points are the third set
         //
         std::vector<Node> mGraph;
+
+        // mShortestPathTrees[goal][v] is the next point index on the shortest path
+        // from v to goal, empty until the first search to the goal
+        mutable std::vector<std::vector<std::uint16_t>> mShortestPathTrees;
+
+        const std::vector<std::uint16_t>& getShortestPathTree(const size_t goal) const;
+
+        std::deque<ESM::Pathgrid::Point> searchByShortestPathTree(const size_t start, const size_t goal) const;
     };
 }
 
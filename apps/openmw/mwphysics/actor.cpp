@@ -11,6 +11,7 @@
 #include "../mwworld/class.hpp"
 
 #include "collisiontype.hpp"
+#include "constants.hpp"
 #include "mtphysics.hpp"
 #include "trace.h"
 
@@ -122,6 +123,8 @@ namespace MWPhysics
 
     void Actor::enableCollisionMode(bool collision)
     {
+        if (mInternalCollisionMode != collision)
+            wakeUp();
         mInternalCollisionMode = collision;
     }
 
@@ -129,6 +132,7 @@ namespace MWPhysics
     {
         if (mExternalCollisionMode != collision)
         {
+            wakeUp();
             mExternalCollisionMode = collision;
             updateCollisionMask();
         }
@@ -164,6 +168,7 @@ namespace MWPhysics
         mPositionOffset = osg::Vec3f();
         mStandingOnPtr = nullptr;
         mSkipSimulation = true;
+        wakeUp();
     }
 
     void Actor::setSimulationPosition(const osg::Vec3f& position)
@@ -216,6 +221,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         mPositionOffset += offset;
+        wakeUp();
     }
 
     osg::Vec3f Actor::applyOffsetChange()
@@ -233,6 +239,8 @@ namespace MWPhysics
     void Actor::setRotation(osg::Quat quat)
     {
         std::scoped_lock lock(mPositionMutex);
+        if (mRotation != quat)
+            wakeUp();
         mRotation = quat;
     }
 
@@ -245,6 +253,7 @@ namespace MWPhysics
     {
         std::scoped_lock lock(mPositionMutex);
         updateScaleUnsafe();
+        wakeUp();
     }
 
     void Actor::updateScaleUnsafe()
@@ -305,6 +314,7 @@ namespace MWPhysics
     {
         if (waterWalk != mCanWaterWalk)
         {
+            wakeUp();
             mCanWaterWalk = waterWalk;
             updateCollisionMask();
         }
@@ -333,4 +343,16 @@ namespace MWPhysics
         return (tracer.mFraction >= 1.0f);
     }
 
+    bool Actor::isSleeping() const
+    {
+        return mRestingFrames.load(std::memory_order_relaxed) >= sFramesToSleep;
+    }
+
+    void Actor::updateSleepState(bool resting)
+    {
+        if (!resting)
+            wakeUp();
+        else if (!isSleeping())
+            mRestingFrames.fetch_add(1, std::memory_order_relaxed);
+    }
 }
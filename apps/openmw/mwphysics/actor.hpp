@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWPHYSICS_ACTOR_H
 #define OPENMW_MWPHYSICS_ACTOR_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -140,12 +141,25 @@ namespace MWPhysics
         const osg::Vec3f& getLastStuckPosition() const { return mLastStuckPosition; }
         void setLastStuckPosition(osg::Vec3f position) { mLastStuckPosition = position; }
 
+        /// Time in seconds spent to move this actor during the last simulated frame
+        double getSimulationCost() const { return mSimulationCost; }
+        void setSimulationCost(double value) { mSimulationCost = value; }
+
         bool canMoveToWaterSurface(float waterlevel, const btCollisionWorld* world) const;
 
         bool isActive() const { return mActive; }
 
         void setActive(bool value) { mActive = value; }
 
+        /// Sleeping actor has been resting on the ground for a few frames so its movement solving can be skipped
+        bool isSleeping() const;
+
+        /// Thread safe
+        void wakeUp() { mRestingFrames.store(0, std::memory_order_relaxed); }
+
+        /// Called after each simulated frame, actor falls asleep after resting for a few frames in a row
+        void updateSleepState(bool resting);
+
         DetourNavigator::CollisionShapeType getCollisionShapeType() const { return mCollisionShapeType; }
 
     private:
@@ -181,6 +195,8 @@ namespace MWPhysics
 
         unsigned int mStuckFrames;
         osg::Vec3f mLastStuckPosition;
+        double mSimulationCost = 0;
+        std::atomic<unsigned> mRestingFrames{ 0 };
 
         osg::Vec3f mForce;
         bool mOnGround;
@@ -0,0 +1,67 @@
+#include "broadphase.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btOverlappingPairCache.h>
+#include <LinearMath/btAlignedAllocator.h>
+
+#include <new>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        class CountingPairCache final : public btNullPairCache
+        {
+        public:
+            std::size_t mPairs = 0;
+
+            btBroadphasePair* addOverlappingPair(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) override
+            {
+                if ((proxy0->m_collisionFilterGroup & proxy1->m_collisionFilterMask) != 0
+                    && (proxy1->m_collisionFilterGroup & proxy0->m_collisionFilterMask) != 0)
+                    ++mPairs;
+                return nullptr;
+            }
+        };
+    }
+
+    Broadphase::Broadphase(bool splitStatic)
+        : btDbvtBroadphase(new (btAlignedAlloc(sizeof(CountingPairCache), 16)) CountingPairCache)
+        , mSplitStatic(splitStatic)
+    {
+        // Pair cache is destroyed by the base class
+        m_releasepaircache = true;
+    }
+
+    void Broadphase::setAabb(
+        btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax, btDispatcher* dispatcher)
+    {
+        ++mAabbUpdates;
+        btDbvtBroadphase::setAabb(proxy, aabbMin, aabbMax, dispatcher);
+    }
+
+    void Broadphase::update(btDispatcher* dispatcher)
+    {
+        CountingPairCache& pairCache = static_cast<CountingPairCache&>(*m_paircache);
+
+        if (mSplitStatic)
+        {
+            const int staticBefore = m_sets[1].m_leaves;
+            // Pairs search is not deferred so collide only moves proxies between the trees and optimizes them
+            collide(dispatcher);
+            // Incremental optimization is too slow to handle a loaded cell
+            if (m_sets[1].m_leaves - staticBefore > staticBefore / 4)
+            {
+                m_sets[1].optimizeTopDown();
+                m_fixedleft = 0;
+            }
+        }
+
+        mStats.mStaticProxies = static_cast<std::size_t>(m_sets[1].m_leaves);
+        mStats.mDynamicProxies = static_cast<std::size_t>(m_sets[0].m_leaves);
+        mStats.mPairs = pairCache.mPairs;
+        mStats.mAabbUpdates = mAabbUpdates;
+
+        pairCache.mPairs = 0;
+        mAabbUpdates = 0;
+    }
+}
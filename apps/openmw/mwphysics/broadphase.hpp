@@ -0,0 +1,44 @@
+#ifndef OPENMW_MWPHYSICS_BROADPHASE_H
+#define OPENMW_MWPHYSICS_BROADPHASE_H
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+
+#include <cstddef>
+
+namespace MWPhysics
+{
+    struct BroadphaseStats
+    {
+        std::size_t mStaticProxies = 0;
+        std::size_t mDynamicProxies = 0;
+        std::size_t mPairs = 0;
+        std::size_t mAabbUpdates = 0;
+    };
+
+    // btDbvtBroadphase keeps recently moved proxies in a dynamic tree and all others in a static one but moves them
+    // there only from the dynamics world step which is never called because collision world is used only for queries.
+    // Without it statics, doors, actors and projectiles are all mixed in the dynamic tree. Update moves proxies not
+    // updated during last frames into the static tree which is rebuilt when a lot of objects are added and otherwise
+    // only incrementally optimized. Overlapping pairs are not stored because they are never used, only counted.
+    class Broadphase final : public btDbvtBroadphase
+    {
+    public:
+        explicit Broadphase(bool splitStatic);
+
+        void setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax,
+            btDispatcher* dispatcher) override;
+
+        // Has to be called once per frame when no collision queries are running
+        void update(btDispatcher* dispatcher);
+
+        // Stats for the last updated frame
+        const BroadphaseStats& getStats() const { return mStats; }
+
+    private:
+        const bool mSplitStatic;
+        std::size_t mAabbUpdates = 0;
+        BroadphaseStats mStats;
+    };
+}
+
+#endif
@@ -13,6 +13,9 @@ namespace MWPhysics
 
     static constexpr float sGroundOffset = 1.0f;
 
+    // Number of simulated frames in a row an actor has to rest on the ground before its movement solving is skipped
+    static constexpr unsigned sFramesToSleep = 3;
+
     // Arbitrary number. To prevent infinite loops. They shouldn't happen but it's good to be prepared.
     static constexpr int sMaxIterations = 8;
     // Allows for more precise movement solving without getting stuck or snagging too easily.
@@ -1,4 +1,5 @@
 #include "heightfield.hpp"
+#include "heightfieldshape.hpp"
 #include "mtphysics.hpp"
 
 #include <components/bullethelpers/heightfield.hpp>
@@ -6,7 +7,6 @@
 #include <osg/Object>
 
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
-#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
 
 #include <LinearMath/btTransform.h>
 
@@ -61,12 +61,10 @@ namespace MWPhysics
         , mTaskScheduler(scheduler)
     {
 #if BT_BULLET_VERSION < 310
-        mShape = std::make_unique<btHeightfieldTerrainShape>(
-            verts, verts, getHeights(heights, mHeights), 1, minH, maxH, 2, PHY_FLOAT, false);
+        mShape = std::make_unique<HeightFieldShape>(verts, getHeights(heights, mHeights), minH, maxH);
 #else
-        mShape = std::make_unique<btHeightfieldTerrainShape>(verts, verts, heights, minH, maxH, 2, false);
+        mShape = std::make_unique<HeightFieldShape>(verts, heights, minH, maxH);
 #endif
-        mShape->setUseDiamondSubdivision(true);
 
         const float scaling = static_cast<float>(size) / static_cast<float>(verts - 1);
         mShape->setLocalScaling(btVector3(scaling, scaling, 1));
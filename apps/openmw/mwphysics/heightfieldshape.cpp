@@ -0,0 +1,183 @@
+#include "heightfieldshape.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        int toCell(btScalar value, int cells)
+        {
+            return static_cast<int>(std::clamp<btScalar>(std::floor(value), -1, static_cast<btScalar>(cells)));
+        }
+
+        bool overlaps(const btVector3 (&triangle)[3], btScalar minHeight, btScalar maxHeight)
+        {
+            return std::max({ triangle[0].z(), triangle[1].z(), triangle[2].z() }) >= minHeight
+                && std::min({ triangle[0].z(), triangle[1].z(), triangle[2].z() }) <= maxHeight;
+        }
+    }
+
+#if BT_BULLET_VERSION < 310
+    HeightFieldShape::HeightFieldShape(int verts, const btScalar* heights, float minHeight, float maxHeight)
+        : btHeightfieldTerrainShape(verts, verts, heights, 1, minHeight, maxHeight, 2, PHY_FLOAT, false)
+#else
+    HeightFieldShape::HeightFieldShape(int verts, const float* heights, float minHeight, float maxHeight)
+        : btHeightfieldTerrainShape(verts, verts, heights, minHeight, maxHeight, 2, false)
+#endif
+    {
+        setUseDiamondSubdivision(true);
+        buildLevels();
+    }
+
+    void HeightFieldShape::buildLevels()
+    {
+        const int cells = m_heightStickWidth - 1;
+        if (cells <= 0)
+            return;
+
+        Level& first = mLevels.emplace_back();
+        first.mSize = cells;
+        first.mMin.resize(static_cast<std::size_t>(cells) * cells);
+        first.mMax.resize(static_cast<std::size_t>(cells) * cells);
+
+        std::vector<btScalar> row(m_heightStickWidth);
+        std::vector<btScalar> nextRow(m_heightStickWidth);
+        for (int x = 0; x < m_heightStickWidth; ++x)
+            row[x] = getRawHeightFieldValue(x, 0);
+        for (int y = 0; y < cells; ++y)
+        {
+            for (int x = 0; x < m_heightStickWidth; ++x)
+                nextRow[x] = getRawHeightFieldValue(x, y + 1);
+            btScalar* const min = first.mMin.data() + static_cast<std::size_t>(y) * cells;
+            btScalar* const max = first.mMax.data() + static_cast<std::size_t>(y) * cells;
+            for (int x = 0; x < cells; ++x)
+            {
+                min[x] = std::min(std::min(row[x], row[x + 1]), std::min(nextRow[x], nextRow[x + 1]));
+                max[x] = std::max(std::max(row[x], row[x + 1]), std::max(nextRow[x], nextRow[x + 1]));
+            }
+            std::swap(row, nextRow);
+        }
+
+        while (mLevels.back().mSize > 1)
+        {
+            const Level& previous = mLevels.back();
+            Level next;
+            next.mSize = (previous.mSize + 1) / 2;
+            next.mMin.resize(static_cast<std::size_t>(next.mSize) * next.mSize);
+            next.mMax.resize(static_cast<std::size_t>(next.mSize) * next.mSize);
+            for (int y = 0; y < next.mSize; ++y)
+            {
+                for (int x = 0; x < next.mSize; ++x)
+                {
+                    const std::size_t index = static_cast<std::size_t>(y) * next.mSize + x;
+                    next.mMin[index] = std::numeric_limits<btScalar>::max();
+                    next.mMax[index] = -std::numeric_limits<btScalar>::max();
+                    for (int childY = 2 * y; childY < std::min(2 * y + 2, previous.mSize); ++childY)
+                    {
+                        for (int childX = 2 * x; childX < std::min(2 * x + 2, previous.mSize); ++childX)
+                        {
+                            const std::size_t child = static_cast<std::size_t>(childY) * previous.mSize + childX;
+                            next.mMin[index] = std::min(next.mMin[index], previous.mMin[child]);
+                            next.mMax[index] = std::max(next.mMax[index], previous.mMax[child]);
+                        }
+                    }
+                }
+            }
+            mLevels.push_back(std::move(next));
+        }
+    }
+
+    void HeightFieldShape::processAllTriangles(
+        btTriangleCallback* callback, const btVector3& aabbMin, const btVector3& aabbMax) const
+    {
+        if (mLevels.empty())
+            return;
+
+        // Grid coordinates and raw heights
+        const btVector3 localAabbMin = aabbMin / m_localScaling + m_localOrigin;
+        const btVector3 localAabbMax = aabbMax / m_localScaling + m_localOrigin;
+        const int cells = mLevels.front().mSize;
+
+        // Expand by a cell like the base class does to catch aabb falling between grid points
+        const Query query{
+            .mBeginX = std::max(0, toCell(localAabbMin.x(), cells) - 1),
+            .mEndX = std::min(cells, toCell(localAabbMax.x(), cells) + 2),
+            .mBeginY = std::max(0, toCell(localAabbMin.y(), cells) - 1),
+            .mEndY = std::min(cells, toCell(localAabbMax.y(), cells) + 2),
+            .mMinRawHeight = localAabbMin.z(),
+            .mMaxRawHeight = localAabbMax.z(),
+            .mMinHeight = aabbMin.z(),
+            .mMaxHeight = aabbMax.z(),
+            .mCallback = callback,
+        };
+
+        if (query.mBeginX >= query.mEndX || query.mBeginY >= query.mEndY)
+            return;
+
+        processNode(mLevels.size() - 1, 0, 0, query);
+    }
+
+    void HeightFieldShape::processNode(std::size_t level, int x, int y, const Query& query) const
+    {
+        const Level& current = mLevels[level];
+        const std::size_t index = static_cast<std::size_t>(y) * current.mSize + x;
+        if (current.mMax[index] < query.mMinRawHeight || current.mMin[index] > query.mMaxRawHeight)
+            return;
+
+        if (level == 0)
+        {
+            processCell(x, y, query);
+            return;
+        }
+
+        const Level& children = mLevels[level - 1];
+        const int childCells = 1 << static_cast<int>(level - 1);
+        for (int childY = 2 * y; childY < std::min(2 * y + 2, children.mSize); ++childY)
+        {
+            if (childY * childCells >= query.mEndY || (childY + 1) * childCells <= query.mBeginY)
+                continue;
+            for (int childX = 2 * x; childX < std::min(2 * x + 2, children.mSize); ++childX)
+            {
+                if (childX * childCells >= query.mEndX || (childX + 1) * childCells <= query.mBeginX)
+                    continue;
+                processNode(level - 1, childX, childY, query);
+            }
+        }
+    }
+
+    void HeightFieldShape::processCell(int x, int y, const Query& query) const
+    {
+        // Same triangles and indices as btHeightfieldTerrainShape::processAllTriangles with diamond subdivision
+        btVector3 vertices[3];
+        if (((x + y) & 1) == 0)
+        {
+            getVertex(x, y, vertices[0]);
+            getVertex(x, y + 1, vertices[1]);
+            getVertex(x + 1, y + 1, vertices[2]);
+            if (overlaps(vertices, query.mMinHeight, query.mMaxHeight))
+                query.mCallback->processTriangle(vertices, 2 * x, y);
+
+            getVertex(x + 1, y + 1, vertices[1]);
+            getVertex(x + 1, y, vertices[2]);
+            if (overlaps(vertices, query.mMinHeight, query.mMaxHeight))
+                query.mCallback->processTriangle(vertices, 2 * x + 1, y);
+        }
+        else
+        {
+            getVertex(x, y, vertices[0]);
+            getVertex(x, y + 1, vertices[1]);
+            getVertex(x + 1, y, vertices[2]);
+            if (overlaps(vertices, query.mMinHeight, query.mMaxHeight))
+                query.mCallback->processTriangle(vertices, 2 * x, y);
+
+            getVertex(x + 1, y, vertices[0]);
+            getVertex(x + 1, y + 1, vertices[2]);
+            if (overlaps(vertices, query.mMinHeight, query.mMaxHeight))
+                query.mCallback->processTriangle(vertices, 2 * x + 1, y);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef OPENMW_MWPHYSICS_HEIGHTFIELDSHAPE_H
+#define OPENMW_MWPHYSICS_HEIGHTFIELDSHAPE_H
+
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace MWPhysics
+{
+    // Square heightfield with Z up axis and diamond subdivision. Generates the same triangles as the base class but
+    // skips parts of the grid outside of the requested height range using min/max height quadtree. It is used by
+    // convex sweeps and contact tests. Ray tests are done by the base class using its own accelerator.
+    class HeightFieldShape final : public btHeightfieldTerrainShape
+    {
+    public:
+#if BT_BULLET_VERSION < 310
+        HeightFieldShape(int verts, const btScalar* heights, float minHeight, float maxHeight);
+#else
+        HeightFieldShape(int verts, const float* heights, float minHeight, float maxHeight);
+#endif
+
+        void processAllTriangles(
+            btTriangleCallback* callback, const btVector3& aabbMin, const btVector3& aabbMax) const override;
+
+    private:
+        // Separate arrays for min and max heights allow compiler to vectorize the loops building them
+        struct Level
+        {
+            int mSize;
+            std::vector<btScalar> mMin;
+            std::vector<btScalar> mMax;
+        };
+
+        struct Query
+        {
+            int mBeginX;
+            int mEndX;
+            int mBeginY;
+            int mEndY;
+            // Range in the heightfield data units to check quadtree nodes
+            btScalar mMinRawHeight;
+            btScalar mMaxRawHeight;
+            // Range in the shape space to check triangles
+            btScalar mMinHeight;
+            btScalar mMaxHeight;
+            btTriangleCallback* mCallback;
+        };
+
+        // First level has bounds for each cell, each next one merges 2x2 nodes of the previous one
+        std::vector<Level> mLevels;
+
+        void buildLevels();
+
+        void processNode(std::size_t level, int x, int y, const Query& query) const;
+
+        void processCell(int x, int y, const Query& query) const;
+    };
+}
+
+#endif
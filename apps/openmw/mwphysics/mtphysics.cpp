@@ -1,8 +1,11 @@
 #include "mtphysics.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <functional>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <shared_mutex>
 #include <stdexcept>
@@ -30,11 +33,14 @@
 #include "../mwbase/world.hpp"
 
 #include "actor.hpp"
+#include "broadphase.hpp"
+#include "constants.hpp"
 #include "contacttestwrapper.h"
 #include "movementsolver.hpp"
 #include "object.hpp"
 #include "physicssystem.hpp"
 #include "projectile.hpp"
+#include "simulationrecording.hpp"
 
 namespace MWPhysics
 {
@@ -121,6 +127,45 @@ namespace MWPhysics
         private:
             std::variant<std::monostate, std::unique_lock<Mutex>, std::shared_lock<Mutex>> mImpl;
         };
+
+        class WakeUpActorsCallback final : public btBroadphaseAabbCallback
+        {
+        public:
+            bool process(const btBroadphaseProxy* proxy) override
+            {
+                if ((proxy->m_collisionFilterGroup & CollisionType_Actor) == 0)
+                    return true;
+                const auto* const collisionObject = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+                auto* const ptrHolder = static_cast<PtrHolder*>(collisionObject->getUserPointer());
+                if (auto* const actor = dynamic_cast<Actor*>(ptrHolder))
+                    actor->wakeUp();
+                return true;
+            }
+        };
+
+        // Actors and projectiles don't support sleeping actors so only changes of other objects are relevant
+        void wakeUpActorsAround(const btCollisionObject& collisionObject, btCollisionWorld& collisionWorld)
+        {
+            const btBroadphaseProxy* const handle = collisionObject.getBroadphaseHandle();
+            if (handle == nullptr
+                || (handle->m_collisionFilterGroup & (CollisionType_Actor | CollisionType_Projectile)) != 0)
+                return;
+            btVector3 aabbMin;
+            btVector3 aabbMax;
+            collisionObject.getCollisionShape()->getAabb(collisionObject.getWorldTransform(), aabbMin, aabbMax);
+            // Resting actor is kept above the ground at sGroundOffset distance
+            const btVector3 margin(2 * sGroundOffset, 2 * sGroundOffset, 2 * sGroundOffset);
+            WakeUpActorsCallback callback;
+            collisionWorld.getBroadphase()->aabbTest(aabbMin - margin, aabbMax + margin, callback);
+        }
+
+        template <class F>
+        void addBusyTime(const osg::Timer& timer, double& busy, F&& f)
+        {
+            const osg::Timer_t start = timer.tick();
+            f();
+            busy += timer.delta_s(start, timer.tick());
+        }
     }
 }
 
@@ -131,6 +176,14 @@ namespace
         return actorData.mPosition.z() < actorData.mSwimLevel;
     }
 
+    // Nothing moves the actor so movement solving would only repeat the ground test
+    bool isResting(const MWPhysics::ActorFrameData& actorData)
+    {
+        return actorData.mMovement.length2() == 0 && actorData.mInertia.length2() == 0 && actorData.mIsOnGround
+            && !actorData.mIsOnSlope && !actorData.mFlying && !actorData.mSkipCollisionDetection
+            && actorData.mStuckFrames == 0 && !isUnderWater(actorData);
+    }
+
     osg::Vec3f interpolateMovements(const MWPhysics::PtrHolder& ptr, float timeAccum, float physicsDt)
     {
         const float interpolationFactor = std::clamp(timeAccum / physicsDt, 0.0f, 1.0f);
@@ -236,7 +289,11 @@ namespace
             const MWPhysics::WorldFrameData& mWorldFrameData;
             void operator()(const LockedActorSimulation& sim) const
             {
-                MWPhysics::MovementSolver::move(sim.second, mPhysicsDt, mCollisionWorld, mWorldFrameData);
+                auto& [actor, frameDataRef] = sim;
+                auto& frameData = frameDataRef.get();
+                frameData.mSleeping = actor->isSleeping() && isResting(frameData);
+                if (!frameData.mSleeping)
+                    MWPhysics::MovementSolver::move(frameData, mPhysicsDt, mCollisionWorld, mWorldFrameData);
             }
             void operator()(const LockedProjectileSimulation& sim) const
             {
@@ -272,7 +329,8 @@ namespace
                 actor->setSimulationPosition(::interpolateMovements(*actor, mTimeAccum, mPhysicsDt));
                 actor->setLastStuckPosition(frameData.mLastStuckPosition);
                 actor->setStuckFrames(frameData.mStuckFrames);
-                if (mAdvanceSimulation)
+                // Sleeping actor keeps the state from the frame it was simulated last time
+                if (mAdvanceSimulation && !frameData.mSleeping)
                 {
                     MWWorld::Ptr standingOn;
                     if (frameData.mStandingOn != nullptr)
@@ -291,6 +349,9 @@ namespace
                     actor->setWalkingOnWater(frameData.mWalkingOnWater);
                     actor->setInertialForce(frameData.mInertia);
                 }
+                if (mAdvanceSimulation)
+                    actor->updateSleepState(isResting(frameData) && !actor->isWalkingOnWater()
+                        && actor->getPosition() == actor->getPreviousPosition());
             }
             void operator()(MWPhysics::ProjectileSimulation& sim) const
             {
@@ -374,14 +435,54 @@ namespace MWPhysics
             mWorkersDone.notify_all();
         }
 
+        void runBatch(std::size_t count, const std::function<void(std::size_t)>& query)
+        {
+            std::atomic<std::size_t> next = 0;
+            const std::function<void()> process = [&] {
+                std::size_t i = 0;
+                while ((i = next.fetch_add(1, std::memory_order_relaxed)) < count)
+                    query(i);
+            };
+
+            {
+                const std::lock_guard lock(mHasJobMutex);
+                mBatch = &process;
+                ++mBatchCounter;
+                mHasJob.notify_all();
+            }
+
+            process();
+
+            std::unique_lock lock(mHasJobMutex);
+            mBatch = nullptr;
+            mBatchDone.wait(lock, [&] { return mBatchHelpers == 0; });
+        }
+
         template <class F>
         void runWorker(F&& f) noexcept
         {
             std::size_t lastFrame = 0;
+            std::size_t lastBatch = 0;
             std::unique_lock lock(mHasJobMutex);
             while (!mShouldStop)
             {
-                mHasJob.wait(lock, [&] { return mShouldStop || mFrameCounter != lastFrame; });
+                mHasJob.wait(lock,
+                    [&] { return mShouldStop || mFrameCounter != lastFrame || mBatchCounter != lastBatch; });
+                // Simulation has priority because other workers may wait for this one on a barrier
+                if (!mShouldStop && mFrameCounter == lastFrame)
+                {
+                    lastBatch = mBatchCounter;
+                    if (mBatch == nullptr)
+                        continue;
+                    const std::function<void()>* const batch = mBatch;
+                    ++mBatchHelpers;
+                    lock.unlock();
+                    (*batch)();
+                    lock.lock();
+                    if (--mBatchHelpers == 0)
+                        mBatchDone.notify_all();
+                    continue;
+                }
                 lastFrame = mFrameCounter;
                 lock.unlock();
                 f();
@@ -396,15 +497,20 @@ namespace MWPhysics
         std::condition_variable mHasJob;
         bool mShouldStop = false;
         std::size_t mFrameCounter = 0;
+        const std::function<void()>* mBatch = nullptr;
+        std::size_t mBatchCounter = 0;
+        std::size_t mBatchHelpers = 0;
+        std::condition_variable mBatchDone;
         std::mutex mHasJobMutex;
     };
 
     PhysicsTaskScheduler::PhysicsTaskScheduler(
-        float physicsDt, btCollisionWorld* collisionWorld, MWRender::DebugDrawer* debugDrawer)
+        float physicsDt, btCollisionWorld* collisionWorld, Broadphase* broadphase, MWRender::DebugDrawer* debugDrawer)
         : mDefaultPhysicsDt(physicsDt)
         , mPhysicsDt(physicsDt)
         , mTimeAccum(0.f)
         , mCollisionWorld(collisionWorld)
+        , mBroadphase(broadphase)
         , mDebugDrawer(debugDrawer)
         , mLockingPolicy(detectLockingPolicy())
         , mNumThreads(getNumThreads(mLockingPolicy))
@@ -412,6 +518,9 @@ namespace MWPhysics
         , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::physics().mLineofsightKeepInactiveCache)
         , mAdvanceSimulation(false)
+        , mLOSCacheGeneration(0)
+        , mLOSCacheGet(0)
+        , mLOSCacheHit(0)
         , mNextJob(0)
         , mNextLOS(0)
         , mFrameNumber(0)
@@ -424,19 +533,37 @@ namespace MWPhysics
         , mTimeBegin(0)
         , mTimeEnd(0)
         , mFrameStart(0)
+        , mWorkersBusy(0)
+        , mWorkersIdle(0)
+        , mWorkersMaxBusy(0)
         , mWorkersSync(mNumThreads >= 1 ? std::make_unique<WorkersSync>() : nullptr)
     {
         if (mNumThreads >= 1)
         {
             Log(Debug::Info) << "Using " << mNumThreads << " async physics threads";
+            mWorkerTimes.resize(mNumThreads);
             for (unsigned i = 0; i < mNumThreads; ++i)
-                mThreads.emplace_back([&] { worker(); });
+                mThreads.emplace_back([this, i] { worker(i); });
         }
         else
         {
+            mWorkerTimes.resize(1);
             mLOSCacheExpiry = 0;
         }
 
+        if (const char* path = std::getenv("OPENMW_PHYSICS_RECORDING"))
+        {
+            try
+            {
+                mRecorder = std::make_unique<SimulationRecorder>(path);
+                Log(Debug::Warning) << "Warning: recording physics simulation into \"" << path << "\"";
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Warning: physics simulation is not recorded: " << e.what();
+            }
+        }
+
         mPreStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
 
         mPostStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
@@ -535,6 +662,11 @@ namespace MWPhysics
             updateStats(frameStart, frameNumber, stats);
         }
 
+        {
+            MaybeExclusiveLock collisionWorldLock(mCollisionWorldMutex, mLockingPolicy);
+            mBroadphase->update(mCollisionWorld->getDispatcher());
+        }
+
         auto [numSteps, newDelta] = calculateStepConfig(timeAccum);
         timeAccum -= numSteps * newDelta;
 
@@ -551,18 +683,22 @@ namespace MWPhysics
         mSimulations = &simulations;
         mAdvanceSimulation = (mRemainingSteps != 0);
         mNumJobs = static_cast<int>(mSimulations->size());
+        orderJobs();
         mNextLOS.store(0, std::memory_order_relaxed);
         mNextJob.store(0, std::memory_order_release);
 
         if (mAdvanceSimulation)
             mWorldFrameData = std::make_unique<WorldFrameData>();
 
+        if (mRecorder != nullptr && mAdvanceSimulation)
+            mRecorder->beginFrame(numSteps, newDelta, *mWorldFrameData, simulations);
+
         if (mAdvanceSimulation)
             mBudgetCursor += 1;
 
         if (mNumThreads == 0)
         {
-            doSimulation();
+            doSimulation(0);
             syncWithMainThread();
             if (mAdvanceSimulation)
                 mBudget.update(mTimer->delta_s(timeStart, mTimer->tick()), numSteps, mBudgetCursor);
@@ -592,18 +728,11 @@ namespace MWPhysics
         }
     }
 
-    void PhysicsTaskScheduler::rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld,
-        btCollisionWorld::RayResultCallback& resultCallback) const
-    {
-        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
-        mCollisionWorld->rayTest(rayFromWorld, rayToWorld, resultCallback);
-    }
-
-    void PhysicsTaskScheduler::convexSweepTest(const btConvexShape* castShape, const btTransform& from,
-        const btTransform& to, btCollisionWorld::ConvexResultCallback& resultCallback) const
+    RayCastingResult PhysicsTaskScheduler::castRay(const RayCastingRequest& request,
+        std::span<const btCollisionObject*> ignore, std::span<const btCollisionObject*> targets) const
     {
         MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
-        mCollisionWorld->convexSweepTest(castShape, from, to, resultCallback);
+        return MWPhysics::castRay(*mCollisionWorld, request, ignore, targets);
     }
 
     void PhysicsTaskScheduler::contactTest(
@@ -613,6 +742,32 @@ namespace MWPhysics
         ContactTestWrapper::contactTest(mCollisionWorld, colObj, resultCallback);
     }
 
+    void PhysicsTaskScheduler::queryBatch(std::size_t count, const std::function<void(std::size_t)>& query)
+    {
+        MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+        // Concurrent queries are possible only when Bullet is built with multithreading support
+        if (mLockingPolicy != LockingPolicy::AllowSharedLocks || mWorkersSync == nullptr || count < 2)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                query(i);
+            return;
+        }
+        mWorkersSync->runBatch(count, query);
+    }
+
+    void PhysicsTaskScheduler::updateBatch(std::size_t count, const std::function<void(std::size_t)>& update)
+    {
+        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        // Updates don't access the collision world so Bullet multithreading support is not required
+        if (mWorkersSync == nullptr || count < 2)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                update(i);
+            return;
+        }
+        mWorkersSync->runBatch(count, update);
+    }
+
     std::optional<btVector3> PhysicsTaskScheduler::getHitPoint(const btTransform& from, btCollisionObject* target)
     {
         MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
@@ -648,6 +803,9 @@ namespace MWPhysics
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
         collisionObject->getBroadphaseHandle()->m_collisionFilterMask = collisionFilterMask;
+        wakeUpActorsAround(*collisionObject, *mCollisionWorld);
+        if (mRecorder != nullptr)
+            mRecorder->updateObject(*collisionObject);
     }
 
     void PhysicsTaskScheduler::addCollisionObject(
@@ -656,13 +814,19 @@ namespace MWPhysics
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
         mCollisionObjects.insert(collisionObject);
         mCollisionWorld->addCollisionObject(collisionObject, collisionFilterGroup, collisionFilterMask);
+        wakeUpActorsAround(*collisionObject, *mCollisionWorld);
+        if (mRecorder != nullptr)
+            mRecorder->addObject(*collisionObject);
     }
 
     void PhysicsTaskScheduler::removeCollisionObject(btCollisionObject* collisionObject)
     {
         MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
         mCollisionObjects.erase(collisionObject);
+        wakeUpActorsAround(*collisionObject, *mCollisionWorld);
         mCollisionWorld->removeCollisionObject(collisionObject);
+        if (mRecorder != nullptr)
+            mRecorder->removeObject(*collisionObject);
     }
 
     void PhysicsTaskScheduler::updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate)
@@ -683,16 +847,28 @@ namespace MWPhysics
     {
         MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
 
+        ++mLOSCacheGet;
         auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+        req.mLastUsed = mLOSCacheGeneration;
+        const auto it = mLOSCacheIndex.find(req.mRawActors);
+        if (it == mLOSCacheIndex.end())
+        {
+            req.mResult = hasLineOfSight(actor1.get(), actor2.get());
+            mLOSCacheIndex.emplace(req.mRawActors, mLOSCache.size());
+            mLOSCache.push_back(std::move(req));
+            return mLOSCache.back().mResult;
+        }
+        LOSRequest& cached = mLOSCache[it->second];
+        // Expired actor means the key is reused by a new actor allocated at the same address
+        if (cached.mStale || cached.mActors[0].expired() || cached.mActors[1].expired())
         {
             req.mResult = hasLineOfSight(actor1.get(), actor2.get());
-            mLOSCache.push_back(req);
-            return req.mResult;
+            cached = std::move(req);
+            return cached.mResult;
         }
-        result->mAge = 0;
-        return result->mResult;
+        ++mLOSCacheHit;
+        cached.mLastUsed = mLOSCacheGeneration;
+        return cached.mResult;
     }
 
     void PhysicsTaskScheduler::refreshLOSCache()
@@ -706,13 +882,34 @@ namespace MWPhysics
             auto actorPtr1 = req.mActors[0].lock();
             auto actorPtr2 = req.mActors[1].lock();
 
-            if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
+            const std::size_t age = mLOSCacheGeneration - req.mLastUsed;
+            if (mLOSCacheExpiry < 0 || age > static_cast<std::size_t>(mLOSCacheExpiry) || !actorPtr1 || !actorPtr2)
                 req.mStale = true;
             else
                 req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
         }
     }
 
+    void PhysicsTaskScheduler::removeStaleLOSRequests()
+    {
+        std::size_t i = 0;
+        while (i < mLOSCache.size())
+        {
+            if (!mLOSCache[i].mStale)
+            {
+                ++i;
+                continue;
+            }
+            mLOSCacheIndex.erase(mLOSCache[i].mRawActors);
+            if (i + 1 != mLOSCache.size())
+            {
+                mLOSCache[i] = std::move(mLOSCache.back());
+                mLOSCacheIndex[mLOSCache[i].mRawActors] = i;
+            }
+            mLOSCache.pop_back();
+        }
+    }
+
     void PhysicsTaskScheduler::updateAabbs()
     {
         MaybeExclusiveLock lock(mUpdateAabbMutex, mLockingPolicy);
@@ -734,8 +931,12 @@ namespace MWPhysics
         }
         else if (const auto object = std::dynamic_pointer_cast<Object>(ptr))
         {
+            wakeUpActorsAround(*object->getCollisionObject(), *mCollisionWorld);
             object->commitPositionChange();
             mCollisionWorld->updateSingleAabb(object->getCollisionObject());
+            wakeUpActorsAround(*object->getCollisionObject(), *mCollisionWorld);
+            if (mRecorder != nullptr)
+                mRecorder->updateObject(*object->getCollisionObject());
         }
         else if (const auto projectile = std::dynamic_pointer_cast<Projectile>(ptr))
         {
@@ -744,14 +945,43 @@ namespace MWPhysics
         }
     }
 
-    void PhysicsTaskScheduler::worker()
+    void PhysicsTaskScheduler::worker(std::size_t index)
     {
-        mWorkersSync->runWorker([this] {
+        mWorkersSync->runWorker([this, index] {
             std::shared_lock lock(mSimulationMutex);
-            doSimulation();
+            doSimulation(index);
         });
     }
 
+    void PhysicsTaskScheduler::orderJobs()
+    {
+        mJobOrder.resize(mSimulations->size());
+        std::iota(mJobOrder.begin(), mJobOrder.end(), 0);
+        mJobCosts.assign(mSimulations->size(), 0);
+        if (mNumThreads < 2)
+            return;
+        // Start with the most expensive actors so the cheap ones fill the gaps at the end of each step and threads
+        // arrive at the barrier at about the same time. Simulations list is rebuilt every frame so the cost is stored
+        // in the actor.
+        for (std::size_t i = 0; i < mSimulations->size(); ++i)
+            if (auto* const sim = std::get_if<ActorSimulation>(&(*mSimulations)[i]))
+                if (const auto locked = sim->lock())
+                    mJobCosts[i] = locked->first->getSimulationCost();
+        std::stable_sort(mJobOrder.begin(), mJobOrder.end(),
+            [&](int lhs, int rhs) { return mJobCosts[lhs] > mJobCosts[rhs]; });
+        std::fill(mJobCosts.begin(), mJobCosts.end(), 0);
+    }
+
+    void PhysicsTaskScheduler::storeJobCosts()
+    {
+        if (!mAdvanceSimulation)
+            return;
+        for (std::size_t i = 0; i < mSimulations->size(); ++i)
+            if (auto* const sim = std::get_if<ActorSimulation>(&(*mSimulations)[i]))
+                if (const auto locked = sim->lock())
+                    locked->first->setSimulationCost(mJobCosts[i]);
+    }
+
     void PhysicsTaskScheduler::updateActorsPositions()
     {
         const Visitors::UpdatePosition impl{ mCollisionWorld };
@@ -778,21 +1008,41 @@ namespace MWPhysics
         return !resultCallback.hasHit();
     }
 
-    void PhysicsTaskScheduler::doSimulation()
+    void PhysicsTaskScheduler::doSimulation(std::size_t worker)
     {
+        WorkerTime& workerTime = mWorkerTimes[worker];
+        workerTime.mBegin = mTimer->tick();
+        workerTime.mBusy = 0;
+
+        if (mRemainingSteps)
+            mPreStepBarrier->wait([&] { addBusyTime(*mTimer, workerTime.mBusy, [this] { afterPreStep(); }); });
+
         while (mRemainingSteps)
         {
-            mPreStepBarrier->wait([this] { afterPreStep(); });
             int job = 0;
             const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
             const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
             while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+            {
+                const int index = mJobOrder[job];
+                const osg::Timer_t start = mTimer->tick();
+                std::visit(vis, (*mSimulations)[index]);
+                const double cost = mTimer->delta_s(start, mTimer->tick());
+                mJobCosts[index] += cost;
+                workerTime.mBusy += cost;
+            }
 
-            mPostStepBarrier->wait([this] { afterPostStep(); });
+            // Prepare the next step within the same rendezvous to save a barrier per step
+            mPostStepBarrier->wait([&] {
+                addBusyTime(*mTimer, workerTime.mBusy, [this] {
+                    afterPostStep();
+                    if (mRemainingSteps)
+                        afterPreStep();
+                });
+            });
         }
 
-        refreshLOSCache();
+        addBusyTime(*mTimer, workerTime.mBusy, [this] { refreshLOSCache(); });
         mPostSimBarrier->wait([this] { afterPostSim(); });
     }
 
@@ -805,12 +1055,31 @@ namespace MWPhysics
             stats.setAttribute(mFrameNumber, "physicsworker_time_begin", mTimer->delta_s(mFrameStart, mTimeBegin));
             stats.setAttribute(mFrameNumber, "physicsworker_time_taken", mTimer->delta_s(mTimeBegin, mTimeEnd));
             stats.setAttribute(mFrameNumber, "physicsworker_time_end", mTimer->delta_s(mFrameStart, mTimeEnd));
+            stats.setAttribute(mFrameNumber, "Physics Workers Busy us", mWorkersBusy * 1e6);
+            stats.setAttribute(mFrameNumber, "Physics Workers Idle us", mWorkersIdle * 1e6);
+            stats.setAttribute(mFrameNumber, "Physics Workers MaxBusy us", mWorkersMaxBusy * 1e6);
         }
         mFrameStart = frameStart;
         mTimeBegin = mTimer->tick();
         mFrameNumber = frameNumber;
     }
 
+    void PhysicsTaskScheduler::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
+        stats.setAttribute(frameNumber, "Physics LOS Cache Size", static_cast<double>(mLOSCache.size()));
+        stats.setAttribute(frameNumber, "Physics LOS Cache Get", static_cast<double>(mLOSCacheGet));
+        stats.setAttribute(frameNumber, "Physics LOS Cache Hit", static_cast<double>(mLOSCacheHit));
+        const BroadphaseStats& broadphaseStats = mBroadphase->getStats();
+        stats.setAttribute(
+            frameNumber, "Physics Broadphase Static", static_cast<double>(broadphaseStats.mStaticProxies));
+        stats.setAttribute(
+            frameNumber, "Physics Broadphase Dynamic", static_cast<double>(broadphaseStats.mDynamicProxies));
+        stats.setAttribute(frameNumber, "Physics Broadphase Pairs", static_cast<double>(broadphaseStats.mPairs));
+        stats.setAttribute(
+            frameNumber, "Physics Broadphase AABB Updates", static_cast<double>(broadphaseStats.mAabbUpdates));
+    }
+
     void PhysicsTaskScheduler::debugDraw()
     {
         MaybeSharedLock lock(mCollisionWorldMutex, mLockingPolicy);
@@ -863,11 +1132,19 @@ namespace MWPhysics
     {
         {
             MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
-            mLOSCache.erase(
-                std::remove_if(mLOSCache.begin(), mLOSCache.end(), [](const LOSRequest& req) { return req.mStale; }),
-                mLOSCache.end());
+            removeStaleLOSRequests();
+            ++mLOSCacheGeneration;
         }
         mTimeEnd = mTimer->tick();
+        mWorkersBusy = 0;
+        mWorkersIdle = 0;
+        mWorkersMaxBusy = 0;
+        for (const WorkerTime& workerTime : mWorkerTimes)
+        {
+            mWorkersBusy += workerTime.mBusy;
+            mWorkersIdle += std::max(0.0, mTimer->delta_s(workerTime.mBegin, mTimeEnd) - workerTime.mBusy);
+            mWorkersMaxBusy = std::max(mWorkersMaxBusy, workerTime.mBusy);
+        }
         if (mWorkersSync != nullptr)
             mWorkersSync->workIsDone();
     }
@@ -876,6 +1153,9 @@ namespace MWPhysics
     {
         if (mSimulations == nullptr)
             return;
+        if (mRecorder != nullptr && mAdvanceSimulation)
+            mRecorder->endFrame(*mSimulations);
+        storeJobCosts();
         const Visitors::Sync vis{ mAdvanceSimulation, mTimeAccum, mPhysicsDt, this };
         for (auto& sim : *mSimulations)
             std::visit(vis, sim);
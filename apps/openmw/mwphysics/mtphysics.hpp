@@ -3,11 +3,13 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <set>
 #include <shared_mutex>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
@@ -30,6 +32,9 @@ namespace MWRender
 
 namespace MWPhysics
 {
+    class Broadphase;
+    class SimulationRecorder;
+
     enum class LockingPolicy
     {
         NoLocks,
@@ -40,7 +45,8 @@ namespace MWPhysics
     class PhysicsTaskScheduler
     {
     public:
-        PhysicsTaskScheduler(float physicsDt, btCollisionWorld* collisionWorld, MWRender::DebugDrawer* debugDrawer);
+        PhysicsTaskScheduler(float physicsDt, btCollisionWorld* collisionWorld, Broadphase* broadphase,
+            MWRender::DebugDrawer* debugDrawer);
         ~PhysicsTaskScheduler();
 
         /// @brief move actors taking into account desired movements and collisions
@@ -54,11 +60,16 @@ namespace MWPhysics
         void resetSimulation(const ActorMap& actors);
 
         // Thread safe wrappers
-        void rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld,
-            btCollisionWorld::RayResultCallback& resultCallback) const;
-        void convexSweepTest(const btConvexShape* castShape, const btTransform& from, const btTransform& to,
-            btCollisionWorld::ConvexResultCallback& resultCallback) const;
+        RayCastingResult castRay(const RayCastingRequest& request, std::span<const btCollisionObject*> ignore,
+            std::span<const btCollisionObject*> targets) const;
         void contactTest(btCollisionObject* colObj, btCollisionWorld::ContactResultCallback& resultCallback);
+        /// @brief run queries while holding the collision world lock once, idle physics threads help the calling one
+        /// @param query is called once for each index in [0, count), possibly concurrently
+        void queryBatch(std::size_t count, const std::function<void(std::size_t)>& query);
+        /// @brief modify collision shapes while holding the collision world lock exclusively, idle physics threads
+        /// help the calling one
+        /// @param update is called once for each index in [0, count), possibly concurrently
+        void updateBatch(std::size_t count, const std::function<void(std::size_t)>& update);
         std::optional<btVector3> getHitPoint(const btTransform& from, btCollisionObject* target);
         void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
         void getAabb(const btCollisionObject* obj, btVector3& min, btVector3& max);
@@ -71,15 +82,25 @@ namespace MWPhysics
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
                                     // ~PhysicsTaskScheduler()
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
 
     private:
         class WorkersSync;
 
-        void doSimulation();
-        void worker();
+        struct WorkerTime
+        {
+            osg::Timer_t mBegin = 0;
+            double mBusy = 0;
+        };
+
+        void doSimulation(std::size_t worker);
+        void worker(std::size_t index);
+        void orderJobs();
+        void storeJobCosts();
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
         void refreshLOSCache();
+        void removeStaleLOSRequests();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
@@ -99,8 +120,20 @@ namespace MWPhysics
         float mPhysicsDt;
         float mTimeAccum;
         btCollisionWorld* mCollisionWorld;
+        Broadphase* mBroadphase;
         MWRender::DebugDrawer* mDebugDrawer;
+        // Dense storage is used to split refresh between threads, index is used for lookup by actors pair
         std::vector<LOSRequest> mLOSCache;
+        std::unordered_map<std::array<const Actor*, 2>, std::size_t, LOSRequestKeyHash> mLOSCacheIndex;
+        // Incremented after each simulation frame
+        std::size_t mLOSCacheGeneration;
+        std::size_t mLOSCacheGet;
+        std::size_t mLOSCacheHit;
+        // Simulations indices ordered by descending cost measured in the previous frame
+        std::vector<int> mJobOrder;
+        // Time in seconds spent on each simulation during the current frame
+        std::vector<double> mJobCosts;
+        std::vector<WorkerTime> mWorkerTimes;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
         // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
@@ -134,8 +167,12 @@ namespace MWPhysics
         osg::Timer_t mTimeBegin;
         osg::Timer_t mTimeEnd;
         osg::Timer_t mFrameStart;
+        double mWorkersBusy;
+        double mWorkersIdle;
+        double mWorkersMaxBusy;
 
         std::unique_ptr<WorkersSync> mWorkersSync;
+        std::unique_ptr<SimulationRecorder> mRecorder;
     };
 
 }
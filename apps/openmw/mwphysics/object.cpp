@@ -117,11 +117,14 @@ namespace MWPhysics
         assert(mShapeInstance->mCollisionShape->isCompound());
 
         btCompoundShape* compound = static_cast<btCompoundShape*>(mShapeInstance->mCollisionShape.get());
+        // Scaling the compound shape changes transforms of all children
+        const bool scaleChanged = !(compound->getLocalScaling() == mAnimatedScale);
+        mAnimatedScale = compound->getLocalScaling();
         bool result = false;
         for (const auto& [recordIndex, shapeIndex] : mShapeInstance->mAnimatedShapes)
         {
-            auto nodePathFound = mRecordIndexToNodePath.find(recordIndex);
-            if (nodePathFound == mRecordIndexToNodePath.end())
+            auto animatedNodeFound = mAnimatedNodes.find(recordIndex);
+            if (animatedNodeFound == mAnimatedNodes.end())
             {
                 NifOsg::FindGroupByRecordIndex visitor(recordIndex);
                 mPtr.getRefData().getBaseNode()->accept(visitor);
@@ -132,15 +135,19 @@ namespace MWPhysics
 
                     // Remove nonexistent nodes from animated shapes map and early out
                     mShapeInstance->mAnimatedShapes.erase(recordIndex);
-                    return false;
+                    break;
                 }
                 osg::NodePath nodePath = visitor.mFoundPath;
                 nodePath.erase(nodePath.begin());
-                nodePathFound = mRecordIndexToNodePath.emplace(recordIndex, nodePath).first;
+                animatedNodeFound = mAnimatedNodes.emplace(recordIndex, AnimatedNode{ .mNodePath = nodePath }).first;
             }
 
-            osg::NodePath& nodePath = nodePathFound->second;
-            osg::Matrixf matrix = osg::computeLocalToWorld(nodePath);
+            AnimatedNode& animatedNode = animatedNodeFound->second;
+            osg::Matrixf matrix = osg::computeLocalToWorld(animatedNode.mNodePath);
+            if (!scaleChanged && animatedNode.mLocalToWorld == matrix)
+                continue;
+            animatedNode.mLocalToWorld = matrix;
+
             btVector3 scale = Misc::Convert::toBullet(matrix.getScale());
             matrix.orthoNormalize(matrix);
 
@@ -161,10 +168,13 @@ namespace MWPhysics
 
             if (!(transform == compound->getChildTransform(shapeIndex)))
             {
-                compound->updateChildTransform(shapeIndex, transform);
+                // Local AABB is recalculated once for all children
+                compound->updateChildTransform(shapeIndex, transform, false);
                 result = true;
             }
         }
+        if (result)
+            compound->recalculateLocalAabb();
         return result;
     }
 
@@ -8,6 +8,7 @@
 
 #include <map>
 #include <mutex>
+#include <optional>
 
 namespace Resource
 {
@@ -43,7 +44,7 @@ namespace MWPhysics
         bool isSolid() const;
         void setSolid(bool solid);
         bool isAnimated() const;
-        /// @brief update object shape
+        /// @brief update object shape, children driven by nodes with unchanged transformation are skipped
         /// @return true if shape changed
         bool animateCollisionShapes();
         bool collidedWith(ScriptedCollisionType type) const;
@@ -51,8 +52,15 @@ namespace MWPhysics
         void resetCollisions();
 
     private:
+        struct AnimatedNode
+        {
+            osg::NodePath mNodePath;
+            std::optional<osg::Matrixf> mLocalToWorld;
+        };
+
         osg::ref_ptr<Resource::BulletShapeInstance> mShapeInstance;
-        std::map<int, osg::NodePath> mRecordIndexToNodePath;
+        std::map<int, AnimatedNode> mAnimatedNodes;
+        btVector3 mAnimatedScale{ 0, 0, 0 };
         bool mSolid;
         btVector3 mScale;
         osg::Vec3f mPosition;
@@ -8,12 +8,10 @@
 #include <osg/Stats>
 #include <osg/Timer>
 
-#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <BulletCollision/CollisionShapes/btConeShape.h>
-#include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
 
 #include <LinearMath/btQuickprof.h>
@@ -23,6 +21,7 @@
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadmgef.hpp>
 #include <components/misc/convert.hpp>
+#include <components/misc/hash.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/resource/bulletshapemanager.hpp>
@@ -45,9 +44,9 @@
 #include "../mwworld/class.hpp"
 
 #include "actor.hpp"
+#include "broadphase.hpp"
 #include "collisiontype.hpp"
 
-#include "closestnotmerayresultcallback.hpp"
 #include "contacttestresultcallback.hpp"
 #include "hasspherecollisioncallback.hpp"
 #include "heightfield.hpp"
@@ -55,6 +54,7 @@
 #include "mtphysics.hpp"
 #include "object.hpp"
 #include "projectile.hpp"
+#include "simulationrecording.hpp"
 
 namespace
 {
@@ -87,7 +87,6 @@ namespace
         }
         ptr.getClass().getMovementSettings(ptr).mPosition[2] = 0;
     }
-
 }
 
 namespace MWPhysics
@@ -109,7 +108,7 @@ namespace MWPhysics
 
         mCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
         mDispatcher = std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get());
-        mBroadphase = std::make_unique<btDbvtBroadphase>();
+        mBroadphase = std::make_unique<Broadphase>(Settings::physics().mSplitStaticBroadphase);
 
         mCollisionWorld
             = std::make_unique<btCollisionWorld>(mDispatcher.get(), mBroadphase.get(), mCollisionConfiguration.get());
@@ -131,7 +130,8 @@ namespace MWPhysics
         }
 
         mDebugDrawer = std::make_unique<MWRender::DebugDrawer>(mParentNode, mCollisionWorld.get(), mDebugDrawEnabled);
-        mTaskScheduler = std::make_unique<PhysicsTaskScheduler>(mPhysicsDt, mCollisionWorld.get(), mDebugDrawer.get());
+        mTaskScheduler = std::make_unique<PhysicsTaskScheduler>(
+            mPhysicsDt, mCollisionWorld.get(), mBroadphase.get(), mDebugDrawer.get());
     }
 
     PhysicsSystem::~PhysicsSystem()
@@ -195,34 +195,9 @@ namespace MWPhysics
         const std::vector<MWWorld::ConstPtr>& ignore, const std::vector<MWWorld::Ptr>& targets, int mask,
         int group) const
     {
-        if (from == to)
-        {
-            RayCastingResult result;
-            result.mHit = false;
-            return result;
-        }
-        btVector3 btFrom = Misc::Convert::toBullet(from);
-        btVector3 btTo = Misc::Convert::toBullet(to);
-
-        std::vector<const btCollisionObject*> ignoreList;
+        std::vector<const btCollisionObject*> ignoreList = getCollisionObjects(ignore);
         std::vector<const btCollisionObject*> targetCollisionObjects;
 
-        for (const auto& ptr : ignore)
-        {
-            if (!ptr.isEmpty())
-            {
-                const Actor* actor = getActor(ptr);
-                if (actor)
-                    ignoreList.push_back(actor->getCollisionObject());
-                else
-                {
-                    const Object* object = getObject(ptr);
-                    if (object)
-                        ignoreList.push_back(object->getCollisionObject());
-                }
-            }
-        }
-
         if (!targets.empty())
         {
             for (const MWWorld::Ptr& target : targets)
@@ -233,46 +208,46 @@ namespace MWPhysics
             }
         }
 
-        ClosestNotMeRayResultCallback resultCallback(ignoreList, targetCollisionObjects, btFrom, btTo);
-        resultCallback.m_collisionFilterGroup = group;
-        resultCallback.m_collisionFilterMask = mask;
-
-        mTaskScheduler->rayTest(btFrom, btTo, resultCallback);
-
-        RayCastingResult result;
-        result.mHit = resultCallback.hasHit();
-        if (resultCallback.hasHit())
-        {
-            result.mHitPos = Misc::Convert::toOsg(resultCallback.m_hitPointWorld);
-            result.mHitNormal = Misc::Convert::toOsg(resultCallback.m_hitNormalWorld);
-            if (PtrHolder* ptrHolder = static_cast<PtrHolder*>(resultCallback.m_collisionObject->getUserPointer()))
-                result.mHitObject = ptrHolder->getPtr();
-        }
-        return result;
+        const RayCastingRequest request{ .mFrom = from, .mTo = to, .mMask = mask, .mGroup = group };
+        return mTaskScheduler->castRay(request, ignoreList, targetCollisionObjects);
     }
 
     RayCastingResult PhysicsSystem::castSphere(
         const osg::Vec3f& from, const osg::Vec3f& to, float radius, int mask, int group) const
     {
-        btCollisionWorld::ClosestConvexResultCallback callback(
-            Misc::Convert::toBullet(from), Misc::Convert::toBullet(to));
-        callback.m_collisionFilterGroup = group;
-        callback.m_collisionFilterMask = mask;
+        const RayCastingRequest request{ .mFrom = from, .mTo = to, .mRadius = radius, .mMask = mask, .mGroup = group };
+        return mTaskScheduler->castRay(request, {}, {});
+    }
+
+    std::vector<RayCastingResult> PhysicsSystem::castRays(std::span<const RayCastingRequest> requests) const
+    {
+        // Object maps are not thread safe so resolve ignored objects before the parallel part
+        std::vector<std::vector<const btCollisionObject*>> ignoreLists;
+        ignoreLists.reserve(requests.size());
+        for (const RayCastingRequest& request : requests)
+            ignoreLists.push_back(getCollisionObjects(request.mIgnore));
 
-        btSphereShape shape(radius);
-        const btQuaternion btrot = btQuaternion::getIdentity();
+        std::vector<RayCastingResult> results(requests.size());
 
-        mTaskScheduler->convexSweepTest(&shape, btTransform(btrot, Misc::Convert::toBullet(from)),
-            btTransform(btrot, Misc::Convert::toBullet(to)), callback);
+        mTaskScheduler->queryBatch(requests.size(), [&](std::size_t i) {
+            results[i] = MWPhysics::castRay(*mCollisionWorld, requests[i], ignoreLists[i], {});
+        });
+
+        return results;
+    }
 
-        RayCastingResult result;
-        result.mHit = callback.hasHit();
-        if (result.mHit)
+    std::vector<const btCollisionObject*> PhysicsSystem::getCollisionObjects(
+        std::span<const MWWorld::ConstPtr> ptrs) const
+    {
+        std::vector<const btCollisionObject*> result;
+        for (const auto& ptr : ptrs)
         {
-            result.mHitPos = Misc::Convert::toOsg(callback.m_hitPointWorld);
-            result.mHitNormal = Misc::Convert::toOsg(callback.m_hitNormalWorld);
-            if (auto* ptrHolder = static_cast<PtrHolder*>(callback.m_hitCollisionObject->getUserPointer()))
-                result.mHitObject = ptrHolder->getPtr();
+            if (ptr.isEmpty())
+                continue;
+            if (const Actor* actor = getActor(ptr))
+                result.push_back(actor->getCollisionObject());
+            else if (const Object* object = getObject(ptr))
+                result.push_back(object->getCollisionObject());
         }
         return result;
     }
@@ -695,19 +670,23 @@ namespace MWPhysics
     void PhysicsSystem::stepSimulation(
         float dt, bool skipSimulation, osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
     {
-        for (auto& [animatedObject, changed] : mAnimatedObjects)
-        {
-            if (animatedObject->animateCollisionShapes())
-            {
-                auto obj = mObjects.find(animatedObject->getPtr().mRef);
-                assert(obj != mObjects.end());
-                mTaskScheduler->updateSingleAabb(obj->second);
-                changed = true;
-            }
-            else
-            {
-                changed = false;
-            }
+        mAnimatedObjectsToUpdate.clear();
+        for (auto& animatedObject : mAnimatedObjects)
+            mAnimatedObjectsToUpdate.push_back(&animatedObject);
+        // Objects have independent shapes so they can be animated concurrently
+        mTaskScheduler->updateBatch(mAnimatedObjectsToUpdate.size(), [&](std::size_t i) {
+            auto& [animatedObject, changed] = *mAnimatedObjectsToUpdate[i];
+            changed = animatedObject->animateCollisionShapes();
+        });
+        mAnimatedObjectsUpdated = 0;
+        for (const auto& [animatedObject, changed] : mAnimatedObjects)
+        {
+            if (!changed)
+                continue;
+            auto obj = mObjects.find(animatedObject->getPtr().mRef);
+            assert(obj != mObjects.end());
+            mTaskScheduler->updateSingleAabb(obj->second);
+            ++mAnimatedObjectsUpdated;
         }
         for (auto& [_, object] : mObjects)
             object->resetCollisions();
@@ -869,6 +848,11 @@ namespace MWPhysics
         stats.setAttribute(frameNumber, "Physics Objects", static_cast<double>(mObjects.size()));
         stats.setAttribute(frameNumber, "Physics Projectiles", static_cast<double>(mProjectiles.size()));
         stats.setAttribute(frameNumber, "Physics HeightFields", static_cast<double>(mHeightFields.size()));
+        const auto isSleeping = [](const auto& v) { return v.second->isSleeping(); };
+        stats.setAttribute(frameNumber, "Physics Actors Sleeping",
+            static_cast<double>(std::count_if(mActors.begin(), mActors.end(), isSleeping)));
+        stats.setAttribute(frameNumber, "Physics Animated Updated", static_cast<double>(mAnimatedObjectsUpdated));
+        mTaskScheduler->reportStats(frameNumber, stats);
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
@@ -906,6 +890,35 @@ namespace MWPhysics
         , mWaterCollision(waterCollision)
         , mSkipCollisionDetection(!actor.getCollisionMode())
         , mIsPlayer(isPlayer)
+        , mSleeping(false)
+    {
+    }
+
+    ActorFrameData::ActorFrameData(const RecordedActor& actor, btCollisionObject* collisionObject)
+        : mPosition(actor.mPosition)
+        , mInertia(actor.mInertia)
+        , mStandingOn(nullptr)
+        , mIsOnGround(actor.mIsOnGround)
+        , mIsOnSlope(actor.mIsOnSlope)
+        , mWalkingOnWater(false)
+        , mInert(actor.mInert)
+        , mCollisionObject(collisionObject)
+        , mSwimLevel(actor.mSwimLevel)
+        , mSlowFall(actor.mSlowFall)
+        , mRotation(actor.mRotation)
+        , mMovement(actor.mMovement)
+        , mLastStuckPosition(actor.mLastStuckPosition)
+        , mWaterlevel(actor.mWaterlevel)
+        , mHalfExtentsZ(actor.mHalfExtentsZ)
+        , mOldHeight(actor.mOldHeight)
+        , mStuckFrames(actor.mStuckFrames)
+        , mFlying(actor.mFlying)
+        , mWasOnGround(actor.mWasOnGround)
+        , mIsAquatic(actor.mIsAquatic)
+        , mWaterCollision(actor.mWaterCollision)
+        , mSkipCollisionDetection(actor.mSkipCollisionDetection)
+        , mIsPlayer(actor.mIsPlayer)
+        , mSleeping(false)
     {
     }
 
@@ -924,10 +937,16 @@ namespace MWPhysics
     {
     }
 
+    WorldFrameData::WorldFrameData(bool isInStorm, const osg::Vec3f& stormDirection)
+        : mIsInStorm(isInStorm)
+        , mStormDirection(stormDirection)
+    {
+    }
+
     LOSRequest::LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2)
         : mResult(false)
         , mStale(false)
-        , mAge(0)
+        , mLastUsed(0)
     {
         // we use raw actor pointer pair to uniquely identify request
         // sort the pointer value in ascending order to not duplicate equivalent requests, eg. getLOS(A, B) and
@@ -951,4 +970,12 @@ namespace MWPhysics
     {
         return lhs.mRawActors == rhs.mRawActors;
     }
+
+    std::size_t LOSRequestKeyHash::operator()(const std::array<const Actor*, 2>& value) const noexcept
+    {
+        std::size_t result = 0;
+        Misc::hashCombine(result, value[0]);
+        Misc::hashCombine(result, value[1]);
+        return result;
+    }
 }
@@ -42,7 +42,6 @@ namespace Resource
 }
 
 class btCollisionWorld;
-class btBroadphaseInterface;
 class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 class btCollisionObject;
@@ -54,8 +53,10 @@ namespace MWPhysics
     class HeightField;
     class Object;
     class Actor;
+    class Broadphase;
     class PhysicsTaskScheduler;
     class Projectile;
+    struct RecordedActor;
     enum ScriptedCollisionType : char;
 
     using ActorMap = std::unordered_map<const MWWorld::LiveCellRefBase*, std::shared_ptr<Actor>>;
@@ -74,13 +75,20 @@ namespace MWPhysics
         std::array<const Actor*, 2> mRawActors;
         bool mResult;
         bool mStale;
-        int mAge;
+        // Value of the LOS cache generation when the result was requested last time
+        std::size_t mLastUsed;
     };
     bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept;
 
+    struct LOSRequestKeyHash
+    {
+        std::size_t operator()(const std::array<const Actor*, 2>& value) const noexcept;
+    };
+
     struct ActorFrameData
     {
         ActorFrameData(Actor& actor, bool inert, bool waterCollision, float slowFall, float waterlevel, bool isPlayer);
+        ActorFrameData(const RecordedActor& actor, btCollisionObject* collisionObject);
         osg::Vec3f mPosition;
         osg::Vec3f mInertia;
         const btCollisionObject* mStandingOn;
@@ -104,6 +112,8 @@ namespace MWPhysics
         const bool mWaterCollision;
         const bool mSkipCollisionDetection;
         const bool mIsPlayer;
+        // Movement solving was skipped for the last step because the actor is sleeping
+        bool mSleeping;
     };
 
     struct ProjectileFrameData
@@ -119,6 +129,7 @@ namespace MWPhysics
     struct WorldFrameData
     {
         WorldFrameData();
+        WorldFrameData(bool isInStorm, const osg::Vec3f& stormDirection);
         bool mIsInStorm;
         osg::Vec3f mStormDirection;
     };
@@ -219,6 +230,8 @@ namespace MWPhysics
         RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const override;
 
+        std::vector<RayCastingResult> castRays(std::span<const RayCastingRequest> requests) const override;
+
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
@@ -292,9 +305,11 @@ namespace MWPhysics
     private:
         void updateWater();
 
+        std::vector<const btCollisionObject*> getCollisionObjects(std::span<const MWWorld::ConstPtr> ptrs) const;
+
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
-        std::unique_ptr<btBroadphaseInterface> mBroadphase;
+        std::unique_ptr<Broadphase> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
         std::unique_ptr<btCollisionWorld> mCollisionWorld;
@@ -307,6 +322,8 @@ namespace MWPhysics
         ObjectMap mObjects;
 
         std::map<Object*, bool> mAnimatedObjects; // stores pointers to elements in mObjects
+        std::vector<std::pair<Object* const, bool>*> mAnimatedObjectsToUpdate;
+        std::size_t mAnimatedObjectsUpdated = 0;
 
         ActorMap mActors;
 
@@ -0,0 +1,67 @@
+#include "raycasting.hpp"
+
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+
+#include <components/misc/convert.hpp>
+
+#include "closestnotmerayresultcallback.hpp"
+#include "ptrholder.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        RayCastingResult makeRayCastingResult(
+            const btVector3& position, const btVector3& normal, const btCollisionObject& object)
+        {
+            RayCastingResult result;
+            result.mHit = true;
+            result.mHitPos = Misc::Convert::toOsg(position);
+            result.mHitNormal = Misc::Convert::toOsg(normal);
+            if (auto* ptrHolder = static_cast<PtrHolder*>(object.getUserPointer()))
+                result.mHitObject = ptrHolder->getPtr();
+            return result;
+        }
+    }
+
+    RayCastingResult castRay(const btCollisionWorld& world, const RayCastingRequest& request,
+        std::span<const btCollisionObject*> ignore, std::span<const btCollisionObject*> targets)
+    {
+        const btVector3 from = Misc::Convert::toBullet(request.mFrom);
+        const btVector3 to = Misc::Convert::toBullet(request.mTo);
+
+        if (request.mRadius > 0)
+        {
+            btCollisionWorld::ClosestConvexResultCallback callback(from, to);
+            callback.m_collisionFilterGroup = request.mGroup;
+            callback.m_collisionFilterMask = request.mMask;
+
+            const btSphereShape shape(request.mRadius);
+            const btQuaternion rotation = btQuaternion::getIdentity();
+
+            world.convexSweepTest(&shape, btTransform(rotation, from), btTransform(rotation, to), callback);
+
+            if (callback.hasHit())
+                return makeRayCastingResult(
+                    callback.m_hitPointWorld, callback.m_hitNormalWorld, *callback.m_hitCollisionObject);
+        }
+        else if (request.mFrom != request.mTo)
+        {
+            ClosestNotMeRayResultCallback callback(ignore, targets, from, to);
+            callback.m_collisionFilterGroup = request.mGroup;
+            callback.m_collisionFilterMask = request.mMask;
+
+            world.rayTest(from, to, callback);
+
+            if (callback.hasHit())
+                return makeRayCastingResult(
+                    callback.m_hitPointWorld, callback.m_hitNormalWorld, *callback.m_collisionObject);
+        }
+
+        RayCastingResult result;
+        result.mHit = false;
+        return result;
+    }
+}
@@ -3,10 +3,16 @@
 
 #include <osg/Vec3f>
 
+#include <span>
+#include <vector>
+
 #include "../mwworld/ptr.hpp"
 
 #include "collisiontype.hpp"
 
+class btCollisionObject;
+class btCollisionWorld;
+
 namespace MWPhysics
 {
     class RayCastingResult
@@ -18,6 +24,18 @@ namespace MWPhysics
         MWWorld::Ptr mHitObject;
     };
 
+    struct RayCastingRequest
+    {
+        osg::Vec3f mFrom;
+        osg::Vec3f mTo;
+        // Sphere of the given radius is swept instead of casting a ray when not zero
+        float mRadius = 0;
+        // Ignored when mRadius is not zero
+        std::vector<MWWorld::ConstPtr> mIgnore;
+        int mMask = CollisionType_Default;
+        int mGroup = 0xff;
+    };
+
     class RayCastingInterface
     {
     public:
@@ -37,9 +55,18 @@ namespace MWPhysics
         virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const = 0;
 
+        /// Results are in the same order as requests. Requests may be processed concurrently by physics threads.
+        virtual std::vector<RayCastingResult> castRays(std::span<const RayCastingRequest> requests) const = 0;
+
         /// Return true if actor1 can see actor2.
         virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
     };
+
+    /// Casts the request against the world without locking it. Used for both single and batched casts so they
+    /// give the same results. Request mIgnore is not used, ignored objects have to be resolved by the caller.
+    /// Rays hit only targets among actors when targets are not empty.
+    RayCastingResult castRay(const btCollisionWorld& world, const RayCastingRequest& request,
+        std::span<const btCollisionObject*> ignore, std::span<const btCollisionObject*> targets);
 }
 
 #endif
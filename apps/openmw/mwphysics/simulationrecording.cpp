@@ -0,0 +1,408 @@
+#include "simulationrecording.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btBroadphaseProxy.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btConcaveShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/convert.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <variant>
+
+#include "actor.hpp"
+#include "collisiontype.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        constexpr char recordingMagic[] = { 'p', 'h', 'r', 'c' };
+        constexpr std::uint32_t recordingVersion = 2;
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, osg::Vec2f>
+                    || std::is_same_v<std::decay_t<T>, osg::Vec3f>>
+            {
+                visitor(*this, value.ptr(), std::decay_t<T>::num_components);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, osg::Quat>>
+            {
+                visitor(*this, value._v);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, RecordedObject>>
+            {
+                visitor(*this, value.mId);
+                visitor(*this, value.mCollisionGroup);
+                visitor(*this, value.mCollisionMask);
+                visitor(*this, value.mTriangles);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, RecordedActor>>
+            {
+                visitor(*this, value.mId);
+                visitor(*this, value.mShape);
+                visitor(*this, value.mHalfExtents);
+                visitor(*this, value.mMargin);
+                visitor(*this, value.mCollisionObjectPosition);
+                visitor(*this, value.mCollisionObjectRotation);
+                visitor(*this, value.mCollisionGroup);
+                visitor(*this, value.mCollisionMask);
+                visitor(*this, value.mPosition);
+                visitor(*this, value.mInertia);
+                visitor(*this, value.mIsOnGround);
+                visitor(*this, value.mIsOnSlope);
+                visitor(*this, value.mInert);
+                visitor(*this, value.mSwimLevel);
+                visitor(*this, value.mSlowFall);
+                visitor(*this, value.mRotation);
+                visitor(*this, value.mMovement);
+                visitor(*this, value.mLastStuckPosition);
+                visitor(*this, value.mWaterlevel);
+                visitor(*this, value.mHalfExtentsZ);
+                visitor(*this, value.mOldHeight);
+                visitor(*this, value.mStuckFrames);
+                visitor(*this, value.mFlying);
+                visitor(*this, value.mWasOnGround);
+                visitor(*this, value.mIsAquatic);
+                visitor(*this, value.mWaterCollision);
+                visitor(*this, value.mSkipCollisionDetection);
+                visitor(*this, value.mIsPlayer);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, RecordedFrame>>
+            {
+                visitor(*this, value.mSteps);
+                visitor(*this, value.mPhysicsDt);
+                visitor(*this, value.mIsInStorm);
+                visitor(*this, value.mStormDirection);
+                visitor(*this, value.mResetWorld);
+                visitor(*this, value.mWorld);
+                visitor(*this, value.mRemovedObjects);
+                visitor(*this, value.mActors);
+                visitor(*this, value.mResultPositions);
+            }
+        };
+
+        struct TriangleCollector final : btTriangleCallback
+        {
+            const btTransform& mTransform;
+            std::vector<osg::Vec3f>& mTriangles;
+
+            explicit TriangleCollector(const btTransform& transform, std::vector<osg::Vec3f>& triangles)
+                : mTransform(transform)
+                , mTriangles(triangles)
+            {
+            }
+
+            void processTriangle(btVector3* triangle, int /*partId*/, int /*triangleIndex*/) override
+            {
+                for (int i = 0; i < 3; ++i)
+                    mTriangles.push_back(Misc::Convert::makeOsgVec3f(mTransform(triangle[i])));
+            }
+        };
+
+        bool isRecordedObject(const btCollisionObject& object)
+        {
+            const btBroadphaseProxy* const proxy = object.getBroadphaseHandle();
+            // Simulated actors are recorded per frame
+            return proxy != nullptr
+                && (proxy->m_collisionFilterGroup & (CollisionType_Actor | CollisionType_Projectile)) == 0;
+        }
+
+        template <class T>
+        void writeValue(std::ofstream& stream, const T& value)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            sizeAccumulator(format, value);
+            std::vector<std::byte> data(sizeAccumulator.value());
+            Serialization::BinaryWriter writer(data.data(), data.data() + data.size());
+            writer(format, value);
+            stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+
+        template <class T>
+        const std::byte* readValue(const std::byte* begin, const std::byte* end, T& value)
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            Serialization::BinaryReader reader(begin, end);
+            reader(format, value);
+            Serialization::SizeAccumulator sizeAccumulator;
+            sizeAccumulator(format, value);
+            return begin + sizeAccumulator.value();
+        }
+    }
+
+    bool collectTriangles(
+        const btCollisionShape& shape, const btTransform& transform, std::vector<osg::Vec3f>& triangles)
+    {
+        if (shape.isCompound())
+        {
+            const btCompoundShape& compound = static_cast<const btCompoundShape&>(shape);
+            bool result = true;
+            for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                result = collectTriangles(
+                             *compound.getChildShape(i), transform * compound.getChildTransform(i), triangles)
+                    && result;
+            return result;
+        }
+
+        if (shape.isConcave())
+        {
+            // Big enough to cover any worldspace, infinite planes are cut by these bounds
+            const btVector3 aabbMax(1e6, 1e6, 1e6);
+            TriangleCollector collector(transform, triangles);
+            static_cast<const btConcaveShape&>(shape).processAllTriangles(&collector, -aabbMax, aabbMax);
+            return true;
+        }
+
+        if (shape.getShapeType() == BOX_SHAPE_PROXYTYPE)
+        {
+            static constexpr int indices[] = { 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6,
+                0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3 };
+            const btBoxShape& box = static_cast<const btBoxShape&>(shape);
+            for (const int index : indices)
+            {
+                btVector3 vertex;
+                box.getVertex(index, vertex);
+                triangles.push_back(Misc::Convert::makeOsgVec3f(transform(vertex)));
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    RecordedActor recordActor(std::uint32_t id, const Actor& actor, const ActorFrameData& frameData)
+    {
+        const btCollisionObject& object = *actor.getCollisionObject();
+        const btConvexInternalShape& shape = static_cast<const btConvexInternalShape&>(*object.getCollisionShape());
+        const btTransform& transform = object.getWorldTransform();
+        const btBroadphaseProxy* const proxy = object.getBroadphaseHandle();
+
+        return RecordedActor{
+            .mId = id,
+            .mShape = shape.getShapeType() == BOX_SHAPE_PROXYTYPE ? RecordedActorShape::Box
+                                                                  : RecordedActorShape::Cylinder,
+            .mHalfExtents = Misc::Convert::makeOsgVec3f(shape.getImplicitShapeDimensions())
+                + osg::Vec3f(shape.getMargin(), shape.getMargin(), shape.getMargin()),
+            .mMargin = shape.getMargin(),
+            .mCollisionObjectPosition = Misc::Convert::makeOsgVec3f(transform.getOrigin()),
+            .mCollisionObjectRotation = Misc::Convert::toOsg(transform.getRotation()),
+            .mCollisionGroup = proxy == nullptr ? 0 : proxy->m_collisionFilterGroup,
+            .mCollisionMask = proxy == nullptr ? 0 : proxy->m_collisionFilterMask,
+            .mPosition = frameData.mPosition,
+            .mInertia = frameData.mInertia,
+            .mIsOnGround = frameData.mIsOnGround,
+            .mIsOnSlope = frameData.mIsOnSlope,
+            .mInert = frameData.mInert,
+            .mSwimLevel = frameData.mSwimLevel,
+            .mSlowFall = frameData.mSlowFall,
+            .mRotation = frameData.mRotation,
+            .mMovement = frameData.mMovement,
+            .mLastStuckPosition = frameData.mLastStuckPosition,
+            .mWaterlevel = frameData.mWaterlevel,
+            .mHalfExtentsZ = frameData.mHalfExtentsZ,
+            .mOldHeight = frameData.mOldHeight,
+            .mStuckFrames = frameData.mStuckFrames,
+            .mFlying = frameData.mFlying,
+            .mWasOnGround = frameData.mWasOnGround,
+            .mIsAquatic = frameData.mIsAquatic,
+            .mWaterCollision = frameData.mWaterCollision,
+            .mSkipCollisionDetection = frameData.mSkipCollisionDetection,
+            .mIsPlayer = frameData.mIsPlayer,
+        };
+    }
+
+    std::vector<RecordedFrame> readSimulationRecording(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+            throw std::runtime_error("Failed to open physics recording: " + path.string());
+        const std::vector<char> content{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+        const std::byte* position = reinterpret_cast<const std::byte*>(content.data());
+        const std::byte* const end = position + content.size();
+
+        char magic[std::size(recordingMagic)];
+        std::uint32_t version = 0;
+        position = readValue(position, end, magic);
+        position = readValue(position, end, version);
+        if (std::memcmp(magic, recordingMagic, sizeof(magic)) != 0)
+            throw std::runtime_error("Bad physics recording magic: " + path.string());
+        if (version != recordingVersion)
+            throw std::runtime_error("Unsupported physics recording version: " + std::to_string(version));
+
+        std::vector<RecordedFrame> result;
+        while (position != end)
+            position = readValue(position, end, result.emplace_back());
+        return result;
+    }
+
+    SimulationRecorder::SimulationRecorder(const std::filesystem::path& path)
+        : mStream(path, std::ios::binary)
+    {
+        if (!mStream)
+            throw std::runtime_error("Failed to open physics recording for writing: " + path.string());
+        writeValue(mStream, recordingMagic);
+        writeValue(mStream, recordingVersion);
+    }
+
+    void SimulationRecorder::addObject(const btCollisionObject& object)
+    {
+        if (!isRecordedObject(object))
+            return;
+        const std::lock_guard lock(mObjectsMutex);
+        if (mObjectIds.emplace(&object, mNextObjectId).second)
+        {
+            ++mNextObjectId;
+            mChangedObjects.insert(&object);
+        }
+    }
+
+    void SimulationRecorder::updateObject(const btCollisionObject& object)
+    {
+        const std::lock_guard lock(mObjectsMutex);
+        if (mObjectIds.contains(&object))
+            mChangedObjects.insert(&object);
+    }
+
+    void SimulationRecorder::removeObject(const btCollisionObject& object)
+    {
+        const std::lock_guard lock(mObjectsMutex);
+        const auto it = mObjectIds.find(&object);
+        if (it == mObjectIds.end())
+            return;
+        mRemovedObjects.push_back(it->second);
+        mChangedObjects.erase(&object);
+        mObjectIds.erase(it);
+    }
+
+    void SimulationRecorder::beginFrame(
+        unsigned steps, float physicsDt, const WorldFrameData& worldFrameData, std::vector<Simulation>& simulations)
+    {
+        mFrame = std::make_unique<RecordedFrame>();
+        mFrame->mSteps = steps;
+        mFrame->mPhysicsDt = physicsDt;
+        mFrame->mIsInStorm = worldFrameData.mIsInStorm;
+        mFrame->mStormDirection = worldFrameData.mStormDirection;
+
+        {
+            const std::lock_guard lock(mObjectsMutex);
+            std::size_t skipped = 0;
+            const auto recordObject = [&](const btCollisionObject& object, std::uint32_t id) {
+                const btBroadphaseProxy* const proxy = object.getBroadphaseHandle();
+                RecordedObject& recorded = mFrame->mWorld.emplace_back(RecordedObject{
+                    .mId = id,
+                    .mCollisionGroup = proxy->m_collisionFilterGroup,
+                    .mCollisionMask = proxy->m_collisionFilterMask,
+                    .mTriangles = {},
+                });
+                if (!collectTriangles(*object.getCollisionShape(), object.getWorldTransform(), recorded.mTriangles))
+                    ++skipped;
+            };
+            if (mFirstFrame)
+            {
+                mFrame->mResetWorld = true;
+                for (const auto& [object, id] : mObjectIds)
+                    recordObject(*object, id);
+                mRemovedObjects.clear();
+                mFirstFrame = false;
+            }
+            else
+            {
+                for (const btCollisionObject* object : mChangedObjects)
+                    recordObject(*object, mObjectIds.at(object));
+                mFrame->mRemovedObjects = std::move(mRemovedObjects);
+                mRemovedObjects.clear();
+            }
+            mChangedObjects.clear();
+            if (skipped > 0)
+                Log(Debug::Warning) << "Failed to record " << skipped << " collision objects with unsupported shapes";
+        }
+        // Keep the file content independent from the hash table order
+        std::sort(mFrame->mWorld.begin(), mFrame->mWorld.end(),
+            [](const RecordedObject& l, const RecordedObject& r) { return l.mId < r.mId; });
+
+        std::erase_if(mActorIds, [](const auto& v) { return v.first.expired(); });
+
+        for (Simulation& simulation : simulations)
+        {
+            ActorSimulation* const actorSimulation = std::get_if<ActorSimulation>(&simulation);
+            if (actorSimulation == nullptr)
+                continue;
+            const auto locked = actorSimulation->lock();
+            if (!locked.has_value())
+                continue;
+            const auto& [actor, frameData] = *locked;
+            mFrame->mActors.push_back(recordActor(getActorId(actor), *actor, frameData));
+        }
+    }
+
+    void SimulationRecorder::endFrame(std::vector<Simulation>& simulations)
+    {
+        if (mFrame == nullptr)
+            return;
+
+        std::unordered_map<std::uint32_t, std::size_t> indices;
+        for (std::size_t i = 0; i < mFrame->mActors.size(); ++i)
+            indices.emplace(mFrame->mActors[i].mId, i);
+
+        mFrame->mResultPositions.resize(mFrame->mActors.size());
+        for (std::size_t i = 0; i < mFrame->mActors.size(); ++i)
+            mFrame->mResultPositions[i] = mFrame->mActors[i].mPosition;
+
+        for (Simulation& simulation : simulations)
+        {
+            ActorSimulation* const actorSimulation = std::get_if<ActorSimulation>(&simulation);
+            if (actorSimulation == nullptr)
+                continue;
+            const auto locked = actorSimulation->lock();
+            if (!locked.has_value())
+                continue;
+            const auto& [actor, frameData] = *locked;
+            const auto it = indices.find(getActorId(actor));
+            if (it != indices.end())
+                mFrame->mResultPositions[it->second] = frameData.get().mPosition;
+        }
+
+        writeValue(mStream, *mFrame);
+        mStream.flush();
+        mFrame.reset();
+    }
+
+    std::uint32_t SimulationRecorder::getActorId(const std::shared_ptr<Actor>& actor)
+    {
+        const auto [it, inserted] = mActorIds.emplace(actor, mNextActorId);
+        if (inserted)
+            ++mNextActorId;
+        return it->second;
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef OPENMW_MWPHYSICS_SIMULATIONRECORDING_H
+#define OPENMW_MWPHYSICS_SIMULATIONRECORDING_H
+
+#include <osg/Quat>
+#include <osg/Vec2f>
+#include <osg/Vec3f>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "physicssystem.hpp"
+
+class btCollisionObject;
+class btCollisionShape;
+class btTransform;
+
+namespace MWPhysics
+{
+    // Collision object flattened into world space triangles
+    struct RecordedObject
+    {
+        // Identifies the object over frames
+        std::uint32_t mId = 0;
+        int mCollisionGroup = 0;
+        int mCollisionMask = 0;
+        // 3 vertices per triangle
+        std::vector<osg::Vec3f> mTriangles;
+    };
+
+    enum class RecordedActorShape : std::uint8_t
+    {
+        Box,
+        Cylinder,
+    };
+
+    // Actor collision object and ActorFrameData state at the beginning of the simulation
+    struct RecordedActor
+    {
+        std::uint32_t mId = 0;
+        RecordedActorShape mShape = RecordedActorShape::Box;
+        osg::Vec3f mHalfExtents;
+        float mMargin = 0;
+        osg::Vec3f mCollisionObjectPosition;
+        osg::Quat mCollisionObjectRotation;
+        int mCollisionGroup = 0;
+        int mCollisionMask = 0;
+
+        osg::Vec3f mPosition;
+        osg::Vec3f mInertia;
+        bool mIsOnGround = false;
+        bool mIsOnSlope = false;
+        bool mInert = false;
+        float mSwimLevel = 0;
+        float mSlowFall = 0;
+        osg::Vec2f mRotation;
+        osg::Vec3f mMovement;
+        osg::Vec3f mLastStuckPosition;
+        float mWaterlevel = 0;
+        float mHalfExtentsZ = 0;
+        float mOldHeight = 0;
+        std::uint32_t mStuckFrames = 0;
+        bool mFlying = false;
+        bool mWasOnGround = false;
+        bool mIsAquatic = false;
+        bool mWaterCollision = false;
+        bool mSkipCollisionDetection = false;
+        bool mIsPlayer = false;
+    };
+
+    struct RecordedFrame
+    {
+        std::uint32_t mSteps = 0;
+        float mPhysicsDt = 0;
+        bool mIsInStorm = false;
+        osg::Vec3f mStormDirection;
+        // First frame stores the whole static world. Next frames store only objects added, moved or removed since
+        // the previous frame. An object in mWorld replaces one with the same id.
+        bool mResetWorld = false;
+        std::vector<RecordedObject> mWorld;
+        std::vector<std::uint32_t> mRemovedObjects;
+        std::vector<RecordedActor> mActors;
+        // Actors positions after the simulation in the same order as mActors
+        std::vector<osg::Vec3f> mResultPositions;
+    };
+
+    // Appends world space triangles of the shape, returns false when some of the child shapes are not supported
+    bool collectTriangles(
+        const btCollisionShape& shape, const btTransform& transform, std::vector<osg::Vec3f>& triangles);
+
+    RecordedActor recordActor(std::uint32_t id, const Actor& actor, const ActorFrameData& frameData);
+
+    std::vector<RecordedFrame> readSimulationRecording(const std::filesystem::path& path);
+
+    // Writes inputs and results of each simulated frame. Actors simulation is recorded, projectiles are ignored.
+    class SimulationRecorder
+    {
+    public:
+        // Throws std::runtime_error when the file can't be opened for writing
+        explicit SimulationRecorder(const std::filesystem::path& path);
+
+        // Thread safe. Object has to be added to the collision world. Actors and projectiles are ignored.
+        void addObject(const btCollisionObject& object);
+
+        // Thread safe. Call when object transform or collision filter has changed.
+        void updateObject(const btCollisionObject& object);
+
+        // Thread safe. Object may be already removed from the collision world but has to be alive.
+        void removeObject(const btCollisionObject& object);
+
+        // Collision objects added, updated or removed since the previous frame are flattened into triangles
+        void beginFrame(unsigned steps, float physicsDt, const WorldFrameData& worldFrameData,
+            std::vector<Simulation>& simulations);
+
+        void endFrame(std::vector<Simulation>& simulations);
+
+    private:
+        std::ofstream mStream;
+        std::mutex mObjectsMutex;
+        std::unordered_map<const btCollisionObject*, std::uint32_t> mObjectIds;
+        std::unordered_set<const btCollisionObject*> mChangedObjects;
+        std::vector<std::uint32_t> mRemovedObjects;
+        std::uint32_t mNextObjectId = 0;
+        bool mFirstFrame = true;
+        std::map<std::weak_ptr<Actor>, std::uint32_t, std::owner_less<std::weak_ptr<Actor>>> mActorIds;
+        std::uint32_t mNextActorId = 0;
+        std::unique_ptr<RecordedFrame> mFrame;
+
+        std::uint32_t getActorId(const std::shared_ptr<Actor>& actor);
+    };
+}
+
+#endif
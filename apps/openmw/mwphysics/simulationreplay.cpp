@@ -0,0 +1,292 @@
+#include "simulationreplay.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCylinderShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include <components/misc/convert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <variant>
+
+#include "movementsolver.hpp"
+#include "physicssystem.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        std::unique_ptr<btCollisionShape> makeActorShape(const RecordedActor& actor)
+        {
+            std::unique_ptr<btConvexInternalShape> result;
+            const btVector3 halfExtents = Misc::Convert::toBullet(actor.mHalfExtents);
+            switch (actor.mShape)
+            {
+                case RecordedActorShape::Box:
+                    result = std::make_unique<btBoxShape>(halfExtents);
+                    break;
+                case RecordedActorShape::Cylinder:
+                    result = std::make_unique<btCylinderShapeZ>(halfExtents);
+                    break;
+            }
+            result->setMargin(actor.mMargin);
+            return result;
+        }
+
+        std::variant<std::monostate, std::unique_lock<std::shared_mutex>, std::shared_lock<std::shared_mutex>> makeLock(
+            std::shared_mutex& mutex, LockingPolicy lockingPolicy)
+        {
+            switch (lockingPolicy)
+            {
+                case LockingPolicy::NoLocks:
+                    return std::monostate{};
+                case LockingPolicy::ExclusiveLocksOnly:
+                    return std::unique_lock(mutex);
+                case LockingPolicy::AllowSharedLocks:
+                    return std::shared_lock(mutex);
+            }
+            return std::monostate{};
+        }
+    }
+
+    class SimulationReplay::Workers
+    {
+    public:
+        explicit Workers(unsigned count)
+        {
+            for (unsigned i = 0; i < count; ++i)
+                mThreads.emplace_back([this, i] { work(i); });
+        }
+
+        ~Workers()
+        {
+            {
+                const std::lock_guard lock(mMutex);
+                mShouldStop = true;
+            }
+            mHasJob.notify_all();
+            for (std::thread& thread : mThreads)
+                thread.join();
+        }
+
+        unsigned size() const { return static_cast<unsigned>(mThreads.size()); }
+
+        // Calls job on the calling thread and on the given number of workers and waits for all of them to finish
+        void run(unsigned workers, const std::function<void()>& job)
+        {
+            {
+                const std::lock_guard lock(mMutex);
+                mJob = &job;
+                mParticipants = workers;
+                mRunning = workers;
+                ++mGeneration;
+            }
+            mHasJob.notify_all();
+            job();
+            std::unique_lock lock(mMutex);
+            mDone.wait(lock, [&] { return mRunning == 0; });
+            mJob = nullptr;
+        }
+
+    private:
+        std::vector<std::thread> mThreads;
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mDone;
+        const std::function<void()>* mJob = nullptr;
+        unsigned mParticipants = 0;
+        unsigned mRunning = 0;
+        std::size_t mGeneration = 0;
+        bool mShouldStop = false;
+
+        void work(unsigned index)
+        {
+            std::size_t generation = 0;
+            std::unique_lock lock(mMutex);
+            while (true)
+            {
+                mHasJob.wait(lock, [&] { return mShouldStop || mGeneration != generation; });
+                if (mShouldStop)
+                    return;
+                generation = mGeneration;
+                if (index >= mParticipants)
+                    continue;
+                const std::function<void()>* const job = mJob;
+                lock.unlock();
+                (*job)();
+                lock.lock();
+                if (--mRunning == 0)
+                    mDone.notify_all();
+            }
+        }
+    };
+
+    SimulationReplay::SimulationReplay(unsigned maxThreads)
+        : mCollisionConfiguration(std::make_unique<btDefaultCollisionConfiguration>())
+        , mDispatcher(std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get()))
+        , mBroadphase(std::make_unique<btDbvtBroadphase>())
+        , mCollisionWorld(
+              std::make_unique<btCollisionWorld>(mDispatcher.get(), mBroadphase.get(), mCollisionConfiguration.get()))
+    {
+        mCollisionWorld->setForceUpdateAllAabbs(false);
+        // Concurrent queries are possible only when Bullet is built with multithreading support
+        const std::size_t maxSupportedThreads = static_cast<btDbvtBroadphase&>(*mBroadphase).m_rayTestStacks.size();
+        const unsigned threads = std::clamp<unsigned>(maxThreads, 1, static_cast<unsigned>(maxSupportedThreads));
+        mWorkers = std::make_unique<Workers>(threads - 1);
+    }
+
+    SimulationReplay::~SimulationReplay()
+    {
+        mWorkers.reset();
+        for (const auto& [id, object] : mStaticObjects)
+            mCollisionWorld->removeCollisionObject(object.mObject.get());
+        for (const auto& [id, actor] : mActors)
+            mCollisionWorld->removeCollisionObject(actor.mObject.get());
+    }
+
+    unsigned SimulationReplay::getMaxThreads() const
+    {
+        return mWorkers->size() + 1;
+    }
+
+    std::vector<osg::Vec3f> SimulationReplay::replay(
+        const RecordedFrame& frame, unsigned threads, LockingPolicy lockingPolicy)
+    {
+        updateStaticObjects(frame);
+
+        std::erase_if(mActors, [&](const auto& v) {
+            const auto sameId = [&](const RecordedActor& actor) { return actor.mId == v.first; };
+            if (std::any_of(frame.mActors.begin(), frame.mActors.end(), sameId))
+                return false;
+            mCollisionWorld->removeCollisionObject(v.second.mObject.get());
+            return true;
+        });
+
+        std::vector<ActorFrameData> actors;
+        actors.reserve(frame.mActors.size());
+        for (const RecordedActor& actor : frame.mActors)
+            actors.emplace_back(actor, &updateActor(actor));
+
+        // Storm wind requires game settings so it is not replayed
+        const WorldFrameData worldFrameData(false, frame.mStormDirection);
+        std::atomic<std::size_t> nextActor = 0;
+        const std::function<void()> move = [&] {
+            std::size_t i = 0;
+            while ((i = nextActor.fetch_add(1, std::memory_order_relaxed)) < actors.size())
+            {
+                const auto lock = makeLock(mCollisionWorldMutex, lockingPolicy);
+                MovementSolver::move(actors[i], frame.mPhysicsDt, mCollisionWorld.get(), worldFrameData);
+            }
+        };
+        const unsigned workers = std::clamp(threads, 1u, getMaxThreads()) - 1;
+
+        for (std::uint32_t step = 0; step < frame.mSteps; ++step)
+        {
+            for (ActorFrameData& actor : actors)
+                MovementSolver::unstuck(actor, mCollisionWorld.get());
+
+            nextActor.store(0, std::memory_order_relaxed);
+            mWorkers->run(workers, move);
+
+            for (std::size_t i = 0; i < actors.size(); ++i)
+            {
+                const RecordedActor& recorded = frame.mActors[i];
+                const osg::Vec3f meshTranslation = recorded.mCollisionObjectPosition - recorded.mPosition;
+                btCollisionObject& object = *actors[i].mCollisionObject;
+                object.getWorldTransform().setOrigin(Misc::Convert::toBullet(actors[i].mPosition + meshTranslation));
+                mCollisionWorld->updateSingleAabb(&object);
+            }
+        }
+
+        std::vector<osg::Vec3f> result;
+        result.reserve(actors.size());
+        for (const ActorFrameData& actor : actors)
+            result.push_back(actor.mPosition);
+        return result;
+    }
+
+    void SimulationReplay::updateStaticObjects(const RecordedFrame& frame)
+    {
+        const auto remove = [&](std::uint32_t id) {
+            const auto it = mStaticObjects.find(id);
+            if (it == mStaticObjects.end())
+                return;
+            mCollisionWorld->removeCollisionObject(it->second.mObject.get());
+            mStaticObjects.erase(it);
+        };
+
+        if (frame.mResetWorld)
+        {
+            for (const auto& [id, object] : mStaticObjects)
+                mCollisionWorld->removeCollisionObject(object.mObject.get());
+            mStaticObjects.clear();
+        }
+
+        for (const std::uint32_t id : frame.mRemovedObjects)
+            remove(id);
+
+        for (const RecordedObject& recorded : frame.mWorld)
+        {
+            remove(recorded.mId);
+            // Objects with unsupported shapes are recorded without triangles to keep track of them
+            if (recorded.mTriangles.empty())
+                continue;
+            StaticObject& object = mStaticObjects[recorded.mId];
+            object.mMesh = std::make_unique<btTriangleMesh>();
+            for (std::size_t i = 0; i + 2 < recorded.mTriangles.size(); i += 3)
+                object.mMesh->addTriangle(Misc::Convert::toBullet(recorded.mTriangles[i]),
+                    Misc::Convert::toBullet(recorded.mTriangles[i + 1]),
+                    Misc::Convert::toBullet(recorded.mTriangles[i + 2]));
+            object.mShape = std::make_unique<btBvhTriangleMeshShape>(object.mMesh.get(), true);
+            object.mObject = std::make_unique<btCollisionObject>();
+            object.mObject->setCollisionShape(object.mShape.get());
+            mCollisionWorld->addCollisionObject(
+                object.mObject.get(), recorded.mCollisionGroup, recorded.mCollisionMask);
+        }
+    }
+
+    btCollisionObject& SimulationReplay::updateActor(const RecordedActor& actor)
+    {
+        auto it = mActors.find(actor.mId);
+        if (it != mActors.end()
+            && (it->second.mShapeType != actor.mShape || it->second.mHalfExtents != actor.mHalfExtents))
+        {
+            mCollisionWorld->removeCollisionObject(it->second.mObject.get());
+            mActors.erase(it);
+            it = mActors.end();
+        }
+
+        if (it == mActors.end())
+        {
+            ActorObject value{
+                .mShapeType = actor.mShape,
+                .mHalfExtents = actor.mHalfExtents,
+                .mShape = makeActorShape(actor),
+                .mObject = std::make_unique<btCollisionObject>(),
+            };
+            value.mObject->setCollisionFlags(btCollisionObject::CF_KINEMATIC_OBJECT);
+            value.mObject->setActivationState(DISABLE_DEACTIVATION);
+            value.mObject->setCollisionShape(value.mShape.get());
+            mCollisionWorld->addCollisionObject(value.mObject.get(), actor.mCollisionGroup, actor.mCollisionMask);
+            it = mActors.emplace(actor.mId, std::move(value)).first;
+        }
+
+        btCollisionObject& object = *it->second.mObject;
+        object.setWorldTransform(btTransform(Misc::Convert::toBullet(actor.mCollisionObjectRotation),
+            Misc::Convert::toBullet(actor.mCollisionObjectPosition)));
+        object.getBroadphaseHandle()->m_collisionFilterGroup = actor.mCollisionGroup;
+        object.getBroadphaseHandle()->m_collisionFilterMask = actor.mCollisionMask;
+        mCollisionWorld->updateSingleAabb(&object);
+        return object;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef OPENMW_MWPHYSICS_SIMULATIONREPLAY_H
+#define OPENMW_MWPHYSICS_SIMULATIONREPLAY_H
+
+#include <osg/Vec3f>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "mtphysics.hpp"
+#include "simulationrecording.hpp"
+
+class btBroadphaseInterface;
+class btCollisionConfiguration;
+class btCollisionDispatcher;
+class btCollisionObject;
+class btCollisionShape;
+class btCollisionWorld;
+class btTriangleMesh;
+
+namespace MWPhysics
+{
+    // Runs recorded frames against a collision world rebuilt from the recording without the rest of the engine.
+    // Each frame starts from the recorded state so errors do not accumulate over frames.
+    class SimulationReplay
+    {
+    public:
+        // Threads are created once because Bullet supports limited number of distinct threads over process lifetime
+        explicit SimulationReplay(unsigned maxThreads);
+
+        ~SimulationReplay();
+
+        unsigned getMaxThreads() const;
+
+        // Returns actors positions after the simulation in the same order as frame.mActors.
+        // Each actor movement holds the collision world lock like PhysicsTaskScheduler does for the given policy.
+        std::vector<osg::Vec3f> replay(
+            const RecordedFrame& frame, unsigned threads, LockingPolicy lockingPolicy = LockingPolicy::NoLocks);
+
+    private:
+        class Workers;
+
+        struct StaticObject
+        {
+            std::unique_ptr<btTriangleMesh> mMesh;
+            std::unique_ptr<btCollisionShape> mShape;
+            std::unique_ptr<btCollisionObject> mObject;
+        };
+
+        struct ActorObject
+        {
+            RecordedActorShape mShapeType;
+            osg::Vec3f mHalfExtents;
+            std::unique_ptr<btCollisionShape> mShape;
+            std::unique_ptr<btCollisionObject> mObject;
+        };
+
+        std::unique_ptr<btCollisionConfiguration> mCollisionConfiguration;
+        std::unique_ptr<btCollisionDispatcher> mDispatcher;
+        std::unique_ptr<btBroadphaseInterface> mBroadphase;
+        std::unique_ptr<btCollisionWorld> mCollisionWorld;
+        std::shared_mutex mCollisionWorldMutex;
+        std::map<std::uint32_t, StaticObject> mStaticObjects;
+        std::map<std::uint32_t, ActorObject> mActors;
+        std::unique_ptr<Workers> mWorkers;
+
+        void updateStaticObjects(const RecordedFrame& frame);
+
+        btCollisionObject& updateActor(const RecordedActor& actor);
+    };
+}
+
+#endif
@@ -1121,6 +1121,7 @@ namespace MWRender
         }
 
         mActiveControllers.clear();
+        mActiveKeyframeControllers.clear();
 
         mAccumCtrl = nullptr;
 
@@ -1157,6 +1158,8 @@ namespace MWRender
 
                     const bool useSmoothAnims = Settings::game().mSmoothAnimTransitions;
 
+                    mActiveKeyframeControllers.push_back(it->second);
+
                     osg::Callback* callback = it->second->getAsCallback();
                     if (useSmoothAnims)
                     {
@@ -1450,6 +1453,12 @@ namespace MWRender
         return movement;
     }
 
+    void Animation::prepareKeyframes()
+    {
+        for (const osg::ref_ptr<SceneUtil::KeyframeController>& controller : mActiveKeyframeControllers)
+            controller->prepareTransformation();
+    }
+
     void Animation::setLoopingEnabled(std::string_view groupname, bool enabled)
     {
         AnimStateMap::iterator state(mStates.find(groupname));
@@ -1562,6 +1571,7 @@ namespace MWRender
         mNodeMap.clear();
         mNodeMapCreated = false;
         mActiveControllers.clear();
+        mActiveKeyframeControllers.clear();
         mAccumRoot = nullptr;
         mAccumCtrl = nullptr;
 
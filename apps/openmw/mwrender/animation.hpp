@@ -205,6 +205,9 @@ namespace MWRender
         // We may need to rebuild these controllers when the active animation groups / sources change.
         ActiveControllersVector mActiveControllers;
 
+        // Keyframe controllers of the active animation groups
+        std::vector<osg::ref_ptr<SceneUtil::KeyframeController>> mActiveKeyframeControllers;
+
         // Keep track of the animation controllers for easy access
         std::map<osg::ref_ptr<osg::Node>, osg::ref_ptr<NifAnimBlendController>> mAnimBlendControllers;
         std::map<osg::ref_ptr<osg::Node>, osg::ref_ptr<BoneAnimBlendController>> mBoneAnimBlendControllers;
@@ -443,6 +446,12 @@ namespace MWRender
 
         virtual osg::Vec3f runAnimation(float duration);
 
+        /// Samples keyframe controllers of the active animation groups for the current animation time in advance so
+        /// the update traversal only has to apply them. Different animations may be prepared concurrently.
+        void prepareKeyframes();
+
+        bool hasActiveKeyframes() const { return !mActiveKeyframeControllers.empty(); }
+
         void setLoopingEnabled(std::string_view groupname, bool enabled);
 
         /// This is typically called as part of runAnimation, but may be called manually if needed.
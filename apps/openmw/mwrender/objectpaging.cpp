@@ -1,7 +1,15 @@
 #include "objectpaging.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <osg/LOD>
@@ -9,6 +17,7 @@
 #include <osg/MatrixTransform>
 #include <osg/Sequence>
 #include <osg/Switch>
+#include <osg/VertexAttribDivisor>
 #include <osgAnimation/BasicAnimationManager>
 #include <osgParticle/ParticleProcessor>
 #include <osgParticle/ParticleSystemUpdater>
@@ -28,11 +37,13 @@
 #include <components/esm4/loadfurn.hpp>
 #include <components/esm4/loadstat.hpp>
 #include <components/esm4/loadtree.hpp>
+#include <components/misc/cachekey.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/nifosg/autotransform.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/sceneutil/geometrydiskcache.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
 #include <components/sceneutil/optimizer.hpp>
@@ -41,6 +52,7 @@
 #include <components/sceneutil/riggeometryosgaextension.hpp>
 #include <components/sceneutil/util.hpp>
 #include <components/settings/values.hpp>
+#include <components/shader/shadermanager.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "apps/openmw/mwbase/environment.hpp"
@@ -127,7 +139,12 @@ namespace MWRender
             return static_cast<osg::Node*>(obj.get());
 
         const unsigned char lod = static_cast<unsigned char>(lodFlags >> (4 * 4));
+        const auto start = std::chrono::steady_clock::now();
         osg::ref_ptr<osg::Node> node = createChunk(size, center, activeGrid, viewPoint, compile, lod);
+        const auto duration = std::chrono::steady_clock::now() - start;
+        mBuildTime.fetch_add(static_cast<std::uint64_t>(
+                                 std::chrono::duration_cast<std::chrono::microseconds>(duration).count()),
+            std::memory_order_relaxed);
         mCache->addEntryToObjectCache(id, node.get());
         return node;
     }
@@ -462,7 +479,8 @@ namespace MWRender
         };
     }
 
-    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace)
+    ObjectPaging::ObjectPaging(
+        Resource::SceneManager* sceneManager, ESM::RefId worldspace, const SceneUtil::GeometryDiskCache* diskCache)
         : GenericResourceManager<ChunkId>(nullptr, Settings::cells().mCacheExpiryDelay)
         , Terrain::QuadTreeWorld::ChunkManager(worldspace)
         , mSceneManager(sceneManager)
@@ -472,8 +490,19 @@ namespace MWRender
         , mMinSize(Settings::terrain().mObjectPagingMinSize)
         , mMinSizeMergeFactor(Settings::terrain().mObjectPagingMinSizeMergeFactor)
         , mMinSizeCostMultiplier(Settings::terrain().mObjectPagingMinSizeCostMultiplier)
+        , mInstancing(Settings::terrain().mObjectPagingInstancing)
+        , mInstancingMinVertices(static_cast<unsigned>(Settings::terrain().mObjectPagingInstancingMinVertices))
+        , mDiskCache(diskCache)
         , mRefTrackerLocked(false)
     {
+        if (mInstancing)
+        {
+            const osg::Program* const programTemplate = mSceneManager->getShaderManager().getProgramTemplate();
+            mInstancingProgramTemplate = programTemplate ? Shader::ShaderManager::cloneProgram(programTemplate)
+                                                         : osg::ref_ptr<osg::Program>(new osg::Program);
+            mInstancingProgramTemplate->addBindAttribLocation("aOffset", 6);
+            mInstancingProgramTemplate->addBindAttribLocation("aRotation", 7);
+        }
     }
 
     namespace
@@ -615,6 +644,242 @@ namespace MWRender
             }
             return refs;
         }
+
+        osg::Quat makeAttitude(const PagedCellRef& ref)
+        {
+            return osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
+                * osg::Quat(ref.mRotation.y(), osg::Vec3f(0, -1, 0))
+                * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0));
+        }
+
+        osg::Matrixf makeInstanceMatrix(const PagedCellRef& ref, const osg::Vec3f& worldCenter)
+        {
+            osg::Matrixf matrix;
+            matrix.preMultTranslate(ref.mPosition - worldCenter);
+            matrix.preMultRotate(makeAttitude(ref));
+            matrix.preMultScale(osg::Vec3f(ref.mScale, ref.mScale, ref.mScale));
+            return matrix;
+        }
+
+        // Instance transforms are applied to the vertices in the space of the drawable, so the subgraph must not have
+        // anything that depends on the node position. Such subgraphs fall back to copying a node for each instance.
+        class CanInstanceVisitor : public osg::NodeVisitor
+        {
+        public:
+            CanInstanceVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (node.asTransform() != nullptr || dynamic_cast<const osg::LOD*>(&node) != nullptr
+                    || node.getCullCallback() != nullptr)
+                    mResult = false;
+                else
+                    traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                if (drawable.asGeometry() == nullptr || drawable.getCullCallback() != nullptr)
+                    mResult = false;
+            }
+
+            bool mResult = true;
+        };
+
+        osg::Array* copyIfWithoutBufferObject(osg::Array* array)
+        {
+            if (array == nullptr || array->getVertexBufferObject() != nullptr)
+                return array;
+            return static_cast<osg::Array*>(array->clone(osg::CopyOp::DEEP_COPY_ALL));
+        }
+
+        // Arrays are shared with the template geometry. Enabling vertex buffer objects for the instanced geometry
+        // assigns buffer objects to arrays which don't have one, so such arrays are copied first.
+        void unshareArraysWithoutBufferObject(osg::Geometry& geom)
+        {
+            geom.setVertexArray(copyIfWithoutBufferObject(geom.getVertexArray()));
+            geom.setNormalArray(copyIfWithoutBufferObject(geom.getNormalArray()));
+            geom.setColorArray(copyIfWithoutBufferObject(geom.getColorArray()));
+            geom.setSecondaryColorArray(copyIfWithoutBufferObject(geom.getSecondaryColorArray()));
+            geom.setFogCoordArray(copyIfWithoutBufferObject(geom.getFogCoordArray()));
+            for (unsigned int i = 0; i < geom.getNumTexCoordArrays(); ++i)
+                geom.setTexCoordArray(i, copyIfWithoutBufferObject(geom.getTexCoordArray(i)));
+            for (unsigned int i = 0; i < geom.getNumVertexAttribArrays(); ++i)
+                geom.setVertexAttribArray(i, copyIfWithoutBufferObject(geom.getVertexAttribArray(i)));
+        }
+
+        class InstancingVisitor : public osg::NodeVisitor
+        {
+        public:
+            explicit InstancingVisitor(std::span<const PagedCellRef* const> instances, const osg::Vec3f& worldCenter)
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+                , mInstances(instances)
+                , mOffsets(new osg::Vec4Array)
+                , mRotations(new osg::Vec3Array)
+                , mStateSet(new osg::StateSet)
+            {
+                mOffsets->reserve(instances.size());
+                mRotations->reserve(instances.size());
+                mMatrices.reserve(instances.size());
+                for (const PagedCellRef* ref : instances)
+                {
+                    const osg::Vec3f position = ref->mPosition - worldCenter;
+                    mOffsets->push_back(osg::Vec4f(position, ref->mScale));
+                    mRotations->push_back(ref->mRotation);
+                    mMatrices.push_back(makeInstanceMatrix(*ref, worldCenter));
+                }
+
+                // The original geometry arrays are not used for the new arrays to not share a buffer object with them
+                osg::ref_ptr<osg::VertexBufferObject> vbo = new osg::VertexBufferObject;
+                mOffsets->setVertexBufferObject(vbo);
+                mRotations->setVertexBufferObject(vbo);
+
+                mStateSet->setAttribute(new osg::VertexAttribDivisor(6, 1));
+                mStateSet->setAttribute(new osg::VertexAttribDivisor(7, 1));
+                mStateSet->addUniform(new osg::Uniform("useInstancing", true));
+            }
+
+            void apply(osg::Geometry& geom) override
+            {
+                for (unsigned int i = 0; i < geom.getNumPrimitiveSets(); ++i)
+                    geom.getPrimitiveSet(i)->setNumInstances(static_cast<int>(mInstances.size()));
+
+                const osg::BoundingSphere bound(geom.getBoundingBox());
+                osg::BoundingBox box;
+                for (std::size_t i = 0; i < mInstances.size(); ++i)
+                    box.expandBy(
+                        osg::BoundingSphere(bound.center() * mMatrices[i], bound.radius() * mInstances[i]->mScale));
+                geom.setInitialBound(box);
+
+                // Display lists do not support instancing in OSG 3.4
+                geom.setUseDisplayList(false);
+                if (!geom.getUseVertexBufferObjects())
+                {
+                    unshareArraysWithoutBufferObject(geom);
+                    geom.setUseVertexBufferObjects(true);
+                }
+
+                geom.setVertexAttribArray(6, mOffsets, osg::Array::BIND_PER_VERTEX);
+                geom.setVertexAttribArray(7, mRotations, osg::Array::BIND_PER_VERTEX);
+
+                osg::ref_ptr<osg::StateSet> stateSet = geom.getStateSet()
+                    ? osg::clone(geom.getStateSet(), osg::CopyOp::SHALLOW_COPY)
+                    : new osg::StateSet;
+                stateSet->merge(*mStateSet);
+                geom.setStateSet(stateSet);
+                // Picked up by the shader visitor to select the instancing shader permutation
+                geom.setUserValue("instancing", true);
+            }
+
+        private:
+            std::span<const PagedCellRef* const> mInstances;
+            std::vector<osg::Matrixf> mMatrices;
+            osg::ref_ptr<osg::Vec4Array> mOffsets;
+            osg::ref_ptr<osg::Vec3Array> mRotations;
+            osg::ref_ptr<osg::StateSet> mStateSet;
+        };
+
+        class ChunkMemory : public osg::Object
+        {
+        public:
+            ChunkMemory() = default;
+            ChunkMemory(const ChunkMemory& copy, const osg::CopyOp&)
+                : mBytes(copy.mBytes)
+            {
+            }
+            META_Object(MWRender, ChunkMemory)
+            std::size_t mBytes = 0;
+        };
+
+        class ComputeMemoryVisitor : public osg::NodeVisitor
+        {
+        public:
+            ComputeMemoryVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Geometry& geom) override
+            {
+                for (const osg::Array* array : geom.getVertexAttribArrayList())
+                    add(array);
+                for (const osg::Array* array : geom.getTexCoordArrayList())
+                    add(array);
+                add(geom.getVertexArray());
+                add(geom.getNormalArray());
+                add(geom.getColorArray());
+                add(geom.getSecondaryColorArray());
+                add(geom.getFogCoordArray());
+                for (unsigned int i = 0; i < geom.getNumPrimitiveSets(); ++i)
+                    add(geom.getPrimitiveSet(i));
+            }
+
+            std::size_t mBytes = 0;
+
+        private:
+            std::unordered_set<const osg::BufferData*> mVisited;
+
+            void add(const osg::BufferData* data)
+            {
+                if (data != nullptr && mVisited.insert(data).second)
+                    mBytes += data->getTotalDataSize();
+            }
+        };
+
+        osg::ref_ptr<osg::Group> makeInstancePrototype(const osg::Node* node, CopyOp& copyop, const LODRange& distances)
+        {
+            osg::ref_ptr<osg::Group> result = new osg::Group;
+            // Primitives are copied once per chunk because the number of instances is stored in them. Arrays are shared
+            // with the template like for merged chunks, the optimizer copies the ones it has to modify.
+            copyop.setCopyFlags(
+                osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES | osg::CopyOp::DEEP_COPY_PRIMITIVES);
+            copyop.mDistances = distances;
+            copyop.copy(node, result);
+
+            SceneUtil::Optimizer optimizer;
+            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+            optimizer.optimize(result,
+                SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES
+                    | SceneUtil::Optimizer::MERGE_GEOMETRY);
+
+            CanInstanceVisitor visitor;
+            result->accept(visitor);
+            if (!visitor.mResult || result->getNumChildren() == 0)
+                return nullptr;
+            return result;
+        }
+
+        // Collects state sets in traversal order which is stable between runs unlike their addresses
+        class CollectStateSetsVisitor : public osg::NodeVisitor
+        {
+        public:
+            CollectStateSetsVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (osg::StateSet* const stateSet = node.getStateSet();
+                    stateSet != nullptr && mVisited.insert(stateSet).second)
+                    mStateSets.push_back(stateSet);
+                traverse(node);
+            }
+
+            std::vector<osg::StateSet*> mStateSets;
+
+        private:
+            std::unordered_set<const osg::StateSet*> mVisited;
+        };
+
+        void appendToKey(std::string& key, const ESM::RefNum& value)
+        {
+            Misc::appendToKey(key, value.mIndex);
+            Misc::appendToKey(key, value.mContentFile);
+        }
     }
 
     osg::ref_ptr<osg::Node> ObjectPaging::createChunk(float size, const osg::Vec2f& center, bool activeGrid,
@@ -660,6 +925,7 @@ namespace MWRender
         struct InstanceList
         {
             std::vector<const PagedCellRef*> mInstances;
+            VFS::Path::Normalized mModel;
             AnalyzeVisitor::Result mAnalyzeResult;
             bool mNeedCompile = false;
         };
@@ -777,6 +1043,7 @@ namespace MWRender
                 // const-trickery required because there is no const version of NodeVisitor
                 const_cast<osg::Node*>(nodePtr)->accept(analyzeVisitor);
                 emplaced.first->second.mAnalyzeResult = analyzeVisitor.retrieveResult();
+                emplaced.first->second.mModel = model;
                 emplaced.first->second.mNeedCompile = compile && nodePtr->referenceCount() <= 2;
             }
             else
@@ -791,6 +1058,31 @@ namespace MWRender
         osg::ref_ptr<Resource::TemplateMultiRef> templateRefs = new Resource::TemplateMultiRef;
         osgUtil::StateToCompile stateToCompile(0, nullptr);
         CopyOp copyop(activeGrid, copyMask);
+
+        const auto copyInstance = [&](const osg::Node* cnode, const PagedCellRef& ref, bool merge, osg::Group* trans) {
+            // DO NOT COPY AND PASTE THIS CODE. Cloning osg::Geometry without also cloning its contained Arrays is
+            // generally unsafe. In this specific case the operation is safe under the following two assumptions:
+            // - When Arrays are removed or replaced in the cloned geometry, the original Arrays in their place must
+            // outlive the cloned geometry regardless. (ensured by TemplateMultiRef)
+            // - Arrays that we add or replace in the cloned geometry must be explicitely forbidden from reusing
+            // BufferObjects of the original geometry. (ensured by needvbo() in optimizer.cpp)
+            copyop.setCopyFlags(merge ? osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES
+                                      : osg::CopyOp::DEEP_COPY_NODES);
+            copyop.mDistances = lodDistances / ref.mScale;
+            copyop.copy(cnode, trans);
+        };
+
+        // Merged geometry of distant chunks depends only on the merged instances and their templates, so copying and
+        // merging them is deferred until it's known whether the result can be loaded from the disk cache
+        struct MergedInstance
+        {
+            const osg::Node* mNode;
+            const InstanceList* mInstanceList;
+            const PagedCellRef* mRef;
+        };
+        const bool useDiskCache = mDiskCache != nullptr && !activeGrid;
+        std::vector<MergedInstance> mergedInstances;
+
         for (const auto& pair : nodes)
         {
             const osg::Node* cnode = pair.first;
@@ -806,7 +1098,21 @@ namespace MWRender
             const float minSizeMergeFactor2 = (1 - factor2) * mMinSizeMergeFactor + factor2;
             const float minSizeMerged = minSizeMergeFactor2 > 0 ? mMinSize * minSizeMergeFactor2 : mMinSize;
 
+            // Active grid chunks are not instanced because picking and disabling objects requires separate nodes
+            osg::ref_ptr<osg::Group> prototype;
+            if (mInstancing && !activeGrid && pair.second.mInstances.size() > 1
+                && analyzeResult.mNumVerts >= mInstancingMinVertices)
+            {
+                const auto [minScale, maxScale] = std::minmax_element(pair.second.mInstances.begin(),
+                    pair.second.mInstances.end(),
+                    [](const PagedCellRef* l, const PagedCellRef* r) { return l->mScale < r->mScale; });
+                const LODRange distances{ lodDistances.first / (*maxScale)->mScale,
+                    lodDistances.second / (*minScale)->mScale };
+                prototype = makeInstancePrototype(cnode, copyop, distances);
+            }
+
             unsigned int numinstances = 0;
+            std::vector<const PagedCellRef*> instances;
             for (const PagedCellRef* refPtr : pair.second.mInstances)
             {
                 const PagedCellRef& ref = *refPtr;
@@ -816,21 +1122,25 @@ namespace MWRender
                         < (viewPoint - ref.mPosition).length2() * minSizeMerged * minSizeMerged)
                     continue;
 
-                const osg::Vec3f nodePos = ref.mPosition - worldCenter;
-                const osg::Quat nodeAttitude = osg::Quat(ref.mRotation.z(), osg::Vec3f(0, 0, -1))
-                    * osg::Quat(ref.mRotation.y(), osg::Vec3f(0, -1, 0))
-                    * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0));
-                const osg::Vec3f nodeScale(ref.mScale, ref.mScale, ref.mScale);
+                if (prototype != nullptr)
+                {
+                    instances.push_back(&ref);
+                    ++numinstances;
+                    continue;
+                }
+
+                if (merge && useDiskCache)
+                {
+                    mergedInstances.push_back(MergedInstance{ cnode, &pair.second, &ref });
+                    ++numinstances;
+                    continue;
+                }
 
                 osg::ref_ptr<osg::Group> trans;
                 if (merge)
                 {
                     // Optimizer currently supports only MatrixTransforms.
-                    osg::Matrixf matrix;
-                    matrix.preMultTranslate(nodePos);
-                    matrix.preMultRotate(nodeAttitude);
-                    matrix.preMultScale(nodeScale);
-                    trans = new osg::MatrixTransform(matrix);
+                    trans = new osg::MatrixTransform(makeInstanceMatrix(ref, worldCenter));
                     trans->setDataVariance(osg::Object::STATIC);
                 }
                 else
@@ -838,21 +1148,12 @@ namespace MWRender
                     trans = new SceneUtil::PositionAttitudeTransform;
                     SceneUtil::PositionAttitudeTransform* pat
                         = static_cast<SceneUtil::PositionAttitudeTransform*>(trans.get());
-                    pat->setPosition(nodePos);
-                    pat->setScale(nodeScale);
-                    pat->setAttitude(nodeAttitude);
+                    pat->setPosition(ref.mPosition - worldCenter);
+                    pat->setScale(osg::Vec3f(ref.mScale, ref.mScale, ref.mScale));
+                    pat->setAttitude(makeAttitude(ref));
                 }
 
-                // DO NOT COPY AND PASTE THIS CODE. Cloning osg::Geometry without also cloning its contained Arrays is
-                // generally unsafe. In this specific case the operation is safe under the following two assumptions:
-                // - When Arrays are removed or replaced in the cloned geometry, the original Arrays in their place must
-                // outlive the cloned geometry regardless. (ensured by TemplateMultiRef)
-                // - Arrays that we add or replace in the cloned geometry must be explicitely forbidden from reusing
-                // BufferObjects of the original geometry. (ensured by needvbo() in optimizer.cpp)
-                copyop.setCopyFlags(merge ? osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES
-                                          : osg::CopyOp::DEEP_COPY_NODES);
-                copyop.mDistances = lodDistances / ref.mScale;
-                copyop.copy(cnode, trans);
+                copyInstance(cnode, ref, merge, trans);
 
                 if (activeGrid)
                 {
@@ -879,7 +1180,27 @@ namespace MWRender
                 // in addition, we hint to the cache that it's still being used and should be kept in cache
                 templateRefs->addRef(cnode);
 
-                if (pair.second.mNeedCompile)
+                if (prototype != nullptr)
+                {
+                    InstancingVisitor visitor(instances, worldCenter);
+                    prototype->accept(visitor);
+                    mSceneManager->recreateShaders(prototype, "objects", mInstancingProgramTemplate);
+
+                    if (mDebugBatches)
+                    {
+                        DebugVisitor dv;
+                        prototype->accept(dv);
+                    }
+                    if (compile)
+                    {
+                        stateToCompile._mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES
+                            | osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
+                        prototype->accept(stateToCompile);
+                    }
+
+                    group->addChild(prototype);
+                }
+                else if (pair.second.mNeedCompile)
                 {
                     int mode = osgUtil::GLObjectsVisitor::COMPILE_STATE_ATTRIBUTES;
                     if (!merge)
@@ -890,21 +1211,82 @@ namespace MWRender
             }
         }
 
+        std::string diskCacheKey;
+        std::vector<osg::StateSet*> diskCacheStateSets;
+        bool mergeGroupLoaded = false;
+        if (!mergedInstances.empty())
+        {
+            std::sort(mergedInstances.begin(), mergedInstances.end(),
+                [](const MergedInstance& l, const MergedInstance& r) {
+                    return std::tie(l.mInstanceList->mModel.value(), l.mRef->mRefNum)
+                        < std::tie(r.mInstanceList->mModel.value(), r.mRef->mRefNum);
+                });
+
+            Misc::appendStringToKey(diskCacheKey, mWorldspace.serializeText());
+            Misc::appendToKey(diskCacheKey, center);
+            Misc::appendToKey(diskCacheKey, size);
+            Misc::appendToKey(diskCacheKey, lod);
+            for (const std::string& contentFile : world.getContentFiles())
+                Misc::appendStringToKey(diskCacheKey, contentFile);
+
+            CollectStateSetsVisitor stateSetsVisitor;
+            const InstanceList* previous = nullptr;
+            for (const MergedInstance& instance : mergedInstances)
+            {
+                if (instance.mInstanceList != previous)
+                {
+                    previous = instance.mInstanceList;
+                    Misc::appendStringToKey(diskCacheKey, previous->mModel.value());
+                    Misc::appendToKey(diskCacheKey, previous->mAnalyzeResult.mNumVerts);
+                    const_cast<osg::Node*>(instance.mNode)->accept(stateSetsVisitor);
+                }
+                appendToKey(diskCacheKey, instance.mRef->mRefNum);
+                Misc::appendToKey(diskCacheKey, instance.mRef->mPosition);
+                Misc::appendToKey(diskCacheKey, instance.mRef->mRotation);
+                Misc::appendToKey(diskCacheKey, instance.mRef->mScale);
+            }
+            diskCacheStateSets = std::move(stateSetsVisitor.mStateSets);
+
+            if (osg::ref_ptr<osg::Group> loaded = mDiskCache->load(diskCacheKey, diskCacheStateSets))
+            {
+                mergeGroup = std::move(loaded);
+                mergeGroupLoaded = true;
+            }
+            else
+            {
+                for (const MergedInstance& instance : mergedInstances)
+                {
+                    osg::ref_ptr<osg::Group> trans
+                        = new osg::MatrixTransform(makeInstanceMatrix(*instance.mRef, worldCenter));
+                    trans->setDataVariance(osg::Object::STATIC);
+                    copyInstance(instance.mNode, *instance.mRef, true, trans);
+                    mergeGroup->addChild(trans);
+                }
+            }
+        }
+
         const osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
 
         if (mergeGroup->getNumChildren())
         {
-            SceneUtil::Optimizer optimizer;
-            if (size > 1 / 8.f)
+            if (!mergeGroupLoaded)
             {
-                optimizer.setViewPoint(relativeViewPoint);
-                optimizer.setMergeAlphaBlending(true);
-            }
-            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
-            const unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
-                | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
+                SceneUtil::Optimizer optimizer;
+                if (size > 1 / 8.f)
+                {
+                    optimizer.setViewPoint(relativeViewPoint);
+                    optimizer.setMergeAlphaBlending(true);
+                }
+                optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+                const unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
+                    | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
 
-            optimizer.optimize(mergeGroup, options);
+                optimizer.optimize(mergeGroup, options);
+
+                // Subgraphs the cache can't represent are not stored and merged again next time
+                if (!mergedInstances.empty())
+                    mDiskCache->store(diskCacheKey, *mergeGroup, diskCacheStateSets);
+            }
 
             group->addChild(mergeGroup);
 
@@ -941,6 +1323,13 @@ namespace MWRender
         }
         udc->addUserObject(templateRefs);
 
+        ComputeMemoryVisitor memoryVisitor;
+        group->accept(memoryVisitor);
+        osg::ref_ptr<ChunkMemory> memory = new ChunkMemory;
+        memory->mBytes = memoryVisitor.mBytes;
+        memory->setName("chunkMemory");
+        udc->addUserObject(memory);
+
         return group;
     }
 
@@ -1107,6 +1496,18 @@ namespace MWRender
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Object Chunk", frameNumber, mCache->getStats(), *stats);
+
+        std::size_t memory = 0;
+        mCache->call([&](const ChunkId& /*id*/, osg::Object* obj) {
+            const osg::UserDataContainer* const udc = obj->getUserDataContainer();
+            if (udc == nullptr)
+                return;
+            if (const auto* chunkMemory = dynamic_cast<const ChunkMemory*>(udc->getUserObject("chunkMemory")))
+                memory += chunkMemory->mBytes;
+        });
+        stats->setAttribute(frameNumber, "Object Chunk Memory", static_cast<double>(memory));
+        stats->setAttribute(frameNumber, "Object Chunk Build us",
+            static_cast<double>(mBuildTime.exchange(0, std::memory_order_relaxed)));
     }
 
 }
@@ -5,6 +5,10 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+#include <osg/Program>
+
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 
 namespace Resource
@@ -12,6 +16,11 @@ namespace Resource
     class SceneManager;
 }
 
+namespace SceneUtil
+{
+    class GeometryDiskCache;
+}
+
 namespace MWRender
 {
 
@@ -20,7 +29,8 @@ namespace MWRender
     class ObjectPaging : public Resource::GenericResourceManager<ChunkId>, public Terrain::QuadTreeWorld::ChunkManager
     {
     public:
-        ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace);
+        ObjectPaging(
+            Resource::SceneManager* sceneManager, ESM::RefId worldspace, const SceneUtil::GeometryDiskCache* diskCache);
         ~ObjectPaging() = default;
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
@@ -55,6 +65,13 @@ namespace MWRender
         float mMinSize;
         float mMinSizeMergeFactor;
         float mMinSizeCostMultiplier;
+        bool mInstancing;
+        unsigned mInstancingMinVertices;
+        osg::ref_ptr<osg::Program> mInstancingProgramTemplate;
+        const SceneUtil::GeometryDiskCache* mDiskCache;
+
+        // Time spent in createChunk since the last reportStats call
+        mutable std::atomic<std::uint64_t> mBuildTime{ 0 };
 
         std::mutex mRefTrackerMutex;
         struct RefTracker
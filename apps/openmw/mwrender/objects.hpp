@@ -89,6 +89,13 @@ namespace MWRender
         /// Updates containing cell for object rendering data
         void updatePtr(const MWWorld::Ptr& old, const MWWorld::Ptr& cur);
 
+        template <class Function>
+        void forEachAnimation(Function&& function) const
+        {
+            for (const auto& [ref, animation] : mObjects)
+                function(*animation);
+        }
+
     private:
         void operator=(const Objects&);
         Objects(const Objects&);
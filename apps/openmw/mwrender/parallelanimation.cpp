@@ -0,0 +1,14 @@
+#include "parallelanimation.hpp"
+
+#include "animation.hpp"
+
+#include <components/sceneutil/paralleljobs.hpp>
+
+namespace MWRender
+{
+    void prepareKeyframes(std::span<Animation* const> animations, SceneUtil::WorkQueue& workQueue)
+    {
+        SceneUtil::runParallelJobs(
+            &workQueue, animations.size(), [&](std::size_t i) { animations[i]->prepareKeyframes(); });
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef OPENMW_MWRENDER_PARALLELANIMATION_H
+#define OPENMW_MWRENDER_PARALLELANIMATION_H
+
+#include <span>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace MWRender
+{
+    class Animation;
+
+    /// Prepares keyframes of the given animations by the calling thread and the work queue threads. Returns when all
+    /// of them are done. Each animation has to be present only once.
+    void prepareKeyframes(std::span<Animation* const> animations, SceneUtil::WorkQueue& workQueue);
+}
+
+#endif
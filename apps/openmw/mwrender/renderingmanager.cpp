@@ -31,8 +31,11 @@
 
 #include <components/sceneutil/cullsafeboundsvisitor.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/geometrydiskcache.hpp>
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/parallelskinning.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/rtt.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/stateupdater.hpp>
@@ -73,6 +76,7 @@
 #include "navmesh.hpp"
 #include "npcanimation.hpp"
 #include "objectpaging.hpp"
+#include "parallelanimation.hpp"
 #include "pathgrid.hpp"
 #include "postprocessor.hpp"
 #include "recastmesh.hpp"
@@ -170,13 +174,16 @@ namespace MWRender
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
         DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-        SceneUtil::UnrefQueue& unrefQueue)
+        SceneUtil::UnrefQueue& unrefQueue, std::unique_ptr<SceneUtil::GeometryDiskCache> chunkDiskCache,
+        std::shared_ptr<const Terrain::CompositeMapCache> compositeMapCache)
         : mSkyBlending(Settings::fog().mSkyBlending)
         , mViewer(viewer)
         , mRootNode(rootNode)
         , mResourceSystem(resourceSystem)
         , mWorkQueue(workQueue)
         , mNavigator(navigator)
+        , mChunkDiskCache(std::move(chunkDiskCache))
+        , mCompositeMapCache(std::move(compositeMapCache))
         , mNightEyeFactor(0.f)
         // TODO: Near clip should not need to be bounded like this, but too small values break OSG shadow calculations
         // CPU-side. See issue: #6072
@@ -254,6 +261,7 @@ namespace MWRender
         globalDefines["exponentialFog"] = exponentialFog ? "1" : "0";
         globalDefines["skyBlending"] = mSkyBlending ? "1" : "0";
         globalDefines["particlePointLighting"] = Settings::shaders().mParticlePointLighting ? "1" : "0";
+        globalDefines["terrainCompactVertices"] = Settings::terrain().mCompactVertices ? "1" : "0";
 
         for (auto itr = lightDefines.begin(); itr != lightDefines.end(); itr++)
             globalDefines[itr->first] = itr->second;
@@ -317,6 +325,11 @@ namespace MWRender
                 Shader::ShaderManager::Slot::OpaqueDepthTexture));
         rootNode->addCullCallback(mPerViewUniformStateUpdater);
 
+        if (Settings::general().mParallelSkinning)
+            rootNode->addCullCallback(new SceneUtil::ParallelSkinningCallback(mWorkQueue));
+        SceneUtil::RigGeometry::setSkinningLod(Settings::general().mSkinningLodDistance,
+            static_cast<unsigned>(Settings::general().mSkinningLodInterval.get()));
+
         mPostProcessor = new PostProcessor(*this, viewer, mRootNode, resourceSystem->getVFS());
         resourceSystem->getSceneManager()->setOpaqueDepthTex(
             mPostProcessor->getTexture(PostProcessor::Tex_OpaqueDepth, 0),
@@ -757,6 +770,23 @@ namespace MWRender
         mPostProcessor->setUnderwaterFlag(isUnderwater);
     }
 
+    void RenderingManager::prepareAnimations()
+    {
+        if (!Settings::general().mParallelAnimationUpdate)
+            return;
+
+        mPreparedAnimations.clear();
+        mObjects->forEachAnimation([&](Animation& animation) {
+            if (animation.hasActiveKeyframes())
+                mPreparedAnimations.push_back(&animation);
+        });
+        // Player animation is not a part of the objects
+        if (mPlayerAnimation != nullptr && mPlayerAnimation->hasActiveKeyframes())
+            mPreparedAnimations.push_back(mPlayerAnimation.get());
+
+        prepareKeyframes(mPreparedAnimations, *mWorkQueue);
+    }
+
     void RenderingManager::updatePlayerPtr(const MWWorld::Ptr& ptr)
     {
         if (mPlayerAnimation.get())
@@ -1290,10 +1320,11 @@ namespace MWRender
             auto quadTreeWorld = std::make_unique<Terrain::QuadTreeWorld>(mSceneRoot, mRootNode, mResourceSystem,
                 mTerrainStorage.get(), Mask_Terrain, Mask_PreCompile, Mask_Debug, compMapResolution, compMapLevel,
                 lodFactor, vertexLodMod, maxCompGeometrySize, debugChunks, worldspace, expiryDelay);
+            quadTreeWorld->setWorkQueue(mWorkQueue);
             if (Settings::terrain().mObjectPaging)
             {
-                newChunkMgr.mObjectPaging
-                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace);
+                newChunkMgr.mObjectPaging = std::make_unique<ObjectPaging>(
+                    mResourceSystem->getSceneManager(), worldspace, mChunkDiskCache.get());
                 quadTreeWorld->addChunkManager(newChunkMgr.mObjectPaging.get());
                 mResourceSystem->addResourceManager(newChunkMgr.mObjectPaging.get());
             }
@@ -1314,6 +1345,9 @@ namespace MWRender
                 mTerrainStorage.get(), Mask_Terrain, worldspace, expiryDelay, Mask_PreCompile, Mask_Debug);
 
         newChunkMgr.mTerrain->setTargetFrameRate(Settings::cells().mTargetFramerate);
+        newChunkMgr.mTerrain->setCompactVertices(Settings::terrain().mCompactVertices);
+        if (mCompositeMapCache)
+            newChunkMgr.mTerrain->setCompositeMapCache(mCompositeMapCache, mWorkQueue);
         float distanceMult = std::cos(osg::DegreesToRadians(std::min(mFieldOfView, 140.f)) / 2.f);
         newChunkMgr.mTerrain->setViewDistance(mViewDistance * (distanceMult ? 1.f / distanceMult : 1.f));
         newChunkMgr.mTerrain->enableHeightCullCallback(Settings::terrain().mWaterCulling);
@@ -1325,9 +1359,12 @@ namespace MWRender
     {
         osg::Stats* stats = mViewer->getViewerStats();
         unsigned int frameNumber = mViewer->getFrameStamp()->getFrameNumber();
+        const SceneUtil::RigGeometry::SkinningStats skinning = SceneUtil::RigGeometry::takeSkinningStats();
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            stats->setAttribute(frameNumber, "Skinning Performed", static_cast<double>(skinning.mPerformed));
+            stats->setAttribute(frameNumber, "Skinning Skipped", static_cast<double>(skinning.mSkipped));
         }
     }
 
@@ -16,6 +16,7 @@
 #include <memory>
 #include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace osg
 {
@@ -49,6 +50,7 @@ namespace ESM
 namespace Terrain
 {
     class World;
+    class CompositeMapCache;
 }
 
 namespace Fallback
@@ -66,6 +68,7 @@ namespace SceneUtil
     class SharedUniformStateUpdater;
     class StateUpdater;
     class Light;
+    class GeometryDiskCache;
 }
 
 namespace DetourNavigator
@@ -113,7 +116,8 @@ namespace MWRender
         RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
             Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
             DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-            SceneUtil::UnrefQueue& unrefQueue);
+            SceneUtil::UnrefQueue& unrefQueue, std::unique_ptr<SceneUtil::GeometryDiskCache> chunkDiskCache,
+            std::shared_ptr<const Terrain::CompositeMapCache> compositeMapCache);
         ~RenderingManager();
 
         osgUtil::IncrementalCompileOperation* getIncrementalCompileOperation();
@@ -209,6 +213,9 @@ namespace MWRender
 
         void update(float dt, bool paused);
 
+        /// Samples keyframes of all animated objects in parallel before the update traversal.
+        void prepareAnimations();
+
         Animation* getAnimation(const MWWorld::Ptr& ptr);
         const Animation* getAnimation(const MWWorld::ConstPtr& ptr) const;
 
@@ -330,6 +337,8 @@ namespace MWRender
         std::unique_ptr<Pathgrid> mPathgrid;
         std::unique_ptr<Objects> mObjects;
         std::unique_ptr<Water> mWater;
+        std::unique_ptr<SceneUtil::GeometryDiskCache> mChunkDiskCache;
+        std::shared_ptr<const Terrain::CompositeMapCache> mCompositeMapCache;
         std::unordered_map<ESM::RefId, WorldspaceChunkMgr> mWorldspaceChunks;
         Terrain::World* mTerrain;
         std::unique_ptr<TerrainStorage> mTerrainStorage;
@@ -342,6 +351,7 @@ namespace MWRender
         std::unique_ptr<SceneUtil::ShadowManager> mShadowManager;
         osg::ref_ptr<PostProcessor> mPostProcessor;
         osg::ref_ptr<NpcAnimation> mPlayerAnimation;
+        std::vector<Animation*> mPreparedAnimations;
         osg::ref_ptr<SceneUtil::PositionAttitudeTransform> mPlayerNode;
         std::unique_ptr<Camera> mCamera;
         osg::ref_ptr<Debug::DebugDrawer> mDebugDraw;
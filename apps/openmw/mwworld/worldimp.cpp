@@ -38,9 +38,12 @@
 
 #include <components/files/collections.hpp>
 
+#include <components/resource/bulletbvhcache.hpp>
 #include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 
+#include <components/sceneutil/geometrydiskcache.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/workqueue.hpp>
@@ -57,6 +60,8 @@
 
 #include <components/settings/values.hpp>
 
+#include <components/terrain/compositemapcache.hpp>
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/luamanager.hpp"
 #include "../mwbase/mechanicsmanager.hpp"
@@ -233,6 +238,9 @@ namespace MWWorld
         SceneUtil::WorkQueue* workQueue, SceneUtil::UnrefQueue& unrefQueue)
     {
         mPhysics = std::make_unique<MWPhysics::PhysicsSystem>(mResourceSystem, rootNode);
+        mPhysics->getShapeManager()->setWorkQueue(workQueue);
+        if (Settings::physics().mEnableBvhDiskCache)
+            mPhysics->getShapeManager()->setBvhCache(std::make_unique<Resource::BulletBvhCache>(mUserDataPath / "bvh"));
 
         if (Settings::navigator().mEnable)
         {
@@ -245,8 +253,14 @@ namespace MWWorld
             mNavigator = DetourNavigator::makeNavigatorStub();
         }
 
-        mRendering = std::make_unique<MWRender::RenderingManager>(
-            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, unrefQueue);
+        std::unique_ptr<SceneUtil::GeometryDiskCache> chunkDiskCache;
+        if (Settings::terrain().mObjectPagingDiskCache)
+            chunkDiskCache = std::make_unique<SceneUtil::GeometryDiskCache>(mUserDataPath / "chunks");
+        std::shared_ptr<Terrain::CompositeMapCache> compositeMapCache;
+        if (Settings::terrain().mCompositeMapDiskCache)
+            compositeMapCache = std::make_shared<Terrain::CompositeMapCache>(mUserDataPath / "composite");
+        mRendering = std::make_unique<MWRender::RenderingManager>(viewer, rootNode, mResourceSystem, workQueue,
+            *mNavigator, mGroundcoverStore, unrefQueue, std::move(chunkDiskCache), std::move(compositeMapCache));
         mProjectileManager = std::make_unique<ProjectileManager>(
             mRendering->getLightRoot()->asGroup(), mResourceSystem, mRendering.get(), mPhysics.get());
         mRendering->preloadCommonAssets();
@@ -1675,6 +1689,11 @@ namespace MWWorld
         MWBase::Environment::get().getSoundManager()->setListenerPosDir(listenerPos, forward, up, underwater);
     }
 
+    void World::prepareAnimations()
+    {
+        mRendering->prepareAnimations();
+    }
+
     void World::updateFocusObject()
     {
         try
@@ -421,6 +421,8 @@ namespace MWWorld
 
         void updateFocusObject();
 
+        void prepareAnimations();
+
         MWWorld::Ptr placeObject(
             const MWWorld::Ptr& object, float cursorX, float cursorY, int amount, bool copy = true) override;
         ///< copy and place an object into the gameworld at the specified cursor position
@@ -37,6 +37,7 @@ namespace OMW
         PhysicsWorker,
         World,
         Gui,
+        Animation,
         Focus,
         Lua,
         Number,
@@ -75,6 +76,9 @@ namespace OMW
     template <>
     inline const UserStats UserStatsValue<UserStatsType::Gui>::sValue{ "GUI", "gui" };
 
+    template <>
+    inline const UserStats UserStatsValue<UserStatsType::Animation>::sValue{ "Anim", "animation" };
+
     template <>
     inline const UserStats UserStatsValue<UserStatsType::Lua>::sValue{ "Lua", "lua" };
 
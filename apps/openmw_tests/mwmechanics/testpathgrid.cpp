@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include "apps/openmw/mwmechanics/pathgrid.hpp"
+
+namespace MWMechanics
+{
+    namespace
+    {
+        void connect(ESM::Pathgrid& pathgrid, std::size_t a, std::size_t b)
+        {
+            pathgrid.mEdges.push_back(ESM::Pathgrid::Edge{ a, b });
+            pathgrid.mEdges.push_back(ESM::Pathgrid::Edge{ b, a });
+        }
+
+        ESM::Pathgrid makeLine(int size)
+        {
+            ESM::Pathgrid result;
+            for (int i = 0; i < size; ++i)
+                result.mPoints.emplace_back(i * 100, 0, 0);
+            for (int i = 1; i < size; ++i)
+                connect(result, static_cast<std::size_t>(i - 1), static_cast<std::size_t>(i));
+            return result;
+        }
+
+        std::vector<int> getXs(const std::deque<ESM::Pathgrid::Point>& path)
+        {
+            std::vector<int> result;
+            for (const ESM::Pathgrid::Point& point : path)
+                result.push_back(point.mX);
+            return result;
+        }
+
+        struct MWMechanicsPathgridGraphSizeTest : ::testing::TestWithParam<int>
+        {
+        };
+
+        TEST_P(MWMechanicsPathgridGraphSizeTest, aStarSearchShouldReturnAllPointsBetweenStartAndEnd)
+        {
+            const int size = GetParam();
+            const ESM::Pathgrid pathgrid = makeLine(size);
+            const PathgridGraph graph(pathgrid);
+            const std::deque<ESM::Pathgrid::Point> path = graph.aStarSearch(0, static_cast<std::size_t>(size - 1));
+            ASSERT_EQ(path.size(), static_cast<std::size_t>(size));
+            for (int i = 0; i < size; ++i)
+                EXPECT_EQ(path[static_cast<std::size_t>(i)].mX, i * 100);
+        }
+
+        TEST_P(MWMechanicsPathgridGraphSizeTest, aStarSearchShouldReturnSamePathForRepeatedSearch)
+        {
+            const int size = GetParam();
+            const ESM::Pathgrid pathgrid = makeLine(size);
+            const PathgridGraph graph(pathgrid);
+            const std::size_t end = static_cast<std::size_t>(size / 2);
+            const std::vector<int> first = getXs(graph.aStarSearch(static_cast<std::size_t>(size - 1), end));
+            const std::vector<int> second = getXs(graph.aStarSearch(static_cast<std::size_t>(size - 1), end));
+            EXPECT_EQ(first, second);
+            EXPECT_EQ(first.size(), static_cast<std::size_t>(size - size / 2));
+        }
+
+        INSTANTIATE_TEST_SUITE_P(SmallAndLargePathgrids, MWMechanicsPathgridGraphSizeTest, ::testing::Values(8, 300));
+
+        TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnCheapestPath)
+        {
+            ESM::Pathgrid pathgrid;
+            pathgrid.mPoints.emplace_back(0, 0, 0);
+            pathgrid.mPoints.emplace_back(100, 0, 0);
+            pathgrid.mPoints.emplace_back(200, 0, 0);
+            pathgrid.mPoints.emplace_back(100, 1000, 0);
+            connect(pathgrid, 0, 1);
+            connect(pathgrid, 1, 2);
+            connect(pathgrid, 0, 3);
+            connect(pathgrid, 3, 2);
+            const PathgridGraph graph(pathgrid);
+            EXPECT_EQ(getXs(graph.aStarSearch(0, 2)), (std::vector<int>{ 0, 100, 200 }));
+        }
+
+        TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnEmptyPathForNotConnectedPoints)
+        {
+            ESM::Pathgrid pathgrid;
+            pathgrid.mPoints.emplace_back(0, 0, 0);
+            pathgrid.mPoints.emplace_back(100, 0, 0);
+            pathgrid.mPoints.emplace_back(200, 0, 0);
+            connect(pathgrid, 0, 1);
+            const PathgridGraph graph(pathgrid);
+            EXPECT_TRUE(graph.aStarSearch(0, 2).empty());
+        }
+
+        TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnStartForSameStartAndEnd)
+        {
+            const ESM::Pathgrid pathgrid = makeLine(3);
+            const PathgridGraph graph(pathgrid);
+            EXPECT_EQ(getXs(graph.aStarSearch(1, 1)), std::vector<int>{ 100 });
+        }
+    }
+}
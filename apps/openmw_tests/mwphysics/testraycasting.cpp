@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <components/settings/values.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "apps/openmw/mwphysics/mtphysics.hpp"
+#include "apps/openmw/mwphysics/raycasting.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        struct MWPhysicsCastRayTest : ::testing::Test
+        {
+            btDefaultCollisionConfiguration mConfiguration;
+            btCollisionDispatcher mDispatcher{ &mConfiguration };
+            btDbvtBroadphase mBroadphase;
+            btCollisionWorld mWorld{ &mDispatcher, &mBroadphase, &mConfiguration };
+            btBoxShape mShape{ btVector3(50, 50, 50) };
+            std::vector<std::unique_ptr<btCollisionObject>> mObjects;
+
+            MWPhysicsCastRayTest()
+            {
+                for (int x = 0; x < 8; ++x)
+                    for (int y = 0; y < 8; ++y)
+                        addBox(btVector3(x * 300.0f, y * 300.0f, static_cast<float>((x + y) % 3) * 40.0f));
+                mWorld.updateAabbs();
+            }
+
+            ~MWPhysicsCastRayTest()
+            {
+                for (const auto& object : mObjects)
+                    mWorld.removeCollisionObject(object.get());
+            }
+
+            btCollisionObject& addBox(const btVector3& position)
+            {
+                auto object = std::make_unique<btCollisionObject>();
+                object->setCollisionShape(&mShape);
+                object->setWorldTransform(btTransform(btMatrix3x3::getIdentity(), position));
+                mWorld.addCollisionObject(object.get(), CollisionType_World, CollisionType_Default);
+                return *mObjects.emplace_back(std::move(object));
+            }
+
+            std::vector<RayCastingRequest> makeRequests() const
+            {
+                std::vector<RayCastingRequest> result;
+                for (int x = 0; x < 8; ++x)
+                {
+                    for (int y = 0; y < 8; ++y)
+                    {
+                        const osg::Vec3f center(x * 300.0f + 17.0f, y * 300.0f - 23.0f, 0);
+                        result.push_back(RayCastingRequest{
+                            .mFrom = center + osg::Vec3f(0, 0, 500), .mTo = center - osg::Vec3f(0, 0, 500) });
+                        result.push_back(RayCastingRequest{
+                            .mFrom = center + osg::Vec3f(-400, 0, 10), .mTo = center + osg::Vec3f(400, 70, 10) });
+                        result.push_back(RayCastingRequest{ .mFrom = center + osg::Vec3f(0, 0, 500),
+                            .mTo = center - osg::Vec3f(0, 0, 500),
+                            .mRadius = 20 });
+                        result.push_back(RayCastingRequest{ .mFrom = center + osg::Vec3f(150, 150, 500),
+                            .mTo = center + osg::Vec3f(150, 150, -500) });
+                    }
+                }
+                return result;
+            }
+        };
+
+        TEST_F(MWPhysicsCastRayTest, shouldHitNearestObject)
+        {
+            const RayCastingResult result = castRay(mWorld,
+                RayCastingRequest{ .mFrom = osg::Vec3f(-200, 0, 0), .mTo = osg::Vec3f(1000, 0, 0) }, {}, {});
+            ASSERT_TRUE(result.mHit);
+            EXPECT_FLOAT_EQ(result.mHitPos.x(), -50);
+            EXPECT_FLOAT_EQ(result.mHitNormal.x(), -1);
+        }
+
+        TEST_F(MWPhysicsCastRayTest, shouldSkipIgnoredObjects)
+        {
+            const btCollisionObject* ignore[] = { mObjects.front().get() };
+            const RayCastingResult result = castRay(mWorld,
+                RayCastingRequest{ .mFrom = osg::Vec3f(-200, 0, 0), .mTo = osg::Vec3f(1000, 0, 0) }, ignore, {});
+            ASSERT_TRUE(result.mHit);
+            EXPECT_FLOAT_EQ(result.mHitPos.x(), 250);
+        }
+
+        TEST_F(MWPhysicsCastRayTest, shouldNotHitAnythingForRayOfZeroLength)
+        {
+            const RayCastingResult result
+                = castRay(mWorld, RayCastingRequest{ .mFrom = osg::Vec3f(), .mTo = osg::Vec3f() }, {}, {});
+            EXPECT_FALSE(result.mHit);
+        }
+
+        TEST_F(MWPhysicsCastRayTest, queryBatchShouldGiveSameResultsAsSequentialCasts)
+        {
+            const std::vector<RayCastingRequest> requests = makeRequests();
+
+            std::vector<RayCastingResult> expected;
+            for (const RayCastingRequest& request : requests)
+                expected.push_back(castRay(mWorld, request, {}, {}));
+
+            // Concurrent queries are possible only when Bullet is built with multithreading support
+            const std::size_t maxSupportedThreads = mBroadphase.m_rayTestStacks.size();
+            const unsigned threads = std::clamp<unsigned>(4, 1, static_cast<unsigned>(maxSupportedThreads));
+            // Calling thread takes part in the batch too
+            Settings::physics().mAsyncNumThreads.set(static_cast<int>(threads - 1));
+            std::vector<RayCastingResult> results(requests.size());
+            {
+                PhysicsTaskScheduler scheduler(1.0f / 60, &mWorld, nullptr, nullptr);
+                scheduler.queryBatch(requests.size(),
+                    [&](std::size_t i) { results[i] = castRay(mWorld, requests[i], {}, {}); });
+            }
+            Settings::physics().mAsyncNumThreads.reset();
+
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < requests.size(); ++i)
+            {
+                ASSERT_EQ(results[i].mHit, expected[i].mHit) << i;
+                if (!expected[i].mHit)
+                    continue;
+                ++hits;
+                EXPECT_EQ(results[i].mHitPos, expected[i].mHitPos) << i;
+                EXPECT_EQ(results[i].mHitNormal, expected[i].mHitNormal) << i;
+            }
+            EXPECT_GT(hits, 0u);
+            EXPECT_LT(hits, requests.size());
+        }
+    }
+}
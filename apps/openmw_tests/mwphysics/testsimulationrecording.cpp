@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <components/testing/util.hpp>
+
+#include <filesystem>
+#include <vector>
+
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/simulationrecording.hpp"
+#include "apps/openmw/mwphysics/simulationreplay.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct MWPhysicsSimulationRecordingTest : Test
+        {
+            btDefaultCollisionConfiguration mConfiguration;
+            btCollisionDispatcher mDispatcher{ &mConfiguration };
+            btDbvtBroadphase mBroadphase;
+            btCollisionWorld mWorld{ &mDispatcher, &mBroadphase, &mConfiguration };
+            btBoxShape mFloorShape{ btVector3(1000, 1000, 50) };
+            btBoxShape mWallShape{ btVector3(50, 500, 200) };
+            btCollisionObject mFloor;
+            btCollisionObject mWall;
+            const std::filesystem::path mPath = TestingOpenMW::outputFilePath("physics_recording.bin");
+            std::vector<Simulation> mSimulations;
+
+            MWPhysicsSimulationRecordingTest()
+            {
+                mFloor.setCollisionShape(&mFloorShape);
+                mFloor.setWorldTransform(btTransform(btMatrix3x3::getIdentity(), btVector3(0, 0, -50)));
+                mWall.setCollisionShape(&mWallShape);
+                mWall.setWorldTransform(btTransform(btMatrix3x3::getIdentity(), btVector3(300, 0, 200)));
+                mWorld.addCollisionObject(&mFloor, CollisionType_HeightMap, CollisionType_Actor);
+                mWorld.addCollisionObject(&mWall, CollisionType_World, CollisionType_Actor);
+            }
+
+            ~MWPhysicsSimulationRecordingTest()
+            {
+                if (mFloor.getBroadphaseHandle() != nullptr)
+                    mWorld.removeCollisionObject(&mFloor);
+                mWorld.removeCollisionObject(&mWall);
+            }
+
+            void recordFrame(SimulationRecorder& recorder)
+            {
+                recorder.beginFrame(4, 1.0f / 60, WorldFrameData(false, osg::Vec3f()), mSimulations);
+                recorder.endFrame(mSimulations);
+            }
+
+            static std::vector<osg::Vec3f> getTriangles(const btCollisionObject& object)
+            {
+                std::vector<osg::Vec3f> result;
+                collectTriangles(*object.getCollisionShape(), object.getWorldTransform(), result);
+                return result;
+            }
+
+            static RecordedActor makeActor()
+            {
+                constexpr float halfExtentsZ = 66;
+                const osg::Vec3f position(-300, 0, 0);
+                return RecordedActor{
+                    .mId = 0,
+                    .mShape = RecordedActorShape::Box,
+                    .mHalfExtents = osg::Vec3f(29, 28, halfExtentsZ),
+                    .mMargin = 0.001f,
+                    .mCollisionObjectPosition = position + osg::Vec3f(0, 0, halfExtentsZ),
+                    .mCollisionObjectRotation = osg::Quat(),
+                    .mCollisionGroup = CollisionType_Actor,
+                    .mCollisionMask = CollisionType_Default,
+                    .mPosition = position,
+                    .mIsOnGround = true,
+                    .mSwimLevel = -1000,
+                    .mSlowFall = 1,
+                    .mRotation = osg::Vec2f(0, 1.5f),
+                    .mMovement = osg::Vec3f(0, 300, 0),
+                    .mWaterlevel = -1000,
+                    .mHalfExtentsZ = halfExtentsZ,
+                    .mOldHeight = position.z(),
+                    .mWasOnGround = true,
+                };
+            }
+        };
+
+        TEST_F(MWPhysicsSimulationRecordingTest, first_frame_should_contain_whole_world)
+        {
+            {
+                SimulationRecorder recorder(mPath);
+                recorder.addObject(mFloor);
+                recorder.addObject(mWall);
+                recordFrame(recorder);
+            }
+
+            const std::vector<RecordedFrame> frames = readSimulationRecording(mPath);
+
+            ASSERT_EQ(frames.size(), 1);
+            EXPECT_EQ(frames[0].mSteps, 4);
+            EXPECT_EQ(frames[0].mPhysicsDt, 1.0f / 60);
+            EXPECT_TRUE(frames[0].mResetWorld);
+            EXPECT_THAT(frames[0].mRemovedObjects, IsEmpty());
+            ASSERT_EQ(frames[0].mWorld.size(), 2);
+            EXPECT_EQ(frames[0].mWorld[0].mId, 0);
+            EXPECT_EQ(frames[0].mWorld[0].mCollisionGroup, CollisionType_HeightMap);
+            EXPECT_EQ(frames[0].mWorld[0].mCollisionMask, CollisionType_Actor);
+            EXPECT_EQ(frames[0].mWorld[0].mTriangles, getTriangles(mFloor));
+            EXPECT_EQ(frames[0].mWorld[1].mId, 1);
+            EXPECT_EQ(frames[0].mWorld[1].mCollisionGroup, CollisionType_World);
+            EXPECT_EQ(frames[0].mWorld[1].mTriangles, getTriangles(mWall));
+        }
+
+        TEST_F(MWPhysicsSimulationRecordingTest, next_frames_should_contain_only_changed_objects)
+        {
+            {
+                SimulationRecorder recorder(mPath);
+                recorder.addObject(mFloor);
+                recorder.addObject(mWall);
+                recordFrame(recorder);
+                recordFrame(recorder);
+                mWall.getWorldTransform().setOrigin(btVector3(400, 0, 200));
+                recorder.updateObject(mWall);
+                mWorld.removeCollisionObject(&mFloor);
+                recorder.removeObject(mFloor);
+                recordFrame(recorder);
+            }
+
+            const std::vector<RecordedFrame> frames = readSimulationRecording(mPath);
+
+            ASSERT_EQ(frames.size(), 3);
+            EXPECT_FALSE(frames[1].mResetWorld);
+            EXPECT_THAT(frames[1].mWorld, IsEmpty());
+            EXPECT_THAT(frames[1].mRemovedObjects, IsEmpty());
+            EXPECT_FALSE(frames[2].mResetWorld);
+            EXPECT_THAT(frames[2].mRemovedObjects, ElementsAre(0));
+            ASSERT_EQ(frames[2].mWorld.size(), 1);
+            EXPECT_EQ(frames[2].mWorld[0].mId, 1);
+            EXPECT_EQ(frames[2].mWorld[0].mTriangles, getTriangles(mWall));
+        }
+
+        TEST_F(MWPhysicsSimulationRecordingTest, replay_of_recorded_frame_should_match_replay_of_original_world)
+        {
+            {
+                SimulationRecorder recorder(mPath);
+                recorder.addObject(mFloor);
+                recorder.addObject(mWall);
+                recordFrame(recorder);
+            }
+            std::vector<RecordedFrame> frames = readSimulationRecording(mPath);
+            ASSERT_EQ(frames.size(), 1);
+            RecordedFrame& recorded = frames[0];
+            recorded.mActors.push_back(makeActor());
+
+            RecordedFrame original;
+            original.mSteps = 4;
+            original.mPhysicsDt = 1.0f / 60;
+            original.mResetWorld = true;
+            original.mWorld.push_back(RecordedObject{ .mId = 0,
+                .mCollisionGroup = CollisionType_HeightMap,
+                .mCollisionMask = CollisionType_Actor,
+                .mTriangles = getTriangles(mFloor) });
+            original.mWorld.push_back(RecordedObject{ .mId = 1,
+                .mCollisionGroup = CollisionType_World,
+                .mCollisionMask = CollisionType_Actor,
+                .mTriangles = getTriangles(mWall) });
+            original.mActors.push_back(makeActor());
+
+            SimulationReplay replay(1);
+            const std::vector<osg::Vec3f> expected = replay.replay(original, 1);
+            const std::vector<osg::Vec3f> result = replay.replay(recorded, 1);
+
+            ASSERT_EQ(expected.size(), 1);
+            EXPECT_NE(expected[0], original.mActors[0].mPosition);
+            EXPECT_EQ(result, expected);
+        }
+    }
+}
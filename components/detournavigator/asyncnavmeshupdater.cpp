@@ -29,6 +29,12 @@ namespace DetourNavigator
 {
     namespace
     {
+        // Only tiles with moved objects are stored so there is no need for a large limit
+        constexpr std::size_t maxStaticLayerCacheItems = 128;
+
+        // Actors repeat path requests while they need a path so short duration is enough
+        constexpr std::chrono::seconds priorityTileDuration(5);
+
         int getManhattanDistance(const TilePosition& lhs, const TilePosition& rhs)
         {
             return std::abs(lhs.x() - rhs.x()) + std::abs(lhs.y() - rhs.y());
@@ -128,6 +134,7 @@ namespace DetourNavigator
         , mNavMeshCacheItem(std::move(navMeshCacheItem))
         , mWorldspace(worldspace)
         , mChangedTile(changedTile)
+        , mPostTime(std::chrono::steady_clock::now())
         , mProcessTime(processTime)
         , mChangeType(changeType)
     {
@@ -155,16 +162,35 @@ namespace DetourNavigator
         ++mSize;
     }
 
-    std::optional<JobIt> SpatialJobQueue::pop(TilePosition playerTile)
+    std::optional<JobIt> SpatialJobQueue::pop(TilePosition playerTile, const PriorityTiles& priorityTiles)
     {
+        UpdatingMap::iterator priorityIt = mValues.end();
+
+        for (const auto& [tile, expiration] : priorityTiles)
+        {
+            const auto it = mValues.find(tile);
+            if (it == mValues.end())
+                continue;
+            if (priorityIt == mValues.end()
+                || getManhattanDistance(tile, playerTile) < getManhattanDistance(priorityIt->first, playerTile))
+                priorityIt = it;
+        }
+
+        if (priorityIt != mValues.end())
+            return pop(priorityIt);
+
         const IndexPoint point(playerTile.x(), playerTile.y());
         const auto it = mIndex.qbegin(boost::geometry::index::nearest(point, 1));
 
         if (it == mIndex.qend())
             return std::nullopt;
 
-        const UpdatingMap::iterator mapIt = it->second;
-        std::deque<JobIt>& tileJobs = mapIt->second;
+        return pop(it->second);
+    }
+
+    JobIt SpatialJobQueue::pop(UpdatingMap::iterator it)
+    {
+        std::deque<JobIt>& tileJobs = it->second;
         JobIt result = tileJobs.front();
         tileJobs.pop_front();
 
@@ -172,8 +198,8 @@ namespace DetourNavigator
 
         if (tileJobs.empty())
         {
-            mValues.erase(mapIt);
-            mIndex.remove(*it);
+            mIndex.remove(IndexValue(IndexPoint(it->first.x(), it->first.y()), it));
+            mValues.erase(it);
         }
 
         return result;
@@ -212,6 +238,7 @@ namespace DetourNavigator
         mRemoving.clear();
         mDelayed.clear();
         mUpdating.clear();
+        mPriorityTiles.clear();
     }
 
     void JobQueue::push(JobIt job, std::chrono::steady_clock::time_point now)
@@ -240,7 +267,9 @@ namespace DetourNavigator
             return result;
         }
 
-        if (const std::optional<JobIt> result = mUpdating.pop(playerTile))
+        std::erase_if(mPriorityTiles, [&](const auto& v) { return v.second <= now; });
+
+        if (const std::optional<JobIt> result = mUpdating.pop(playerTile, mPriorityTiles))
             return result;
 
         if (mDelayed.empty() || mDelayed.front()->mProcessTime > now)
@@ -253,8 +282,16 @@ namespace DetourNavigator
 
     void JobQueue::update(TilePosition playerTile, int maxTiles, std::chrono::steady_clock::time_point now)
     {
+        const std::size_t removing = mRemoving.size();
+
         mUpdating.update(playerTile, maxTiles, mRemoving);
 
+        mCancelled += mRemoving.size() - removing;
+
+        std::erase_if(mPriorityTiles, [&](const auto& v) {
+            return v.second <= now || !shouldAddTile(v.first, playerTile, maxTiles);
+        });
+
         while (!mDelayed.empty() && mDelayed.front()->mProcessTime <= now)
         {
             const JobIt job = mDelayed.front();
@@ -268,10 +305,16 @@ namespace DetourNavigator
             {
                 job->mChangeType = ChangeType::remove;
                 mRemoving.push_back(job);
+                ++mCancelled;
             }
         }
     }
 
+    void JobQueue::prioritize(const TilePosition& tile, std::chrono::steady_clock::time_point expiration)
+    {
+        mPriorityTiles.insert_or_assign(tile, expiration);
+    }
+
     AsyncNavMeshUpdater::AsyncNavMeshUpdater(const Settings& settings, TileCachedRecastMeshManager& recastMeshManager,
         OffMeshConnectionsManager& offMeshConnectionsManager, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
@@ -279,6 +322,7 @@ namespace DetourNavigator
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mStaticLayerCache(maxStaticLayerCacheItems)
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -347,6 +391,15 @@ namespace DetourNavigator
             mDbWorker->update(playerTile);
     }
 
+    void AsyncNavMeshUpdater::prioritize(std::span<const TilePosition> tiles)
+    {
+        const std::chrono::steady_clock::time_point expiration
+            = std::chrono::steady_clock::now() + priorityTileDuration;
+        const std::lock_guard lock(mMutex);
+        for (const TilePosition& tile : tiles)
+            mWaiting.prioritize(tile, expiration);
+    }
+
     void AsyncNavMeshUpdater::wait(WaitConditionType waitConditionType, Loading::Listener* listener)
     {
         switch (waitConditionType)
@@ -438,11 +491,13 @@ namespace DetourNavigator
             result.mJobs = mJobs.size();
             result.mWaiting = mWaiting.getStats();
             result.mPushed = mPushed.size();
+            result.mWaitTime = mWaitTime;
         }
         result.mProcessing = mProcessingTiles.lockConst()->size();
         if (mDbWorker != nullptr)
             result.mDb = mDbWorker->getStats();
         result.mCache = mNavMeshTilesCache.getStats();
+        result.mStaticLayerCache = mStaticLayerCache.getStats();
         result.mDbGetTileHits = mDbGetTileHits.load(std::memory_order_relaxed);
         result.mPosted = mPostedCount.load(std::memory_order_relaxed);
         return result;
@@ -579,8 +634,8 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData = prepareNavMeshTileData(
-                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(*recastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, &mStaticLayerCache);
 
             if (preparedNavMeshData == nullptr)
             {
@@ -631,8 +686,8 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData = prepareNavMeshTileData(
-                *job.mRecastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(*job.mRecastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, &mStaticLayerCache);
             generatedNavMeshData = true;
         }
 
@@ -738,9 +793,11 @@ namespace DetourNavigator
             return mJobs.end();
         }
 
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
         if (job->mChangeType == ChangeType::update)
-            mLastUpdates[getAgentAndTile(*job)] = std::chrono::steady_clock::now();
+            mLastUpdates[getAgentAndTile(*job)] = now;
         mPushed.erase(getAgentAndTile(*job));
+        reportWaitTime(*job, now);
 
         return job;
     }
@@ -764,6 +821,22 @@ namespace DetourNavigator
             mProcessed.notify_all();
     }
 
+    void AsyncNavMeshUpdater::reportWaitTime(const Job& job, std::chrono::steady_clock::time_point now)
+    {
+        using namespace std::chrono_literals;
+        const auto waitTime = now - job.mPostTime;
+        if (waitTime < 10ms)
+            ++mWaitTime.mLess10Ms;
+        else if (waitTime < 100ms)
+            ++mWaitTime.mLess100Ms;
+        else if (waitTime < 1s)
+            ++mWaitTime.mLess1S;
+        else if (waitTime < 10s)
+            ++mWaitTime.mLess10S;
+        else
+            ++mWaitTime.mMore10S;
+    }
+
     std::size_t AsyncNavMeshUpdater::getTotalJobs() const
     {
         const std::scoped_lock lock(mMutex);
@@ -9,6 +9,7 @@
 #include "navmeshtilescache.hpp"
 #include "offmeshconnectionsmanager.hpp"
 #include "sharednavmeshcacheitem.hpp"
+#include "staticlayercache.hpp"
 #include "stats.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
 #include "tileposition.hpp"
@@ -23,10 +24,12 @@
 #include <deque>
 #include <iosfwd>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <set>
+#include <span>
 #include <thread>
 #include <tuple>
 
@@ -52,6 +55,7 @@ namespace DetourNavigator
         const std::weak_ptr<GuardedNavMeshCacheItem> mNavMeshCacheItem;
         const ESM::RefId mWorldspace;
         const TilePosition mChangedTile;
+        const std::chrono::steady_clock::time_point mPostTime;
         std::chrono::steady_clock::time_point mProcessTime;
         ChangeType mChangeType;
         JobState mState = JobState::Initial;
@@ -67,6 +71,9 @@ namespace DetourNavigator
 
     using JobIt = std::list<Job>::iterator;
 
+    // Tiles requested by actors mapped to the time when request expires
+    using PriorityTiles = std::map<TilePosition, std::chrono::steady_clock::time_point>;
+
     class SpatialJobQueue
     {
     public:
@@ -76,7 +83,8 @@ namespace DetourNavigator
 
         void push(JobIt job);
 
-        std::optional<JobIt> pop(TilePosition playerTile);
+        // Returns job for the nearest to player priority tile if any otherwise for the nearest to player tile
+        std::optional<JobIt> pop(TilePosition playerTile, const PriorityTiles& priorityTiles = {});
 
         void update(TilePosition playerTile, int maxTiles, std::vector<JobIt>& removing);
 
@@ -88,6 +96,8 @@ namespace DetourNavigator
         std::size_t mSize = 0;
         UpdatingMap mValues;
         boost::geometry::index::rtree<IndexValue, boost::geometry::index::linear<4>> mIndex;
+
+        inline JobIt pop(UpdatingMap::iterator it);
     };
 
     class JobQueue
@@ -99,6 +109,8 @@ namespace DetourNavigator
                 .mRemoving = mRemoving.size(),
                 .mUpdating = mUpdating.size(),
                 .mDelayed = mDelayed.size(),
+                .mPriorityTiles = mPriorityTiles.size(),
+                .mCancelled = mCancelled,
             };
         }
 
@@ -114,10 +126,15 @@ namespace DetourNavigator
         void update(TilePosition playerTile, int maxTiles,
             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
 
+        // Jobs for prioritized tiles are popped before other updating jobs until expiration time
+        void prioritize(const TilePosition& tile, std::chrono::steady_clock::time_point expiration);
+
     private:
         std::vector<JobIt> mRemoving;
         SpatialJobQueue mUpdating;
         std::deque<JobIt> mDelayed;
+        PriorityTiles mPriorityTiles;
+        std::size_t mCancelled = 0;
     };
 
     enum class JobStatus
@@ -202,6 +219,8 @@ namespace DetourNavigator
             const TilePosition& playerTile, ESM::RefId worldspace,
             const std::map<TilePosition, ChangeType>& changedTiles);
 
+        void prioritize(std::span<const TilePosition> tiles);
+
         void wait(WaitConditionType waitConditionType, Loading::Listener* listener);
 
         void stop();
@@ -226,6 +245,7 @@ namespace DetourNavigator
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         NavMeshTilesCache mNavMeshTilesCache;
+        StaticLayerCache mStaticLayerCache;
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
@@ -233,6 +253,7 @@ namespace DetourNavigator
         std::unique_ptr<DbWorker> mDbWorker;
         std::atomic_size_t mDbGetTileHits{ 0 };
         std::atomic_size_t mPostedCount{ 0 };
+        JobWaitTimeStats mWaitTime;
 
         void process() noexcept;
 
@@ -260,6 +281,8 @@ namespace DetourNavigator
         inline void waitUntilJobsDoneForNotPresentTiles(Loading::Listener* listener);
 
         inline void waitUntilAllJobsDone();
+
+        inline void reportWaitTime(const Job& job, std::chrono::steady_clock::time_point now);
     };
 }
 
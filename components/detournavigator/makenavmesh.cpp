@@ -11,6 +11,7 @@
 #include "recastparams.hpp"
 #include "settings.hpp"
 #include "settingsutils.hpp"
+#include "staticlayercache.hpp"
 
 #include "components/debug/debuglog.hpp"
 
@@ -297,11 +298,11 @@ namespace DetourNavigator
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const TilePosition& tilePosition,
-            float agentHalfExtentsZ, const RecastMesh& recastMesh, const RecastSettings& settings,
+            float agentHalfExtentsZ, const Mesh& mesh, const RecastMesh& recastMesh, const RecastSettings& settings,
             const RecastParams& params, rcHeightfield& solid)
         {
             const TileBounds realTileBounds = makeRealTileBoundsWithBorder(settings, tilePosition);
-            return rasterizeTriangles(context, recastMesh.getMesh(), settings, params, solid)
+            return rasterizeTriangles(context, mesh, settings, params, solid)
                 && rasterizeTriangles(
                     context, agentHalfExtentsZ, recastMesh.getWater(), settings, params, realTileBounds, solid)
                 && rasterizeTriangles(context, recastMesh.getHeightfields(), settings, params, solid)
@@ -517,7 +518,8 @@ namespace DetourNavigator
     }
 
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings)
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        StaticLayerCache* staticLayerCache)
     {
         RecastContext context(worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
 
@@ -530,8 +532,24 @@ namespace DetourNavigator
 
         const RecastParams params = makeRecastParams(settings, agentBounds);
 
-        if (!rasterizeTriangles(
-                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
+        const std::optional<RecastMeshLayers>& layers = recastMesh.getLayers();
+
+        if (layers.has_value() && staticLayerCache != nullptr)
+        {
+            if (!staticLayerCache->restore(agentBounds, tilePosition, recastMesh, minZ, maxZ, context, solid))
+            {
+                if (!rasterizeTriangles(context, tilePosition, agentBounds.mHalfExtents.z(), *layers->mStatic,
+                        recastMesh, settings, params, solid))
+                    return nullptr;
+
+                staticLayerCache->store(agentBounds, tilePosition, recastMesh, minZ, maxZ, solid);
+            }
+
+            if (!rasterizeTriangles(context, layers->mDynamic, settings, params, solid))
+                return nullptr;
+        }
+        else if (!rasterizeTriangles(context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh.getMesh(),
+                     recastMesh, settings, params, solid))
             return nullptr;
 
         rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
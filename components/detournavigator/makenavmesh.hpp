@@ -20,6 +20,7 @@ namespace DetourNavigator
     struct OffMeshConnection;
     struct AgentBounds;
     struct RecastSettings;
+    class StaticLayerCache;
 
     inline float getLength(const osg::Vec2i& value)
     {
@@ -44,7 +45,8 @@ namespace DetourNavigator
     }
 
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        StaticLayerCache* staticLayerCache = nullptr);
 
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         std::span<const OffMeshConnection> offMeshConnections, const AgentBounds& agentBounds, const TilePosition& tile,
@@ -171,6 +171,16 @@ namespace DetourNavigator
          */
         virtual void update(const osg::Vec3f& playerPosition, const UpdateGuard* guard) = 0;
 
+        /**
+         * @brief prioritizePath should be called when agent fails to find a complete path to make navmesh tiles
+         * between start and end to be built before other tiles.
+         * @param agentBounds defines navmesh used to find a path.
+         * @param start is path start point.
+         * @param end is path end point.
+         */
+        virtual void prioritizePath(const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end)
+            = 0;
+
         /**
          * @brief wait locks thread until tiles are updated from last update call based on passed condition type.
          * @param waitConditionType defines when waiting will stop
@@ -150,6 +150,11 @@ namespace DetourNavigator
         mNavMeshManager.update(playerPosition, guard);
     }
 
+    void NavigatorImpl::prioritizePath(const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end)
+    {
+        mNavMeshManager.prioritizePath(agentBounds, start, end);
+    }
+
     void NavigatorImpl::wait(WaitConditionType waitConditionType, Loading::Listener* listener)
     {
         mNavMeshManager.wait(waitConditionType, listener);
@@ -71,6 +71,11 @@ namespace DetourNavigator
 
         void update(const osg::Vec3f& /*playerPosition*/, const UpdateGuard* /*guard*/) override {}
 
+        void prioritizePath(
+            const AgentBounds& /*agentBounds*/, const osg::Vec3f& /*start*/, const osg::Vec3f& /*end*/) override
+        {
+        }
+
         void wait(WaitConditionType /*waitConditionType*/, Loading::Listener* /*listener*/) override {}
 
         SharedNavMeshCacheItem getNavMesh(const AgentBounds& /*agentBounds*/) const override
@@ -3,11 +3,27 @@
 #include "findrandompointaroundcircle.hpp"
 #include "navigator.hpp"
 #include "raycast.hpp"
+#include "settingsutils.hpp"
 
 #include <components/debug/debuglog.hpp>
 
 namespace DetourNavigator
 {
+    std::vector<osg::Vec3f> findCoarsePath(const Navigator& navigator, const AgentBounds& agentBounds,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags)
+    {
+        const auto navMesh = navigator.getNavMesh(agentBounds);
+        if (navMesh == nullptr)
+            return {};
+        const Settings& settings = navigator.getSettings();
+        const TilePosition startTile = getTilePosition(settings.mRecast, toNavMeshCoordinates(settings.mRecast, start));
+        const TilePosition endTile = getTilePosition(settings.mRecast, toNavMeshCoordinates(settings.mRecast, end));
+        std::vector<osg::Vec3f> result = navMesh->lock()->getTileGraph().findPath(startTile, endTile, includeFlags);
+        for (osg::Vec3f& point : result)
+            point = fromNavMeshCoordinates(settings.mRecast, point);
+        return result;
+    }
+
     std::optional<osg::Vec3f> findRandomPointAroundCircle(const Navigator& navigator, const AgentBounds& agentBounds,
         const osg::Vec3f& start, const float maxRadius, const Flags includeFlags, float (*prng)())
     {
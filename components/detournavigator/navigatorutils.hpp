@@ -12,6 +12,7 @@
 #include <iterator>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace DetourNavigator
 {
@@ -42,6 +43,19 @@ namespace DetourNavigator
             outTransform);
     }
 
+    /**
+     * @brief findCoarsePath finds points on borders of navmesh tiles to go through from start towards end using only
+     * connectivity between tiles. Cost does not depend on the distance so it can be used to plan long routes which are
+     * then refined by findPath to the nearest points.
+     * @param agentBounds defines which navmesh to use.
+     * @param start path from given point.
+     * @param end path towards given point. When end is not reachable path leads to the nearest reachable tile.
+     * @param includeFlags setup allowed navmesh areas.
+     * @return sequence of points, empty when there is no tiles to go through.
+     */
+    std::vector<osg::Vec3f> findCoarsePath(const Navigator& navigator, const AgentBounds& agentBounds,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags);
+
     /**
      * @brief findRandomPointAroundCircle returns random location on navmesh within the reach of specified location.
      * @param agentBounds defines which navmesh to use.
@@ -3,6 +3,7 @@
 
 #include "navmeshdata.hpp"
 #include "navmeshtilescache.hpp"
+#include "tilegraph.hpp"
 #include "tileposition.hpp"
 #include "version.hpp"
 
@@ -123,6 +124,9 @@ namespace DetourNavigator
 
         bool isEmptyTile(const TilePosition& position) const;
 
+        // Graph is updated together with the navmesh tiles
+        const TileGraph& getTileGraph() const { return mTileGraph; }
+
         template <class Function>
         void forEachUsedTile(Function&& function) const
         {
@@ -153,6 +157,7 @@ namespace DetourNavigator
         dtNavMeshQuery mQuery;
         std::map<TilePosition, Tile> mUsedTiles;
         std::set<TilePosition> mEmptyTiles;
+        TileGraph mTileGraph;
     };
 }
 
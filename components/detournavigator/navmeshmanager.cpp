@@ -15,6 +15,10 @@
 
 #include <DetourNavMesh.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace
 {
     /// Safely reset shared_ptr with definite underlying object destrutor call.
@@ -81,6 +85,22 @@ namespace DetourNavigator
         {
             return getTilePosition(settings, toNavMeshCoordinates(settings, position));
         }
+
+        template <class Function>
+        void forEachTileOnSegment(const TilePosition& start, const TilePosition& end, Function&& function)
+        {
+            const TilePosition delta = end - start;
+            const int steps = std::max(std::abs(delta.x()), std::abs(delta.y()));
+            if (steps == 0)
+                return function(start);
+            for (int i = 0; i <= steps; ++i)
+            {
+                const float t = static_cast<float>(i) / static_cast<float>(steps);
+                function(start
+                    + TilePosition(static_cast<int>(std::round(static_cast<float>(delta.x()) * t)),
+                        static_cast<int>(std::round(static_cast<float>(delta.y()) * t))));
+            }
+        }
     }
 
     NavMeshManager::NavMeshManager(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
@@ -237,6 +257,20 @@ namespace DetourNavigator
                           << " recastMeshManagerRevision=" << mLastRecastMeshManagerRevision;
     }
 
+    void NavMeshManager::prioritizePath(const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end)
+    {
+        if (!mPlayerTile.has_value() || mCache.find(agentBounds) == mCache.end())
+            return;
+        std::vector<TilePosition> tiles;
+        forEachTileOnSegment(toNavMeshTilePosition(mSettings.mRecast, start),
+            toNavMeshTilePosition(mSettings.mRecast, end), [&](const TilePosition& tile) {
+                if (shouldAddTile(tile, *mPlayerTile, mSettings.mMaxTilesNumber))
+                    tiles.push_back(tile);
+            });
+        if (!tiles.empty())
+            mAsyncNavMeshUpdater.prioritize(tiles);
+    }
+
     void NavMeshManager::wait(WaitConditionType waitConditionType, Loading::Listener* listener)
     {
         mAsyncNavMeshUpdater.wait(waitConditionType, listener);
@@ -55,6 +55,9 @@ namespace DetourNavigator
 
         void update(const osg::Vec3f& playerPosition, const UpdateGuard* guard);
 
+        // Makes tiles between start and end to be built before other tiles
+        void prioritizePath(const AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end);
+
         void wait(WaitConditionType waitConditionType, Loading::Listener* listener);
 
         SharedNavMeshCacheItem getNavMesh(const AgentBounds& agentBounds) const;
@@ -18,13 +18,14 @@ namespace DetourNavigator
 
     RecastMesh::RecastMesh(const Version& version, Mesh mesh, std::vector<CellWater> water,
         std::vector<Heightfield> heightfields, std::vector<FlatHeightfield> flatHeightfields,
-        std::vector<MeshSource> meshSources)
+        std::vector<MeshSource> meshSources, std::optional<RecastMeshLayers> layers)
         : mVersion(version)
         , mMesh(std::move(mesh))
         , mWater(std::move(water))
         , mHeightfields(std::move(heightfields))
         , mFlatHeightfields(std::move(flatHeightfields))
         , mMeshSources(std::move(meshSources))
+        , mLayers(std::move(layers))
     {
         mWater.shrink_to_fit();
         mHeightfields.shrink_to_fit();
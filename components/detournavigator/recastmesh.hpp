@@ -11,7 +11,9 @@
 #include <osg/Vec3f>
 
 #include <cstdint>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -124,12 +126,20 @@ namespace DetourNavigator
         AreaType mAreaType;
     };
 
+    // Triangles of the objects that were never moved and the ones that were. Rasterized static layer can be reused
+    // when only moving objects change.
+    struct RecastMeshLayers
+    {
+        std::shared_ptr<const Mesh> mStatic;
+        Mesh mDynamic;
+    };
+
     class RecastMesh
     {
     public:
         explicit RecastMesh(const Version& version, Mesh mesh, std::vector<CellWater> water,
             std::vector<Heightfield> heightfields, std::vector<FlatHeightfield> flatHeightfields,
-            std::vector<MeshSource> sources);
+            std::vector<MeshSource> sources, std::optional<RecastMeshLayers> layers = std::nullopt);
 
         const Version& getVersion() const noexcept { return mVersion; }
 
@@ -143,6 +153,8 @@ namespace DetourNavigator
 
         const std::vector<MeshSource>& getMeshSources() const noexcept { return mMeshSources; }
 
+        const std::optional<RecastMeshLayers>& getLayers() const noexcept { return mLayers; }
+
     private:
         Version mVersion;
         Mesh mMesh;
@@ -150,10 +162,13 @@ namespace DetourNavigator
         std::vector<Heightfield> mHeightfields;
         std::vector<FlatHeightfield> mFlatHeightfields;
         std::vector<MeshSource> mMeshSources;
+        std::optional<RecastMeshLayers> mLayers;
 
         friend inline std::size_t getSize(const RecastMesh& value) noexcept
         {
-            return getSize(value.mMesh) + value.mWater.size() * sizeof(CellWater)
+            return getSize(value.mMesh)
+                + (value.mLayers.has_value() ? getSize(*value.mLayers->mStatic) + getSize(value.mLayers->mDynamic) : 0)
+                + value.mWater.size() * sizeof(CellWater)
                 + value.mHeightfields.size() * sizeof(Heightfield)
                 + std::accumulate(value.mHeightfields.begin(), value.mHeightfields.end(), std::size_t{ 0 },
                     [](std::size_t r, const Heightfield& v) { return r + v.mHeights.size() * sizeof(float); })
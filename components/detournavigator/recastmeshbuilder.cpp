@@ -40,6 +40,49 @@ namespace DetourNavigator
             return static_cast<float>(cellSize) / (dataSize - 1);
         }
 
+        constexpr std::array<int, 36> boxIndices{ {
+            0, 2, 3, // triangle 0
+            3, 1, 0, // triangle 1
+            0, 4, 6, // triangle 2
+            6, 2, 0, // triangle 3
+            0, 1, 5, // triangle 4
+            5, 4, 0, // triangle 5
+            7, 5, 1, // triangle 6
+            1, 3, 7, // triangle 7
+            7, 3, 2, // triangle 8
+            2, 6, 7, // triangle 9
+            7, 6, 4, // triangle 10
+            4, 5, 7, // triangle 11
+        } };
+
+        template <class Function>
+        void forEachBoxTriangle(const btBoxShape& shape, const btTransform& transform, Function&& function)
+        {
+            for (std::size_t i = 0; i < boxIndices.size(); i += 3)
+            {
+                std::array<btVector3, 3> vertices;
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    btVector3 position;
+                    shape.getVertex(boxIndices[i + j], position);
+                    vertices[j] = transform(position);
+                }
+                function(vertices);
+            }
+        }
+
+        btVector3 getBoundsMin(const TileBounds& bounds)
+        {
+            return btVector3(bounds.mMin.x(), bounds.mMin.y(),
+                -std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
+        }
+
+        btVector3 getBoundsMax(const TileBounds& bounds)
+        {
+            return btVector3(bounds.mMax.x(), bounds.mMax.y(),
+                std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
+        }
+
         bool isNan(const RecastMeshTriangle& triangle)
         {
             for (std::size_t i = 0; i < 3; ++i)
@@ -132,6 +175,33 @@ namespace DetourNavigator
         return makeMesh(std::move(triangles), cellShift + osg::Vec3f(localShift.x(), localShift.y(), 0));
     }
 
+    std::optional<TransformedGeometry> makeTransformedGeometry(
+        const btCollisionShape& shape, const btTransform& transform, const AreaType areaType)
+    {
+        TransformedGeometry result;
+        result.mAreaType = areaType;
+        if (shape.getShapeType() == BOX_SHAPE_PROXYTYPE)
+        {
+            result.mClipToBounds = false;
+            result.mTriangles.reserve(boxIndices.size() / 3);
+            forEachBoxTriangle(static_cast<const btBoxShape&>(shape), transform,
+                [&](const std::array<btVector3, 3>& vertices) { result.mTriangles.push_back(vertices); });
+            return result;
+        }
+        if (shape.isCompound() || shape.getShapeType() == TERRAIN_SHAPE_PROXYTYPE || !shape.isConcave())
+            return std::nullopt;
+        result.mClipToBounds = true;
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+        auto callback = makeProcessTriangleCallback([&](btVector3* triangle, int, int) {
+            // Same winding as for RecastMeshBuilder::addObject(const btConcaveShape&, ...)
+            result.mTriangles.push_back({ transform(triangle[2]), transform(triangle[1]), transform(triangle[0]) });
+        });
+        static_cast<const btConcaveShape&>(shape).processAllTriangles(&callback, aabbMin, aabbMax);
+        return result;
+    }
+
     RecastMeshBuilder::RecastMeshBuilder(const TileBounds& bounds) noexcept
         : mBounds(bounds)
     {
@@ -142,7 +212,7 @@ namespace DetourNavigator
         const ObjectTransform& objectTransform)
     {
         addObject(shape, transform, areaType);
-        mSources.push_back(MeshSource{ std::move(source), objectTransform, areaType });
+        addSource(std::move(source), objectTransform, areaType);
     }
 
     void RecastMeshBuilder::addObject(
@@ -174,7 +244,7 @@ namespace DetourNavigator
         return addObject(shape, transform, makeProcessTriangleCallback([&](btVector3* vertices, int, int) {
             RecastMeshTriangle triangle = makeRecastMeshTriangle(vertices, areaType);
             std::reverse(triangle.mVertices.begin(), triangle.mVertices.end());
-            mTriangles.emplace_back(triangle);
+            addTriangle(triangle);
         }));
     }
 
@@ -182,38 +252,38 @@ namespace DetourNavigator
         const btHeightfieldTerrainShape& shape, const btTransform& transform, const AreaType areaType)
     {
         addObject(shape, transform, makeProcessTriangleCallback([&](btVector3* vertices, int, int) {
-            mTriangles.emplace_back(makeRecastMeshTriangle(vertices, areaType));
+            addTriangle(makeRecastMeshTriangle(vertices, areaType));
         }));
     }
 
     void RecastMeshBuilder::addObject(const btBoxShape& shape, const btTransform& transform, const AreaType areaType)
     {
-        constexpr std::array<int, 36> indices{ {
-            0, 2, 3, // triangle 0
-            3, 1, 0, // triangle 1
-            0, 4, 6, // triangle 2
-            6, 2, 0, // triangle 3
-            0, 1, 5, // triangle 4
-            5, 4, 0, // triangle 5
-            7, 5, 1, // triangle 6
-            1, 3, 7, // triangle 7
-            7, 3, 2, // triangle 8
-            2, 6, 7, // triangle 9
-            7, 6, 4, // triangle 10
-            4, 5, 7, // triangle 11
-        } };
+        forEachBoxTriangle(shape, transform, [&](const std::array<btVector3, 3>& vertices) {
+            addTriangle(makeRecastMeshTriangle(vertices.data(), areaType));
+        });
+    }
 
-        for (std::size_t i = 0; i < indices.size(); i += 3)
-        {
-            std::array<btVector3, 3> vertices;
-            for (std::size_t j = 0; j < 3; ++j)
-            {
-                btVector3 position;
-                shape.getVertex(indices[i + j], position);
-                vertices[j] = transform(position);
-            }
-            mTriangles.emplace_back(makeRecastMeshTriangle(vertices.data(), areaType));
-        }
+    void RecastMeshBuilder::addGeometry(const TransformedGeometry& geometry)
+    {
+        const btVector3 boundsMin = getBoundsMin(mBounds);
+        const btVector3 boundsMax = getBoundsMax(mBounds);
+        for (const std::array<btVector3, 3>& vertices : geometry.mTriangles)
+            if (!geometry.mClipToBounds || TestTriangleAgainstAabb2(vertices.data(), boundsMin, boundsMax))
+                addTriangle(makeRecastMeshTriangle(vertices.data(), geometry.mAreaType));
+    }
+
+    void RecastMeshBuilder::addSource(osg::ref_ptr<const Resource::BulletShape> source,
+        const ObjectTransform& objectTransform, const AreaType areaType)
+    {
+        mSources.push_back(MeshSource{ std::move(source), objectTransform, areaType });
+    }
+
+    void RecastMeshBuilder::addTriangle(const RecastMeshTriangle& triangle)
+    {
+        if (mDynamic)
+            mDynamicTriangles.push_back(triangle);
+        else
+            mTriangles.push_back(triangle);
     }
 
     void RecastMeshBuilder::addWater(const osg::Vec2i& cellPosition, const Water& water)
@@ -270,13 +340,29 @@ namespace DetourNavigator
     std::shared_ptr<RecastMesh> RecastMeshBuilder::create(const Version& version) &&
     {
         mTriangles.erase(std::remove_if(mTriangles.begin(), mTriangles.end(), isNan), mTriangles.end());
+        mDynamicTriangles.erase(
+            std::remove_if(mDynamicTriangles.begin(), mDynamicTriangles.end(), isNan), mDynamicTriangles.end());
+        std::optional<RecastMeshLayers> layers;
+        if (!mDynamicTriangles.empty())
+        {
+            std::sort(mTriangles.begin(), mTriangles.end());
+            std::sort(mDynamicTriangles.begin(), mDynamicTriangles.end());
+            std::vector<RecastMeshTriangle> staticTriangles = mTriangles;
+            std::vector<RecastMeshTriangle> dynamicTriangles = mDynamicTriangles;
+            layers = RecastMeshLayers{
+                .mStatic = std::make_shared<const Mesh>(makeMesh(std::move(staticTriangles))),
+                .mDynamic = makeMesh(std::move(dynamicTriangles)),
+            };
+            mTriangles.insert(mTriangles.end(), mDynamicTriangles.begin(), mDynamicTriangles.end());
+            mDynamicTriangles.clear();
+        }
         std::sort(mTriangles.begin(), mTriangles.end());
         std::sort(mWater.begin(), mWater.end());
         std::sort(mHeightfields.begin(), mHeightfields.end());
         std::sort(mFlatHeightfields.begin(), mFlatHeightfields.end());
         Mesh mesh = makeMesh(std::move(mTriangles));
         return std::make_shared<RecastMesh>(version, std::move(mesh), std::move(mWater), std::move(mHeightfields),
-            std::move(mFlatHeightfields), std::move(mSources));
+            std::move(mFlatHeightfields), std::move(mSources), std::move(layers));
     }
 
     void RecastMeshBuilder::addObject(
@@ -287,10 +373,8 @@ namespace DetourNavigator
 
         shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
 
-        const btVector3 boundsMin(mBounds.mMin.x(), mBounds.mMin.y(),
-            -std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
-        const btVector3 boundsMax(mBounds.mMax.x(), mBounds.mMax.y(),
-            std::numeric_limits<btScalar>::max() * std::numeric_limits<btScalar>::epsilon());
+        const btVector3 boundsMin = getBoundsMin(mBounds);
+        const btVector3 boundsMax = getBoundsMax(mBounds);
 
         auto wrapper = makeProcessTriangleCallback([&](btVector3* triangle, int partId, int triangleIndex) {
             std::array<btVector3, 3> transformed;
@@ -12,6 +12,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -35,6 +36,19 @@ namespace DetourNavigator
         }
     };
 
+    // World space triangles of a single non-compound shape shared between all tiles it overlaps
+    struct TransformedGeometry
+    {
+        AreaType mAreaType;
+        bool mClipToBounds;
+        std::vector<std::array<btVector3, 3>> mTriangles;
+    };
+
+    inline std::size_t getSize(const TransformedGeometry& value) noexcept
+    {
+        return value.mTriangles.size() * sizeof(std::array<btVector3, 3>);
+    }
+
     class RecastMeshBuilder
     {
     public:
@@ -51,6 +65,14 @@ namespace DetourNavigator
 
         void addObject(const btBoxShape& shape, const btTransform& transform, const AreaType areaType);
 
+        void addGeometry(const TransformedGeometry& geometry);
+
+        void addSource(osg::ref_ptr<const Resource::BulletShape> source, const ObjectTransform& objectTransform,
+            const AreaType areaType);
+
+        // Triangles of the objects added while set are also stored as a separate RecastMesh layer
+        void setDynamic(bool value) { mDynamic = value; }
+
         void addWater(const osg::Vec2i& cellPosition, const Water& water);
 
         void addHeightfield(const osg::Vec2i& cellPosition, int cellSize, float height);
@@ -63,6 +85,8 @@ namespace DetourNavigator
     private:
         const TileBounds mBounds;
         std::vector<RecastMeshTriangle> mTriangles;
+        std::vector<RecastMeshTriangle> mDynamicTriangles;
+        bool mDynamic = false;
         std::vector<CellWater> mWater;
         std::vector<Heightfield> mHeightfields;
         std::vector<FlatHeightfield> mFlatHeightfields;
@@ -70,12 +94,18 @@ namespace DetourNavigator
 
         inline void addObject(const btCollisionShape& shape, const btTransform& transform, const AreaType areaType);
 
+        void addTriangle(const RecastMeshTriangle& triangle);
+
         void addObject(const btConcaveShape& shape, const btTransform& transform, btTriangleCallback&& callback);
 
         void addObject(
             const btHeightfieldTerrainShape& shape, const btTransform& transform, btTriangleCallback&& callback);
     };
 
+    // Returns nullopt for compound, heightfield and other shapes that can't be transformed once for all tiles
+    std::optional<TransformedGeometry> makeTransformedGeometry(
+        const btCollisionShape& shape, const btTransform& transform, const AreaType areaType);
+
     Mesh makeMesh(std::vector<RecastMeshTriangle>&& triangles, const osg::Vec3f& shift = osg::Vec3f());
 
     Mesh makeMesh(const Heightfield& heightfield);
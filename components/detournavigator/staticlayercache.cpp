@@ -0,0 +1,115 @@
+#include "staticlayercache.hpp"
+#include "stats.hpp"
+
+#include <Recast.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        template <class T>
+        bool isEqual(const T& lhs, const T& rhs)
+        {
+            return !(lhs < rhs) && !(rhs < lhs);
+        }
+
+        bool isEqualInput(const std::shared_ptr<const Mesh>& cached, const std::vector<CellWater>& water,
+            const std::vector<Heightfield>& heightfields, const std::vector<FlatHeightfield>& flatHeightfields,
+            const RecastMesh& recastMesh)
+        {
+            const std::optional<RecastMeshLayers>& layers = recastMesh.getLayers();
+            assert(layers.has_value());
+            return (cached == layers->mStatic || isEqual(*cached, *layers->mStatic))
+                && isEqual(water, recastMesh.getWater()) && isEqual(heightfields, recastMesh.getHeightfields())
+                && isEqual(flatHeightfields, recastMesh.getFlatHeightfields());
+        }
+    }
+
+    StaticLayerCache::StaticLayerCache(std::size_t maxItems)
+        : mMaxItems(maxItems)
+    {
+    }
+
+    bool StaticLayerCache::restore(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+        const RecastMesh& recastMesh, float minZ, float maxZ, rcContext& context, rcHeightfield& solid)
+    {
+        std::shared_ptr<const std::vector<Span>> spans;
+
+        {
+            const std::lock_guard lock(mMutex);
+            ++mGetCount;
+            const auto it = mItems.find(std::make_tuple(agentBounds, tilePosition));
+            if (it == mItems.end())
+                return false;
+            const Item& item = it->second;
+            if (item.mMinZ != minZ || item.mMaxZ != maxZ
+                || !isEqualInput(item.mStatic, item.mWater, item.mHeightfields, item.mFlatHeightfields, recastMesh))
+                return false;
+            ++mHitCount;
+            it->second.mLastUse = ++mUseCounter;
+            spans = item.mSpans;
+        }
+
+        // Spans in a column of the cached heightfield never overlap so adding them back won't merge anything
+        for (const Span& span : *spans)
+            if (!rcAddSpan(&context, solid, span.mX, span.mY, span.mMin, span.mMax, span.mArea, 0))
+                return false;
+
+        return true;
+    }
+
+    void StaticLayerCache::store(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+        const RecastMesh& recastMesh, float minZ, float maxZ, const rcHeightfield& solid)
+    {
+        if (mMaxItems == 0)
+            return;
+
+        const std::optional<RecastMeshLayers>& layers = recastMesh.getLayers();
+        assert(layers.has_value());
+
+        auto spans = std::make_shared<std::vector<Span>>();
+        for (int y = 0; y < solid.height; ++y)
+            for (int x = 0; x < solid.width; ++x)
+                for (const rcSpan* span = solid.spans[x + y * solid.width]; span != nullptr; span = span->next)
+                    spans->push_back(Span{
+                        .mX = static_cast<std::uint16_t>(x),
+                        .mY = static_cast<std::uint16_t>(y),
+                        .mMin = static_cast<std::uint16_t>(span->smin),
+                        .mMax = static_cast<std::uint16_t>(span->smax),
+                        .mArea = static_cast<std::uint8_t>(span->area),
+                    });
+        spans->shrink_to_fit();
+
+        Item item{
+            .mStatic = layers->mStatic,
+            .mWater = recastMesh.getWater(),
+            .mHeightfields = recastMesh.getHeightfields(),
+            .mFlatHeightfields = recastMesh.getFlatHeightfields(),
+            .mMinZ = minZ,
+            .mMaxZ = maxZ,
+            .mSpans = std::move(spans),
+            .mLastUse = 0,
+        };
+
+        const std::lock_guard lock(mMutex);
+        item.mLastUse = ++mUseCounter;
+        mItems.insert_or_assign(std::make_tuple(agentBounds, tilePosition), std::move(item));
+        while (mItems.size() > mMaxItems)
+            mItems.erase(std::min_element(mItems.begin(), mItems.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.second.mLastUse < rhs.second.mLastUse;
+            }));
+    }
+
+    StaticLayerCacheStats StaticLayerCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return StaticLayerCacheStats{
+            .mItems = mItems.size(),
+            .mGetCount = mGetCount,
+            .mHitCount = mHitCount,
+        };
+    }
+}
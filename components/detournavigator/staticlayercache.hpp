@@ -0,0 +1,72 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_STATICLAYERCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_STATICLAYERCACHE_H
+
+#include "agentbounds.hpp"
+#include "recastmesh.hpp"
+#include "tileposition.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+class rcContext;
+struct rcHeightfield;
+
+namespace DetourNavigator
+{
+    struct StaticLayerCacheStats;
+
+    // Stores rasterized static layer of the recast mesh (not moved objects, water and heightfields) per tile and
+    // agent bounds before any filtering is applied. Allows to rasterize only moved objects when they are the only
+    // change in the tile.
+    class StaticLayerCache
+    {
+    public:
+        explicit StaticLayerCache(std::size_t maxItems);
+
+        // Adds spans of the cached static layer into initialized heightfield if there is a cached item for the same
+        // input
+        bool restore(const AgentBounds& agentBounds, const TilePosition& tilePosition, const RecastMesh& recastMesh,
+            float minZ, float maxZ, rcContext& context, rcHeightfield& solid);
+
+        void store(const AgentBounds& agentBounds, const TilePosition& tilePosition, const RecastMesh& recastMesh,
+            float minZ, float maxZ, const rcHeightfield& solid);
+
+        StaticLayerCacheStats getStats() const;
+
+    private:
+        struct Span
+        {
+            std::uint16_t mX;
+            std::uint16_t mY;
+            std::uint16_t mMin;
+            std::uint16_t mMax;
+            std::uint8_t mArea;
+        };
+
+        struct Item
+        {
+            std::shared_ptr<const Mesh> mStatic;
+            std::vector<CellWater> mWater;
+            std::vector<Heightfield> mHeightfields;
+            std::vector<FlatHeightfield> mFlatHeightfields;
+            float mMinZ;
+            float mMaxZ;
+            std::shared_ptr<const std::vector<Span>> mSpans;
+            std::size_t mLastUse;
+        };
+
+        const std::size_t mMaxItems;
+        mutable std::mutex mMutex;
+        std::map<std::tuple<AgentBounds, TilePosition>, Item> mItems;
+        std::size_t mUseCounter = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+    };
+}
+
+#endif
@@ -15,6 +15,14 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh Pushed", static_cast<double>(stats.mPushed));
             out.setAttribute(frameNumber, "NavMesh Processing", static_cast<double>(stats.mProcessing));
             out.setAttribute(frameNumber, "NavMesh Posted", static_cast<double>(stats.mPosted));
+            out.setAttribute(frameNumber, "NavMesh Cancelled", static_cast<double>(stats.mWaiting.mCancelled));
+            out.setAttribute(frameNumber, "NavMesh PriorityTiles", static_cast<double>(stats.mWaiting.mPriorityTiles));
+
+            out.setAttribute(frameNumber, "NavMesh Wait <10ms", static_cast<double>(stats.mWaitTime.mLess10Ms));
+            out.setAttribute(frameNumber, "NavMesh Wait <100ms", static_cast<double>(stats.mWaitTime.mLess100Ms));
+            out.setAttribute(frameNumber, "NavMesh Wait <1s", static_cast<double>(stats.mWaitTime.mLess1S));
+            out.setAttribute(frameNumber, "NavMesh Wait <10s", static_cast<double>(stats.mWaitTime.mLess10S));
+            out.setAttribute(frameNumber, "NavMesh Wait >=10s", static_cast<double>(stats.mWaitTime.mMore10S));
 
             if (stats.mDb.has_value())
             {
@@ -32,6 +40,13 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh CachedTiles", static_cast<double>(stats.mCache.mCachedNavMeshTiles));
             out.setAttribute(frameNumber, "NavMesh Cache Get", static_cast<double>(stats.mCache.mGetCount));
             out.setAttribute(frameNumber, "NavMesh Cache Hit", static_cast<double>(stats.mCache.mHitCount));
+
+            out.setAttribute(
+                frameNumber, "NavMesh StaticLayer Tiles", static_cast<double>(stats.mStaticLayerCache.mItems));
+            out.setAttribute(
+                frameNumber, "NavMesh StaticLayer Get", static_cast<double>(stats.mStaticLayerCache.mGetCount));
+            out.setAttribute(
+                frameNumber, "NavMesh StaticLayer Hit", static_cast<double>(stats.mStaticLayerCache.mHitCount));
         }
 
         void reportStats(const TileCachedRecastMeshManagerStats& stats, unsigned int frameNumber, osg::Stats& out)
@@ -40,6 +55,14 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh Recast Objects", static_cast<double>(stats.mObjects));
             out.setAttribute(frameNumber, "NavMesh Recast Heightfields", static_cast<double>(stats.mHeightfields));
             out.setAttribute(frameNumber, "NavMesh Recast Water", static_cast<double>(stats.mWater));
+            out.setAttribute(frameNumber, "NavMesh Recast Memory", static_cast<double>(stats.mMemory));
+            out.setAttribute(frameNumber, "NavMesh Recast Geometry", static_cast<double>(stats.mGeometry.mItems));
+            out.setAttribute(
+                frameNumber, "NavMesh Recast Geometry Memory", static_cast<double>(stats.mGeometry.mMemory));
+            out.setAttribute(
+                frameNumber, "NavMesh Recast Geometry Get", static_cast<double>(stats.mGeometry.mGetCount));
+            out.setAttribute(
+                frameNumber, "NavMesh Recast Geometry Hit", static_cast<double>(stats.mGeometry.mHitCount));
         }
     }
 
@@ -16,6 +16,18 @@ namespace DetourNavigator
         std::size_t mRemoving = 0;
         std::size_t mUpdating = 0;
         std::size_t mDelayed = 0;
+        std::size_t mPriorityTiles = 0;
+        std::size_t mCancelled = 0;
+    };
+
+    // Number of jobs by time spent in the queue before processing has started
+    struct JobWaitTimeStats
+    {
+        std::size_t mLess10Ms = 0;
+        std::size_t mLess100Ms = 0;
+        std::size_t mLess1S = 0;
+        std::size_t mLess10S = 0;
+        std::size_t mMore10S = 0;
     };
 
     struct DbJobQueueStats
@@ -39,6 +51,13 @@ namespace DetourNavigator
         std::size_t mGetCount = 0;
     };
 
+    struct StaticLayerCacheStats
+    {
+        std::size_t mItems = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+    };
+
     struct AsyncNavMeshUpdaterStats
     {
         std::size_t mJobs = 0;
@@ -47,8 +66,18 @@ namespace DetourNavigator
         std::size_t mProcessing = 0;
         std::size_t mDbGetTileHits = 0;
         std::size_t mPosted = 0;
+        JobWaitTimeStats mWaitTime;
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
+        StaticLayerCacheStats mStaticLayerCache;
+    };
+
+    struct TransformedGeometryCacheStats
+    {
+        std::size_t mItems = 0;
+        std::size_t mMemory = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
     };
 
     struct TileCachedRecastMeshManagerStats
@@ -57,6 +86,8 @@ namespace DetourNavigator
         std::size_t mObjects = 0;
         std::size_t mHeightfields = 0;
         std::size_t mWater = 0;
+        std::size_t mMemory = 0;
+        TransformedGeometryCacheStats mGeometry;
     };
 
     struct Stats
@@ -55,6 +55,17 @@ namespace DetourNavigator
             const std::optional<std::unique_lock<Mutex>> mImpl;
         };
 
+        bool hasMultipleTiles(const TilesPositionsRange& range)
+        {
+            return range.mEnd.x() - range.mBegin.x() > 1 || range.mEnd.y() - range.mBegin.y() > 1;
+        }
+
+        std::size_t getTilesCount(const TilesPositionsRange& range)
+        {
+            return static_cast<std::size_t>(range.mEnd.x() - range.mBegin.x())
+                * static_cast<std::size_t>(range.mEnd.y() - range.mBegin.y());
+        }
+
         TilesPositionsRange getIndexRange(const auto& index)
         {
             const auto bounds = index.bounds();
@@ -151,6 +162,7 @@ namespace DetourNavigator
         ++mRevision;
         mObjectIndex.clear();
         mObjects.clear();
+        mGeometryCache.clear();
         mWater.clear();
         mHeightfields.clear();
         mCache.clear();
@@ -177,6 +189,9 @@ namespace DetourNavigator
                               .mRevision = revision,
                               .mLastNavMeshReportedChange = {},
                               .mLastNavMeshReport = {},
+                              .mGeometryKeys = acquireGeometry(range, shape.getShape(), transform, areaType),
+                              .mGeometryTiles = getTilesCount(range),
+                              .mMoved = false,
                           }))
                       ->second.get();
             assert(range.mBegin != range.mEnd);
@@ -200,13 +215,20 @@ namespace DetourNavigator
                 return false;
             if (!it->second->mObject.update(transform, areaType))
                 return false;
+            it->second->mMoved = true;
+            const btCollisionShape& shape = it->second->mObject.getShape();
+            const TilesPositionsRange objectRange = makeTilesPositionsRange(shape, transform, mSettings);
+            std::vector<TransformedGeometryCache::Key> geometryKeys
+                = acquireGeometry(objectRange, shape, transform, areaType);
+            mGeometryCache.release(it->second->mGeometryKeys, it->second->mGeometryTiles);
+            it->second->mGeometryKeys = std::move(geometryKeys);
+            it->second->mGeometryTiles = getTilesCount(objectRange);
             const std::size_t lastChangeRevision = it->second->mLastNavMeshReportedChange.has_value()
                 ? it->second->mLastNavMeshReportedChange->mRevision
                 : mRevision;
-            const btCollisionShape& shape = it->second->mObject.getShape();
             if (!it->second->mAabb.update(lastChangeRevision, BulletHelpers::getAabb(shape, transform)))
                 return false;
-            newRange = makeTilesPositionsRange(shape, transform, mSettings);
+            newRange = objectRange;
             oldRange = it->second->mRange;
             if (newRange != oldRange)
             {
@@ -247,6 +269,7 @@ namespace DetourNavigator
                 return;
             range = it->second->mRange;
             mObjectIndex.remove(makeObjectIndexValue(range, it->second.get()));
+            mGeometryCache.release(it->second->mGeometryKeys, it->second->mGeometryTiles);
             mObjects.erase(it);
             ++mRevision;
         }
@@ -441,11 +464,17 @@ namespace DetourNavigator
     TileCachedRecastMeshManagerStats TileCachedRecastMeshManager::getStats() const
     {
         const std::lock_guard lock(mMutex);
+        const TransformedGeometryCacheStats geometryStats = mGeometryCache.getStats();
+        std::size_t memory = geometryStats.mMemory;
+        for (const auto& [tilePosition, tile] : mCache)
+            memory += sizeof(RecastMesh) + getSize(*tile.mRecastMesh);
         return TileCachedRecastMeshManagerStats{
             .mTiles = mCache.size(),
             .mObjects = mObjects.size(),
             .mHeightfields = mHeightfields.size(),
             .mWater = mWater.size(),
+            .mMemory = memory,
+            .mGeometry = geometryStats,
         };
     }
 
@@ -486,11 +515,22 @@ namespace DetourNavigator
         return boost::geometry::index::intersects(IndexBox(point, point));
     }
 
+    std::vector<TransformedGeometryCache::Key> TileCachedRecastMeshManager::acquireGeometry(
+        const TilesPositionsRange& range, const btCollisionShape& shape, const btTransform& transform,
+        AreaType areaType)
+    {
+        // Object covering a single tile is processed only once per change so there is nothing to share
+        if (!hasMultipleTiles(range))
+            return {};
+        return mGeometryCache.acquire(shape, transform, areaType, getTilesCount(range));
+    }
+
     std::shared_ptr<RecastMesh> TileCachedRecastMeshManager::makeMesh(const TilePosition& tilePosition) const
     {
         RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings, tilePosition));
         using Object = std::tuple<osg::ref_ptr<const Resource::BulletShapeInstance>, ObjectTransform,
-            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType>;
+            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType,
+            std::vector<TransformedGeometryCache::Key>, bool>;
         std::vector<Object> objects;
         Version version;
         bool hasInput = false;
@@ -513,7 +553,7 @@ namespace DetourNavigator
             {
                 const auto& object = it->second->mObject;
                 objects.emplace_back(object.getInstance(), object.getObjectTransform(), object.getShape(),
-                    object.getTransform(), object.getAreaType());
+                    object.getTransform(), object.getAreaType(), it->second->mGeometryKeys, it->second->mMoved);
                 hasInput = true;
             }
             if (hasInput)
@@ -530,8 +570,18 @@ namespace DetourNavigator
         }
         if (!hasInput)
             return nullptr;
-        for (const auto& [instance, objectTransform, shape, transform, areaType] : objects)
-            builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+        for (const auto& [instance, objectTransform, shape, transform, areaType, geometryKeys, moved] : objects)
+        {
+            builder.setDynamic(moved);
+            if (geometryKeys.empty())
+            {
+                builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+                continue;
+            }
+            for (const TransformedGeometryCache::Key& key : geometryKeys)
+                builder.addGeometry(*mGeometryCache.get(key));
+            builder.addSource(instance->getSource(), objectTransform, areaType);
+        }
         return std::move(builder).create(version);
     }
 
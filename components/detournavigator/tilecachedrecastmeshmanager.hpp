@@ -10,6 +10,7 @@
 #include "recastmesh.hpp"
 #include "recastmeshobject.hpp"
 #include "tileposition.hpp"
+#include "transformedgeometrycache.hpp"
 #include "updateguard.hpp"
 #include "version.hpp"
 
@@ -97,6 +98,9 @@ namespace DetourNavigator
             std::size_t mRevision = 0;
             std::optional<Report> mLastNavMeshReportedChange;
             std::optional<Report> mLastNavMeshReport;
+            std::vector<TransformedGeometryCache::Key> mGeometryKeys;
+            std::size_t mGeometryTiles = 0;
+            bool mMoved = false;
         };
 
         struct WaterData
@@ -139,6 +143,7 @@ namespace DetourNavigator
         boost::geometry::index::rtree<HeightfieldIndexValue, boost::geometry::index::linear<4>> mHeightfieldIndex;
         std::map<osg::Vec2i, ChangeType> mChangedTiles;
         std::map<TilePosition, CachedTile> mCache;
+        mutable TransformedGeometryCache mGeometryCache;
         std::size_t mGeneration = 0;
         std::size_t mRevision = 0;
         mutable std::mutex mMutex;
@@ -159,6 +164,9 @@ namespace DetourNavigator
         inline static auto makeIndexQuery(const TilePosition& tilePosition)
             -> decltype(boost::geometry::index::intersects(IndexBox()));
 
+        inline std::vector<TransformedGeometryCache::Key> acquireGeometry(const TilesPositionsRange& range,
+            const btCollisionShape& shape, const btTransform& transform, AreaType areaType);
+
         inline std::shared_ptr<RecastMesh> makeMesh(const TilePosition& tilePosition) const;
 
         inline void addChangedTiles(const std::optional<TilesPositionsRange>& range, ChangeType changeType);
@@ -0,0 +1,153 @@
+#include "tilegraph.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        struct Node
+        {
+            float mCost;
+            TilePosition mParent;
+            osg::Vec3f mPortal;
+        };
+
+        struct QueueItem
+        {
+            float mPriority;
+            TilePosition mTile;
+
+            friend bool operator>(const QueueItem& lhs, const QueueItem& rhs) { return lhs.mPriority > rhs.mPriority; }
+        };
+
+        float getDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return std::hypot(static_cast<float>(lhs.x() - rhs.x()), static_cast<float>(lhs.y() - rhs.y()));
+        }
+
+        osg::Vec3f getEdgeCenter(const dtMeshTile& tile, const dtPoly& poly, unsigned char edge)
+        {
+            const float* const a = &tile.verts[static_cast<std::size_t>(poly.verts[edge]) * 3];
+            const float* const b = &tile.verts[static_cast<std::size_t>(poly.verts[(edge + 1) % poly.vertCount]) * 3];
+            return (osg::Vec3f(a[0], a[1], a[2]) + osg::Vec3f(b[0], b[1], b[2])) * 0.5f;
+        }
+    }
+
+    void TileGraph::addPortal(
+        const TilePosition& from, const TilePosition& to, const osg::Vec3f& position, Flags fromFlags, Flags toFlags)
+    {
+        std::vector<Portal>& portals = mEdges[from][to];
+        // Single portal per flags combination is enough for coarse planning
+        const auto samePortal = [&](const Portal& v) { return v.mFromFlags == fromFlags && v.mToFlags == toFlags; };
+        if (std::none_of(portals.begin(), portals.end(), samePortal))
+            portals.push_back(Portal{ .mPosition = position, .mFromFlags = fromFlags, .mToFlags = toFlags });
+    }
+
+    std::vector<osg::Vec3f> TileGraph::findPath(
+        const TilePosition& start, const TilePosition& end, Flags includeFlags) const
+    {
+        const auto isPassable = [&](const Portal& v) {
+            return (v.mFromFlags & includeFlags) != 0 && (v.mToFlags & includeFlags) != 0;
+        };
+
+        std::map<TilePosition, Node> nodes;
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<>> queue;
+        TilePosition nearest = start;
+        float nearestDistance = getDistance(start, end);
+
+        nodes.emplace(start, Node{ .mCost = 0, .mParent = start, .mPortal = osg::Vec3f() });
+        queue.push(QueueItem{ .mPriority = nearestDistance, .mTile = start });
+
+        while (!queue.empty())
+        {
+            const QueueItem item = queue.top();
+            queue.pop();
+
+            const float cost = nodes.at(item.mTile).mCost;
+            const float distance = getDistance(item.mTile, end);
+
+            if (item.mPriority > cost + distance)
+                continue;
+
+            if (distance < nearestDistance)
+            {
+                nearest = item.mTile;
+                nearestDistance = distance;
+            }
+
+            if (item.mTile == end)
+                break;
+
+            const auto edges = mEdges.find(item.mTile);
+            if (edges == mEdges.end())
+                continue;
+
+            for (const auto& [neighbour, portals] : edges->second)
+            {
+                const auto portal = std::find_if(portals.begin(), portals.end(), isPassable);
+                if (portal == portals.end())
+                    continue;
+                const float neighbourCost = cost + getDistance(item.mTile, neighbour);
+                const Node node{ .mCost = neighbourCost, .mParent = item.mTile, .mPortal = portal->mPosition };
+                if (const auto [it, inserted] = nodes.emplace(neighbour, node); !inserted)
+                {
+                    if (it->second.mCost <= neighbourCost)
+                        continue;
+                    it->second = node;
+                }
+                queue.push(QueueItem{ .mPriority = neighbourCost + getDistance(neighbour, end), .mTile = neighbour });
+            }
+        }
+
+        std::vector<osg::Vec3f> result;
+        for (TilePosition tile = nearest; tile != start;)
+        {
+            const Node& node = nodes.at(tile);
+            result.push_back(node.mPortal);
+            tile = node.mParent;
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    void TileGraph::updateTile(const dtNavMesh& navMesh, const TilePosition& position)
+    {
+        // Detour links polygons only to the polygons of 8 surrounding tiles
+        for (int x = -1; x <= 1; ++x)
+            for (int y = -1; y <= 1; ++y)
+                setTileEdges(navMesh, position + TilePosition(x, y));
+    }
+
+    void TileGraph::setTileEdges(const dtNavMesh& navMesh, const TilePosition& position)
+    {
+        mEdges.erase(position);
+        const int layer = 0;
+        const dtMeshTile* const tile = navMesh.getTileAt(position.x(), position.y(), layer);
+        if (tile == nullptr || tile->header == nullptr)
+            return;
+        for (int i = 0; i < tile->header->polyCount; ++i)
+        {
+            const dtPoly& poly = tile->polys[i];
+            if (poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION)
+                continue;
+            for (unsigned link = poly.firstLink; link != DT_NULL_LINK; link = tile->links[link].next)
+            {
+                const dtLink& value = tile->links[link];
+                // Links to polygons of the same tile have no side
+                if (value.side == 0xff)
+                    continue;
+                const dtMeshTile* neighbourTile = nullptr;
+                const dtPoly* neighbourPoly = nullptr;
+                navMesh.getTileAndPolyByRefUnsafe(value.ref, &neighbourTile, &neighbourPoly);
+                addPortal(position, TilePosition(neighbourTile->header->x, neighbourTile->header->y),
+                    getEdgeCenter(*tile, poly, value.edge), poly.flags, neighbourPoly->flags);
+            }
+        }
+    }
+}
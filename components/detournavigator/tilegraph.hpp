@@ -0,0 +1,47 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+
+#include "flags.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+class dtNavMesh;
+
+namespace DetourNavigator
+{
+    // Coarse navmesh abstraction where nodes are tiles and edges are connections between polygons of the neighbour
+    // tiles. Allows to plan a route over the whole navmesh at cost not depending on the number of polygons.
+    class TileGraph
+    {
+    public:
+        void addPortal(const TilePosition& from, const TilePosition& to, const osg::Vec3f& position, Flags fromFlags,
+            Flags toFlags);
+
+        // Rebuilds edges of the tile and its neighbours after the tile was added, replaced or removed from navmesh
+        void updateTile(const dtNavMesh& navMesh, const TilePosition& position);
+
+        std::size_t getTilesCount() const { return mEdges.size(); }
+
+        // Returns portals positions to go through from start tile to the reachable tile nearest to end tile
+        std::vector<osg::Vec3f> findPath(const TilePosition& start, const TilePosition& end, Flags includeFlags) const;
+
+    private:
+        struct Portal
+        {
+            osg::Vec3f mPosition;
+            Flags mFromFlags;
+            Flags mToFlags;
+        };
+
+        std::map<TilePosition, std::map<TilePosition, std::vector<Portal>>> mEdges;
+
+        void setTileEdges(const dtNavMesh& navMesh, const TilePosition& position);
+    };
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "transformedgeometrycache.hpp"
+#include "stats.hpp"
+
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <optional>
+#include <tuple>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        bool collectKeys(const btCollisionShape& shape, const btTransform& transform, AreaType areaType,
+            std::vector<TransformedGeometryCache::Key>& keys)
+        {
+            if (shape.isCompound())
+            {
+                const btCompoundShape& compound = static_cast<const btCompoundShape&>(shape);
+                for (int i = 0, num = compound.getNumChildShapes(); i < num; ++i)
+                    if (!collectKeys(
+                            *compound.getChildShape(i), transform * compound.getChildTransform(i), areaType, keys))
+                        return false;
+                return true;
+            }
+            if (shape.getShapeType() == TERRAIN_SHAPE_PROXYTYPE)
+                return false;
+            if (!shape.isConcave() && shape.getShapeType() != BOX_SHAPE_PROXYTYPE)
+                return false;
+            keys.push_back(TransformedGeometryCache::Key{
+                .mShape = &shape,
+                .mAreaType = areaType,
+                .mTransform = transform,
+                .mLocalScaling = shape.getLocalScaling(),
+            });
+            return true;
+        }
+
+        std::array<btScalar, 12> toArray(const btTransform& value)
+        {
+            const btMatrix3x3& basis = value.getBasis();
+            const btVector3& origin = value.getOrigin();
+            return {
+                basis[0].x(), basis[0].y(), basis[0].z(), //
+                basis[1].x(), basis[1].y(), basis[1].z(), //
+                basis[2].x(), basis[2].y(), basis[2].z(), //
+                origin.x(), origin.y(), origin.z(), //
+            };
+        }
+
+        std::array<btScalar, 3> toArray(const btVector3& value)
+        {
+            return { value.x(), value.y(), value.z() };
+        }
+
+        auto makeTuple(const TransformedGeometryCache::Key& v)
+        {
+            return std::make_tuple(v.mShape, v.mAreaType, toArray(v.mTransform), toArray(v.mLocalScaling));
+        }
+    }
+
+    bool operator<(const TransformedGeometryCache::Key& lhs, const TransformedGeometryCache::Key& rhs) noexcept
+    {
+        return makeTuple(lhs) < makeTuple(rhs);
+    }
+
+    std::vector<TransformedGeometryCache::Key> TransformedGeometryCache::acquire(
+        const btCollisionShape& shape, const btTransform& transform, AreaType areaType, std::size_t tiles)
+    {
+        std::vector<Key> keys;
+        if (!collectKeys(shape, transform, areaType, keys))
+            return {};
+        const std::lock_guard lock(mMutex);
+        for (const Key& key : keys)
+        {
+            Item& item = mItems[key];
+            ++item.mUseCount;
+            item.mPendingTiles += tiles;
+        }
+        return keys;
+    }
+
+    void TransformedGeometryCache::release(const std::vector<Key>& keys, std::size_t tiles)
+    {
+        if (keys.empty())
+            return;
+        const std::lock_guard lock(mMutex);
+        for (const Key& key : keys)
+        {
+            const auto it = mItems.find(key);
+            if (it == mItems.end())
+                continue;
+            if (--it->second.mUseCount > 0)
+            {
+                it->second.mPendingTiles -= std::min(tiles, it->second.mPendingTiles);
+                if (it->second.mPendingTiles == 0 && it->second.mGeometry != nullptr)
+                {
+                    mMemory -= getSize(*it->second.mGeometry);
+                    it->second.mGeometry = nullptr;
+                }
+                continue;
+            }
+            if (it->second.mGeometry != nullptr)
+                mMemory -= getSize(*it->second.mGeometry);
+            mItems.erase(it);
+        }
+    }
+
+    std::shared_ptr<const TransformedGeometry> TransformedGeometryCache::get(const Key& key)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            ++mGetCount;
+            const auto it = mItems.find(key);
+            if (it != mItems.end() && it->second.mGeometry != nullptr)
+            {
+                ++mHitCount;
+                std::shared_ptr<const TransformedGeometry> result = it->second.mGeometry;
+                takeTile(it->second);
+                return result;
+            }
+        }
+
+        std::optional<TransformedGeometry> geometry
+            = makeTransformedGeometry(*key.mShape, key.mTransform, key.mAreaType);
+        assert(geometry.has_value());
+        auto result = std::make_shared<const TransformedGeometry>(std::move(*geometry));
+
+        const std::lock_guard lock(mMutex);
+        const auto it = mItems.find(key);
+        if (it == mItems.end())
+            return result;
+        if (it->second.mGeometry != nullptr)
+            result = it->second.mGeometry;
+        else if (it->second.mPendingTiles > 1)
+        {
+            it->second.mGeometry = result;
+            mMemory += getSize(*result);
+        }
+        takeTile(it->second);
+        return result;
+    }
+
+    void TransformedGeometryCache::takeTile(Item& item)
+    {
+        if (item.mPendingTiles > 0)
+            --item.mPendingTiles;
+        if (item.mPendingTiles > 0 || item.mGeometry == nullptr)
+            return;
+        mMemory -= getSize(*item.mGeometry);
+        item.mGeometry = nullptr;
+    }
+
+    void TransformedGeometryCache::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        mItems.clear();
+        mMemory = 0;
+    }
+
+    TransformedGeometryCacheStats TransformedGeometryCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return TransformedGeometryCacheStats{
+            .mItems = mItems.size(),
+            .mMemory = mMemory,
+            .mGetCount = mGetCount,
+            .mHitCount = mHitCount,
+        };
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TRANSFORMEDGEOMETRYCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TRANSFORMEDGEOMETRYCACHE_H
+
+#include "areatype.hpp"
+#include "recastmeshbuilder.hpp"
+
+#include <LinearMath/btTransform.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class btCollisionShape;
+
+namespace DetourNavigator
+{
+    struct TransformedGeometryCacheStats;
+
+    // Shares world space triangles of object shapes between all tiles they overlap. Objects placed with the same
+    // shape and transform use the same item. Items are reference counted and removed when the last object using
+    // them is released. Triangles are kept only until each tile of the acquiring objects got them once, so a tile
+    // rebuilt later transforms the shape again instead of the cache holding it for the object lifetime.
+    class TransformedGeometryCache
+    {
+    public:
+        struct Key
+        {
+            const btCollisionShape* mShape;
+            AreaType mAreaType;
+            btTransform mTransform;
+            btVector3 mLocalScaling;
+        };
+
+        // Returns keys for all non-compound children of the shape or empty vector if any of them is not supported.
+        // Tiles is the number of tiles the object overlaps.
+        std::vector<Key> acquire(
+            const btCollisionShape& shape, const btTransform& transform, AreaType areaType, std::size_t tiles);
+
+        // Tiles has to be the same value as used to acquire the keys
+        void release(const std::vector<Key>& keys, std::size_t tiles);
+
+        // Shape referenced by the key must be alive. Counts as the triangles being taken by one tile.
+        std::shared_ptr<const TransformedGeometry> get(const Key& key);
+
+        void clear();
+
+        TransformedGeometryCacheStats getStats() const;
+
+    private:
+        struct Item
+        {
+            std::size_t mUseCount = 0;
+            std::size_t mPendingTiles = 0;
+            std::shared_ptr<const TransformedGeometry> mGeometry;
+        };
+
+        mutable std::mutex mMutex;
+        std::map<Key, Item> mItems;
+        std::size_t mMemory = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+
+        void takeTile(Item& item);
+    };
+
+    bool operator<(const TransformedGeometryCache::Key& lhs, const TransformedGeometryCache::Key& rhs) noexcept;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#include "atomicfile.hpp"
+#include "conversion.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef WIN32
+#include <components/misc/windows.hpp>
+#else
+#include <unistd.h>
+#endif
+
+namespace Files
+{
+    namespace
+    {
+        unsigned long long getProcessId()
+        {
+#ifdef WIN32
+            return GetCurrentProcessId();
+#else
+            return static_cast<unsigned long long>(getpid());
+#endif
+        }
+
+        std::filesystem::path getTempPath(const std::filesystem::path& path)
+        {
+            // Unique among threads of all running processes writing the same file
+            std::filesystem::path result = path;
+            result += "." + std::to_string(getProcessId()) + "."
+                + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+            return result;
+        }
+    }
+
+    bool writeFileAtomically(const std::filesystem::path& path, const std::function<bool(std::ostream&)>& write)
+    {
+        // Write into a temporary file and then rename so other threads and processes never read a partial file
+        const std::filesystem::path tempPath = getTempPath(path);
+
+        std::ofstream stream(tempPath, std::ios::binary);
+        const bool written = stream.is_open() && write(stream);
+        stream.close();
+        std::error_code ec;
+        if (!written || !stream)
+        {
+            Log(Debug::Warning) << "Failed to write file " << pathToUnicodeString(tempPath);
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec)
+        {
+            Log(Debug::Warning) << "Failed to rename file " << pathToUnicodeString(tempPath) << " to "
+                                << pathToUnicodeString(path) << ": " << ec.message();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+}
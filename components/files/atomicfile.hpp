@@ -0,0 +1,16 @@
+#ifndef OPENMW_COMPONENTS_FILES_ATOMICFILE_H
+#define OPENMW_COMPONENTS_FILES_ATOMICFILE_H
+
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+
+namespace Files
+{
+    /// @brief write a binary file so other threads and processes never read it partially written
+    /// @param write fills the stream and returns false on failure
+    /// @return true when the file is replaced with the new content
+    bool writeFileAtomically(const std::filesystem::path& path, const std::function<bool(std::ostream&)>& write);
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_MISC_CACHEKEY_H
+#define OPENMW_COMPONENTS_MISC_CACHEKEY_H
+
+#include <osg/Vec2f>
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Misc
+{
+    // Values are appended field by field in little endian byte order, so the key depends neither on padding bytes nor
+    // on the platform
+    template <class T>
+    void appendToKey(std::string& key, T value)
+    {
+        static_assert(std::is_integral_v<T>);
+        const auto bits = static_cast<std::make_unsigned_t<T>>(value);
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            key.push_back(static_cast<char>(bits >> (8 * i)));
+    }
+
+    inline void appendToKey(std::string& key, float value)
+    {
+        // Equal values have to give the same key
+        if (value == 0)
+            value = 0;
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        appendToKey(key, bits);
+    }
+
+    inline void appendToKey(std::string& key, const osg::Vec2f& value)
+    {
+        appendToKey(key, value.x());
+        appendToKey(key, value.y());
+    }
+
+    inline void appendToKey(std::string& key, const osg::Vec3f& value)
+    {
+        appendToKey(key, value.x());
+        appendToKey(key, value.y());
+        appendToKey(key, value.z());
+    }
+
+    // Size goes first so adjacent strings can't be confused with each other
+    inline void appendStringToKey(std::string& key, std::string_view value)
+    {
+        appendToKey(key, static_cast<std::uint64_t>(value.size()));
+        key.append(value);
+    }
+}
+
+#endif
@@ -339,7 +339,8 @@ namespace Nif
         if (mesh->getNumTriangles() == 0)
             return nullptr;
 
-        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true);
+        // BVH is built by the loader which may use a cache or do it in parallel
+        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true, false);
         std::ignore = mesh.release();
 
         return shape;
@@ -380,7 +381,8 @@ namespace Nif
         if (mesh->getNumTriangles() == 0)
             return nullptr;
 
-        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true);
+        // BVH is built by the loader which may use a cache or do it in parallel
+        auto shape = std::make_unique<Resource::TriangleMeshShape>(mesh.get(), true, false);
         std::ignore = mesh.release();
 
         return shape;
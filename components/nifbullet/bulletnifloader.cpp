@@ -286,6 +286,9 @@ namespace NifBullet
 
         if (childShape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
         {
+            if (mBuildBvh)
+                static_cast<btBvhTriangleMeshShape*>(childShape.get())->buildOptimizedBvh();
+
             auto scaledShape = std::make_unique<Resource::ScaledTriangleMeshShape>(
                 static_cast<btBvhTriangleMeshShape*>(childShape.get()), Misc::Convert::toBullet(transform.getScale()));
             std::ignore = childShape.release();
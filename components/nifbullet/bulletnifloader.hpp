@@ -47,6 +47,10 @@ namespace NifBullet
 
         osg::ref_ptr<Resource::BulletShape> load(Nif::FileView file);
 
+        /// When disabled, triangle mesh shapes are created without BVH and the caller has to build or load it before
+        /// using the shape for collision detection.
+        void setBuildBvh(bool value) { mBuildBvh = value; }
+
     private:
         bool findBoundingBox(const Nif::NiAVObject& node);
 
@@ -68,6 +72,8 @@ namespace NifBullet
         std::unique_ptr<btCompoundShape, Resource::DeleteCollisionShape> mAvoidCompoundShape;
 
         osg::ref_ptr<Resource::BulletShape> mShape;
+
+        bool mBuildBvh = true;
     };
 
 }
@@ -102,7 +102,7 @@ namespace NifOsg
                 const Nif::NiQuatTransform& defaultTransform = interp->mDefaultValue;
                 if (!interp->mData.empty())
                 {
-                    mRotations = QuaternionInterpolator(interp->mData->mRotations, defaultTransform.mRotation);
+                    mRotations = QuantizedQuaternionInterpolator(interp->mData->mRotations, defaultTransform.mRotation);
                     mXRotations = FloatInterpolator(interp->mData->mXRotations);
                     mYRotations = FloatInterpolator(interp->mData->mYRotations);
                     mZRotations = FloatInterpolator(interp->mData->mZRotations);
@@ -113,7 +113,7 @@ namespace NifOsg
                 }
                 else
                 {
-                    mRotations = QuaternionInterpolator(Nif::QuaternionKeyMapPtr(), defaultTransform.mRotation);
+                    mRotations = QuantizedQuaternionInterpolator(nullptr, defaultTransform.mRotation);
                     mTranslations = Vec3Interpolator(Nif::Vector3KeyMapPtr(), defaultTransform.mTranslation);
                     mScales = FloatInterpolator(Nif::FloatKeyMapPtr(), defaultTransform.mScale);
                 }
@@ -122,7 +122,7 @@ namespace NifOsg
         else if (!keyctrl->mData.empty())
         {
             const Nif::NiKeyframeData* keydata = keyctrl->mData.getPtr();
-            mRotations = QuaternionInterpolator(keydata->mRotations);
+            mRotations = QuantizedQuaternionInterpolator(keydata->mRotations);
             mXRotations = FloatInterpolator(keydata->mXRotations);
             mYRotations = FloatInterpolator(keydata->mYRotations);
             mZRotations = FloatInterpolator(keydata->mZRotations);
@@ -201,23 +201,34 @@ namespace NifOsg
 
     KeyframeController::KfTransform KeyframeController::getCurrentTransformation(osg::NodeVisitor* nv)
     {
-        KfTransform out;
+        if (!hasInput())
+            return KfTransform();
 
-        if (hasInput())
-        {
-            float time = getInputValue(nv);
+        const float time = getInputValue(nv);
+        if (!mLastTransformation.has_value() || mLastTransformation->first != time)
+            mLastTransformation.emplace(time, getTransformation(time));
+        return mLastTransformation->second;
+    }
 
-            if (!mRotations.empty())
-                out.mRotation = mRotations.interpKey(time);
-            else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
-                out.mRotation = getXYZRotation(time);
+    void KeyframeController::prepareTransformation()
+    {
+        getCurrentTransformation(nullptr);
+    }
 
-            if (!mTranslations.empty())
-                out.mTranslation = mTranslations.interpKey(time);
+    KeyframeController::KfTransform KeyframeController::getTransformation(float time) const
+    {
+        KfTransform out;
 
-            if (!mScales.empty())
-                out.mScale = mScales.interpKey(time);
-        }
+        if (!mRotations.empty())
+            out.mRotation = mRotations.interpKey(time);
+        else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
+            out.mRotation = getXYZRotation(time);
+
+        if (!mTranslations.empty())
+            out.mTranslation = mTranslations.interpKey(time);
+
+        if (!mScales.empty())
+            out.mScale = mScales.interpKey(time);
 
         return out;
     }
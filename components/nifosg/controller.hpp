@@ -1,8 +1,10 @@
 #ifndef COMPONENTS_NIFOSG_CONTROLLER_H
 #define COMPONENTS_NIFOSG_CONTROLLER_H
 
+#include <optional>
 #include <set>
 #include <type_traits>
+#include <utility>
 
 #include <osg/Texture2D>
 #include <osg/observer_ptr>
@@ -10,6 +12,7 @@
 #include <components/nif/controller.hpp>
 #include <components/nif/data.hpp>
 #include <components/nif/nifkey.hpp>
+#include <components/nifosg/quantizedkeys.hpp>
 #include <components/sceneutil/keyframe.hpp>
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
@@ -248,10 +251,12 @@ namespace NifOsg
 
         KfTransform getCurrentTransformation(osg::NodeVisitor* nv) override;
 
+        void prepareTransformation() override;
+
         void operator()(NifOsg::MatrixTransform*, osg::NodeVisitor*);
 
     private:
-        QuaternionInterpolator mRotations;
+        QuantizedQuaternionInterpolator mRotations;
 
         FloatInterpolator mXRotations;
         FloatInterpolator mYRotations;
@@ -262,7 +267,12 @@ namespace NifOsg
 
         Nif::NiKeyframeData::AxisOrder mAxisOrder{ Nif::NiKeyframeData::AxisOrder::Order_XYZ };
 
+        // The last sampled transformation is reused while the input value stays the same
+        std::optional<std::pair<float, KfTransform>> mLastTransformation;
+
         osg::Quat getXYZRotation(float time) const;
+
+        KfTransform getTransformation(float time) const;
     };
 #ifdef _MSC_VER
 #pragma warning(pop)
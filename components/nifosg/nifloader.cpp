@@ -252,6 +252,27 @@ namespace
             }
         }
     }
+
+    // Most morph targets, e.g. facial animation, move only a few vertices so it's cheaper to store and blend only
+    // non-zero offsets
+    void addMorphTargetOffsets(const std::vector<osg::Vec3f>& offsets, SceneUtil::MorphGeometry& geometry)
+    {
+        osg::ref_ptr<osg::UIntArray> indices = new osg::UIntArray;
+        osg::ref_ptr<osg::Vec3Array> sparseOffsets = new osg::Vec3Array;
+        for (std::size_t i = 0; i < offsets.size(); ++i)
+        {
+            if (offsets[i] == osg::Vec3f())
+                continue;
+            indices->push_back(static_cast<unsigned>(i));
+            sparseOffsets->push_back(offsets[i]);
+        }
+
+        // Dense blending is vectorized so it's faster when most of the vertices are moved anyway
+        if (indices->size() * 2 > offsets.size())
+            geometry.addMorphTarget(new osg::Vec3Array(static_cast<unsigned>(offsets.size()), offsets.data()), 0.f);
+        else
+            geometry.addMorphTarget(indices, sparseOffsets, 0.f);
+    }
 }
 
 namespace NifOsg
@@ -1736,10 +1757,11 @@ namespace NifOsg
 
                     osg::ref_ptr<SceneUtil::MorphGeometry> morphGeom = new SceneUtil::MorphGeometry;
                     morphGeom->setSourceGeometry(geom);
-                    for (unsigned int i = 0; i < morphs.size(); ++i)
-                        morphGeom->addMorphTarget(new osg::Vec3Array(static_cast<unsigned>(morphs[i].mVertices.size()),
-                                                      morphs[i].mVertices.data()),
-                            0.f);
+                    const std::vector<osg::Vec3f>& positions = morphs[0].mVertices;
+                    morphGeom->addMorphTarget(
+                        new osg::Vec3Array(static_cast<unsigned>(positions.size()), positions.data()), 0.f);
+                    for (std::size_t i = 1; i < morphs.size(); ++i)
+                        addMorphTargetOffsets(morphs[i].mVertices, *morphGeom);
 
                     osg::ref_ptr<GeomMorpherController> morphctrl = new GeomMorpherController(nimorphctrl);
                     setupController(ctrl.getPtr(), morphctrl, animflags);
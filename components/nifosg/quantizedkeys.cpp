@@ -0,0 +1,111 @@
+#include "quantizedkeys.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace NifOsg
+{
+    namespace
+    {
+        constexpr double quantizationScale = 32767;
+
+        std::array<std::int16_t, 4> quantize(osg::Quat value)
+        {
+            const double length = value.length();
+            if (length > 0)
+                value /= length;
+            std::array<std::int16_t, 4> result;
+            for (std::size_t i = 0; i < result.size(); ++i)
+                result[i] = static_cast<std::int16_t>(
+                    std::lround(std::clamp(value[static_cast<int>(i)], -1.0, 1.0) * quantizationScale));
+            return result;
+        }
+    }
+
+    QuantizedQuaternionInterpolator::QuantizedQuaternionInterpolator(
+        const Nif::QuaternionKeyMapPtr& keys, const osg::Quat& defaultValue)
+        : mDefaultValue(defaultValue)
+    {
+        if (keys == nullptr || keys->mKeys.empty())
+            return;
+
+        auto quantized = std::make_shared<Keys>();
+        quantized->mTimes.reserve(keys->mKeys.size());
+        quantized->mRotations.reserve(keys->mKeys.size());
+        for (const auto& [time, key] : keys->mKeys)
+        {
+            quantized->mTimes.push_back(time);
+            quantized->mRotations.push_back(quantize(key.mValue));
+        }
+        // Other interpolation types are not implemented for rotations and use linear interpolation
+        quantized->mConstant = keys->mInterpolationType == Nif::InterpolationType_Constant;
+        mKeys = std::move(quantized);
+    }
+
+    osg::Quat QuantizedQuaternionInterpolator::interpKey(float time) const
+    {
+        if (empty())
+            return mDefaultValue;
+
+        const std::vector<float>& times = mKeys->mTimes;
+
+        if (time <= times.front())
+            return getRotation(0);
+
+        const std::size_t high = findHighKey(time);
+        if (high == times.size())
+            return getRotation(times.size() - 1);
+
+        mLastHighKey = high;
+        const std::size_t low = high - 1;
+
+        const float highTime = times[high];
+        const float lowTime = times[low];
+        if (highTime == lowTime)
+            return getRotation(low);
+
+        const float fraction = (time - lowTime) / (highTime - lowTime);
+
+        if (mKeys->mConstant)
+            return getRotation(fraction > 0.5f ? high : low);
+
+        osg::Quat result;
+        result.slerp(fraction, getRotation(low), getRotation(high));
+        return result;
+    }
+
+    std::size_t QuantizedQuaternionInterpolator::getKeysSize() const
+    {
+        if (empty())
+            return 0;
+        return sizeof(Keys) + mKeys->mTimes.capacity() * sizeof(float)
+            + mKeys->mRotations.capacity() * sizeof(std::array<std::int16_t, 4>);
+    }
+
+    std::size_t QuantizedQuaternionInterpolator::findHighKey(float time) const
+    {
+        const std::vector<float>& times = mKeys->mTimes;
+
+        std::size_t high = mLastHighKey;
+        if (high > 0 && high < times.size())
+        {
+            if (time > times[high])
+                ++high;
+            if (high < times.size() && time >= times[high - 1] && time <= times[high])
+                return high;
+        }
+
+        return static_cast<std::size_t>(std::lower_bound(times.begin(), times.end(), time) - times.begin());
+    }
+
+    osg::Quat QuantizedQuaternionInterpolator::getRotation(std::size_t index) const
+    {
+        const std::array<std::int16_t, 4>& value = mKeys->mRotations[index];
+        osg::Quat result(value[0] / quantizationScale, value[1] / quantizationScale, value[2] / quantizationScale,
+            value[3] / quantizationScale);
+        const double length = result.length();
+        if (length > 0)
+            result /= length;
+        return result;
+    }
+}
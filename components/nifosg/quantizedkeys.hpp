@@ -0,0 +1,54 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_QUANTIZEDKEYS_H
+#define OPENMW_COMPONENTS_NIFOSG_QUANTIZEDKEYS_H
+
+#include <components/nif/nifkey.hpp>
+
+#include <osg/Quat>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace NifOsg
+{
+    /// @brief Interpolation of rotation keys stored in a compact form.
+    /// Times and unit quaternions quantized to 16 bits per component are kept in separate contiguous arrays shared by
+    /// all copies. This takes 12 bytes per key instead of over 100 for Nif::QuaternionKeyMap which also stores unused
+    /// tangents in double precision. Results match QuaternionInterpolator within the quantization error.
+    class QuantizedQuaternionInterpolator
+    {
+    public:
+        QuantizedQuaternionInterpolator() = default;
+
+        explicit QuantizedQuaternionInterpolator(
+            const Nif::QuaternionKeyMapPtr& keys, const osg::Quat& defaultValue = osg::Quat());
+
+        osg::Quat interpKey(float time) const;
+
+        bool empty() const { return mKeys == nullptr; }
+
+        /// Size of the shared key data in bytes.
+        std::size_t getKeysSize() const;
+
+    private:
+        struct Keys
+        {
+            std::vector<float> mTimes;
+            std::vector<std::array<std::int16_t, 4>> mRotations;
+            bool mConstant = false;
+        };
+
+        std::shared_ptr<const Keys> mKeys;
+        // Sampling usually moves forward along the track so the next key is checked first
+        mutable std::size_t mLastHighKey = 0;
+        osg::Quat mDefaultValue;
+
+        std::size_t findHighKey(float time) const;
+
+        osg::Quat getRotation(std::size_t index) const;
+    };
+}
+
+#endif
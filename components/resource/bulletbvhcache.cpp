@@ -0,0 +1,166 @@
+#include "bulletbvhcache.hpp"
+
+#include "bulletshape.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/atomicfile.hpp>
+#include <components/files/conversion.hpp>
+#include <components/misc/strings/conversion.hpp>
+
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <LinearMath/btScalar.h>
+
+#include <smhasher/MurmurHash3.h>
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+namespace Resource
+{
+    namespace
+    {
+        // Increment when the header or the way BVH is built is changed
+        constexpr std::uint32_t formatVersion = 1;
+
+        constexpr std::uint32_t magic = 0x48564221; // "!BVH" for little endian
+
+        struct Header
+        {
+            std::uint32_t mMagic = magic;
+            std::uint32_t mFormatVersion = formatVersion;
+            // In place serialization copies objects memory so the layout has to match
+            std::uint32_t mBulletVersion = BT_BULLET_VERSION;
+            std::uint32_t mScalarSize = sizeof(btScalar);
+            std::uint32_t mPointerSize = sizeof(void*);
+            std::uint32_t mNumTriangles = 0;
+            std::uint32_t mDataSize = 0;
+            std::uint32_t mPadding = 0;
+            std::array<std::uint64_t, 2> mDataHash{ 0, 0 };
+        };
+
+        std::array<std::uint64_t, 2> getHash(const void* data, std::size_t size)
+        {
+            std::array<std::uint64_t, 2> result{ 0, 0 };
+            MurmurHash3_x64_128(data, static_cast<int>(size), 0, result.data());
+            return result;
+        }
+
+        bool isCompatible(const Header& header)
+        {
+            const Header expected;
+            return header.mMagic == expected.mMagic && header.mFormatVersion == expected.mFormatVersion
+                && header.mBulletVersion == expected.mBulletVersion && header.mScalarSize == expected.mScalarSize
+                && header.mPointerSize == expected.mPointerSize;
+        }
+
+        std::uint32_t getNumTriangles(const TriangleMeshShape& shape)
+        {
+            const btStridingMeshInterface& mesh = *shape.getMeshInterface();
+            std::uint32_t result = 0;
+            for (int i = 0; i < mesh.getNumSubParts(); ++i)
+            {
+                const unsigned char* vertexBase = nullptr;
+                int numVerts = 0;
+                PHY_ScalarType type = PHY_FLOAT;
+                int stride = 0;
+                const unsigned char* indexBase = nullptr;
+                int indexStride = 0;
+                int numFaces = 0;
+                PHY_ScalarType indicesType = PHY_INTEGER;
+                mesh.getLockedReadOnlyVertexIndexBase(
+                    &vertexBase, numVerts, type, stride, &indexBase, indexStride, numFaces, indicesType, i);
+                result += static_cast<std::uint32_t>(numFaces);
+                mesh.unLockReadOnlyVertexBase(i);
+            }
+            return result;
+        }
+    }
+
+    BulletBvhCache::BulletBvhCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to create BVH cache directory " << Files::pathToUnicodeString(mPath) << ": "
+                                << ec.message();
+    }
+
+    bool BulletBvhCache::load(std::string_view key, TriangleMeshShape& shape) const
+    {
+        const std::filesystem::path filePath = getFilePath(key);
+        std::ifstream stream(filePath, std::ios::binary);
+        if (!stream)
+            return false;
+
+        Header header;
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || !isCompatible(header)
+            || header.mNumTriangles != getNumTriangles(shape))
+            return false;
+
+        std::error_code ec;
+        const std::uintmax_t fileSize = std::filesystem::file_size(filePath, ec);
+        if (ec || fileSize != sizeof(header) + header.mDataSize)
+        {
+            Log(Debug::Warning) << "Ignoring BVH cache file with invalid size " << Files::pathToUnicodeString(filePath);
+            return false;
+        }
+
+        AlignedBufferPtr buffer(static_cast<char*>(btAlignedAlloc(header.mDataSize, 16)));
+        if (buffer == nullptr || !stream.read(buffer.get(), header.mDataSize)
+            || getHash(buffer.get(), header.mDataSize) != header.mDataHash)
+        {
+            Log(Debug::Warning) << "Ignoring corrupted BVH cache file " << Files::pathToUnicodeString(filePath);
+            return false;
+        }
+
+        btOptimizedBvh* const bvh = btOptimizedBvh::deSerializeInPlace(buffer.get(), header.mDataSize, false);
+        if (bvh == nullptr)
+            return false;
+
+        if (bvh->isQuantized() != shape.usesQuantizedAabbCompression())
+        {
+            bvh->~btOptimizedBvh();
+            return false;
+        }
+
+        shape.setSerializedBvh(std::move(buffer), *bvh);
+
+        return true;
+    }
+
+    void BulletBvhCache::store(std::string_view key, const TriangleMeshShape& shape) const
+    {
+        // Bullet provides only non-const accessor
+        const btOptimizedBvh* const bvh = const_cast<TriangleMeshShape&>(shape).getOptimizedBvh();
+        if (bvh == nullptr)
+            return;
+
+        Header header;
+        header.mNumTriangles = getNumTriangles(shape);
+        header.mDataSize = bvh->calculateSerializeBufferSize();
+
+        AlignedBufferPtr buffer(static_cast<char*>(btAlignedAlloc(header.mDataSize, 16)));
+        if (buffer == nullptr || !bvh->serializeInPlace(buffer.get(), header.mDataSize, false))
+            return;
+        header.mDataHash = getHash(buffer.get(), header.mDataSize);
+
+        Files::writeFileAtomically(getFilePath(key), [&](std::ostream& stream) {
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            stream.write(buffer.get(), header.mDataSize);
+            return static_cast<bool>(stream);
+        });
+    }
+
+    std::filesystem::path BulletBvhCache::getFilePath(std::string_view key) const
+    {
+        const std::array<std::uint64_t, 2> hash = getHash(key.data(), key.size());
+        std::string name = Misc::StringUtils::toHex(
+            std::string_view(reinterpret_cast<const char*>(hash.data()), sizeof(hash)));
+        name += ".bvh";
+        return mPath / name;
+    }
+}
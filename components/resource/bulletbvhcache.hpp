@@ -0,0 +1,34 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_BULLETBVHCACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_BULLETBVHCACHE_H
+
+#include <filesystem>
+#include <string_view>
+
+class btOptimizedBvh;
+
+namespace Resource
+{
+    struct TriangleMeshShape;
+
+    /// Stores optimized BVH of triangle mesh shapes on disk in Bullet in place serialization format so they don't need
+    /// to be rebuilt each time a mesh is loaded. Files are only valid for the same Bullet build and platform.
+    /// @note May be used from any thread.
+    class BulletBvhCache
+    {
+    public:
+        explicit BulletBvhCache(const std::filesystem::path& path);
+
+        /// Key has to identify mesh content, e.g. include file name, file hash and shape index within the file.
+        /// @return true when BVH is loaded and set to the shape which is expected to have no BVH.
+        bool load(std::string_view key, TriangleMeshShape& shape) const;
+
+        void store(std::string_view key, const TriangleMeshShape& shape) const;
+
+    private:
+        std::filesystem::path mPath;
+
+        std::filesystem::path getFilePath(std::string_view key) const;
+    };
+}
+
+#endif
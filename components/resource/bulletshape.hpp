@@ -9,7 +9,9 @@
 #include <osg/ref_ptr>
 
 #include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
 #include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <LinearMath/btAlignedAllocator.h>
 
 #include <components/vfs/pathutil.hpp>
 
@@ -89,6 +91,13 @@ namespace Resource
 
     osg::ref_ptr<BulletShapeInstance> makeInstance(osg::ref_ptr<const BulletShape> source);
 
+    struct AlignedFree
+    {
+        void operator()(void* ptr) const { btAlignedFree(ptr); }
+    };
+
+    using AlignedBufferPtr = std::unique_ptr<char, AlignedFree>;
+
     // Subclass btBhvTriangleMeshShape to auto-delete the meshInterface
     struct TriangleMeshShape : public btBvhTriangleMeshShape
     {
@@ -100,9 +109,22 @@ namespace Resource
 
         virtual ~TriangleMeshShape()
         {
+            if (mSerializedBvh != nullptr)
+                m_bvh->~btOptimizedBvh();
             delete getTriangleInfoMap();
             delete m_meshInterface;
         }
+
+        // Uses BVH deserialized in place by btOptimizedBvh::deSerializeInPlace from the buffer which is owned by the
+        // shape after this call. Must be called only for a shape created without BVH.
+        void setSerializedBvh(AlignedBufferPtr buffer, btOptimizedBvh& bvh)
+        {
+            setOptimizedBvh(&bvh);
+            mSerializedBvh = std::move(buffer);
+        }
+
+    private:
+        AlignedBufferPtr mSerializedBvh;
     };
 
     // btScaledBvhTriangleMeshShape that auto-deletes the child shape
@@ -1,23 +1,30 @@
 #include "bulletshapemanager.hpp"
 
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include <osg/Drawable>
 #include <osg/NodeVisitor>
 #include <osg/Transform>
 #include <osg/TriangleFunctor>
 
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 
 #include <components/misc/convert.hpp>
 #include <components/misc/osguservalues.hpp>
 #include <components/misc/pathhelpers.hpp>
+#include <components/misc/strings/conversion.hpp>
+#include <components/sceneutil/paralleljobs.hpp>
 #include <components/sceneutil/visitor.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include <components/nifbullet/bulletnifloader.hpp>
 
+#include "bulletbvhcache.hpp"
 #include "bulletshape.hpp"
 #include "multiobjectcache.hpp"
 #include "niffilemanager.hpp"
@@ -26,6 +33,44 @@
 
 namespace Resource
 {
+    namespace
+    {
+        void collectTriangleMeshShapes(btCollisionShape& shape, std::vector<TriangleMeshShape*>& result)
+        {
+            if (shape.isCompound())
+            {
+                btCompoundShape& compound = static_cast<btCompoundShape&>(shape);
+                for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                    collectTriangleMeshShapes(*compound.getChildShape(i), result);
+                return;
+            }
+
+            btCollisionShape* child = &shape;
+            if (shape.getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE)
+                child = static_cast<btScaledBvhTriangleMeshShape&>(shape).getChildShape();
+
+            if (child->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
+                if (auto* const triangleMeshShape = dynamic_cast<TriangleMeshShape*>(child))
+                    result.push_back(triangleMeshShape);
+        }
+
+        struct BuildBvhJob
+        {
+            TriangleMeshShape* mShape;
+            std::string mCacheKey;
+        };
+
+        void buildOrLoadBvh(const BuildBvhJob& job, const BulletBvhCache* cache)
+        {
+            if (cache != nullptr && !job.mCacheKey.empty() && cache->load(job.mCacheKey, *job.mShape))
+                return;
+
+            job.mShape->buildOptimizedBvh();
+
+            if (cache != nullptr && !job.mCacheKey.empty())
+                cache->store(job.mCacheKey, *job.mShape);
+        }
+    }
 
     struct GetTriangleFunctor
     {
@@ -79,7 +124,7 @@ namespace Resource
 
             osg::ref_ptr<BulletShape> shape(new BulletShape);
 
-            auto triangleMeshShape = std::make_unique<TriangleMeshShape>(mTriangleMesh.release(), true);
+            auto triangleMeshShape = std::make_unique<TriangleMeshShape>(mTriangleMesh.release(), true, false);
             btVector3 aabbMin = triangleMeshShape->getLocalAabbMin();
             btVector3 aabbMax = triangleMeshShape->getLocalAabbMax();
             shape->mCollisionBox.mExtents[0] = static_cast<float>(aabbMax[0] - aabbMin[0]) / 2.0f;
@@ -107,6 +152,16 @@ namespace Resource
 
     BulletShapeManager::~BulletShapeManager() = default;
 
+    void BulletShapeManager::setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue)
+    {
+        mWorkQueue = std::move(workQueue);
+    }
+
+    void BulletShapeManager::setBvhCache(std::unique_ptr<BulletBvhCache> bvhCache)
+    {
+        mBvhCache = std::move(bvhCache);
+    }
+
     osg::ref_ptr<const BulletShape> BulletShapeManager::getShape(VFS::Path::NormalizedView name)
     {
         if (osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name))
@@ -117,6 +172,7 @@ namespace Resource
         if (Misc::getFileExtension(name.value()) == "nif")
         {
             NifBullet::BulletNifLoader loader;
+            loader.setBuildBvh(false);
             shape = loader.load(*mNifFileManager->get(name));
         }
         else
@@ -159,6 +215,8 @@ namespace Resource
             }
         }
 
+        buildBvh(*shape);
+
         mCache->addEntryToObjectCache(name.value(), shape);
 
         return shape;
@@ -186,6 +244,31 @@ namespace Resource
         return osg::ref_ptr<BulletShapeInstance>();
     }
 
+    void BulletShapeManager::buildBvh(BulletShape& shape) const
+    {
+        std::vector<TriangleMeshShape*> triangleMeshShapes;
+        if (shape.mCollisionShape != nullptr)
+            collectTriangleMeshShapes(*shape.mCollisionShape, triangleMeshShapes);
+        if (shape.mAvoidCollisionShape != nullptr)
+            collectTriangleMeshShapes(*shape.mAvoidCollisionShape, triangleMeshShapes);
+
+        std::vector<BuildBvhJob> jobs;
+        jobs.reserve(triangleMeshShapes.size());
+        for (std::size_t i = 0; i < triangleMeshShapes.size(); ++i)
+        {
+            if (triangleMeshShapes[i]->getOptimizedBvh() != nullptr)
+                continue;
+            BuildBvhJob& job = jobs.emplace_back(BuildBvhJob{ .mShape = triangleMeshShapes[i] });
+            // Without file hash there is no way to detect that the file has changed
+            if (mBvhCache != nullptr && !shape.mFileHash.empty())
+                job.mCacheKey = shape.mFileName.value() + ':' + Misc::StringUtils::toHex(shape.mFileHash) + ':'
+                    + std::to_string(i);
+        }
+
+        SceneUtil::runParallelJobs(
+            mWorkQueue.get(), jobs.size(), [&](std::size_t i) { buildOrLoadBvh(jobs[i], mBvhCache.get()); });
+    }
+
     void BulletShapeManager::updateCache(double referenceTime)
     {
         ResourceManager::updateCache(referenceTime);
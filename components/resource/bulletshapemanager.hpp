@@ -3,13 +3,21 @@
 
 #include <osg/ref_ptr>
 
+#include <memory>
+
 #include <components/vfs/pathutil.hpp>
 
 #include "bulletshape.hpp"
 #include "resourcemanager.hpp"
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
+    class BulletBvhCache;
     class SceneManager;
     class NifFileManager;
 
@@ -28,6 +36,14 @@ namespace Resource
             const VFS::Manager* vfs, SceneManager* sceneMgr, NifFileManager* nifFileManager, double expiryDelay);
         ~BulletShapeManager();
 
+        /// Use work queue threads to build BVH of triangle mesh shapes in parallel with the loading thread.
+        /// @note Not thread safe, has to be called before loading any shape.
+        void setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
+
+        /// Load BVH of triangle mesh shapes from the cache when possible and store newly built ones.
+        /// @note Not thread safe, has to be called before loading any shape.
+        void setBvhCache(std::unique_ptr<BulletBvhCache> bvhCache);
+
         /// @note May return a null pointer if the object has no shape.
         osg::ref_ptr<const BulletShape> getShape(VFS::Path::NormalizedView name);
 
@@ -50,9 +66,13 @@ namespace Resource
     private:
         osg::ref_ptr<BulletShapeInstance> createInstance(VFS::Path::NormalizedView name);
 
+        void buildBvh(BulletShape& shape) const;
+
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
         SceneManager* mSceneManager;
         NifFileManager* mNifFileManager;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::unique_ptr<BulletBvhCache> mBvhCache;
     };
 
 }
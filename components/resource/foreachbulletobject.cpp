@@ -135,12 +135,24 @@ namespace Resource
     void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
         Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
         std::function<void(const ESM::Cell& cell, const BulletObject& object)> callback)
+    {
+        forEachBulletObject(
+            readers, vfs, bulletShapeManager, esmData, [](const ESM::Cell&) { return true; }, std::move(callback));
+    }
+
+    void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
+        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+        const std::function<bool(const ESM::Cell&)>& filter,
+        std::function<void(const ESM::Cell& cell, const BulletObject& object)> callback)
     {
         Log(Debug::Info) << "Processing " << esmData.mCells.size() << " cells...";
 
         for (std::size_t i = 0; i < esmData.mCells.size(); ++i)
         {
             const ESM::Cell& cell = esmData.mCells[i];
+            if (!filter(cell))
+                continue;
+
             const bool exterior = cell.isExterior();
 
             Log(Debug::Debug) << "Processing " << (exterior ? "exterior" : "interior") << " cell (" << (i + 1) << "/"
@@ -42,6 +42,12 @@ namespace Resource
     void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
         Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
         std::function<void(const ESM::Cell&, const BulletObject& object)> callback);
+
+    /// Visits objects only in the cells accepted by the filter
+    void forEachBulletObject(ESM::ReadersCache& readers, const VFS::Manager& vfs,
+        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
+        const std::function<bool(const ESM::Cell&)>& filter,
+        std::function<void(const ESM::Cell&, const BulletObject& object)> callback);
 }
 
 #endif
@@ -113,6 +113,13 @@ namespace Resource
                 "NavMesh Pushed",
                 "NavMesh Processing",
                 "NavMesh Posted",
+                "NavMesh Cancelled",
+                "NavMesh PriorityTiles",
+                "NavMesh Wait <10ms",
+                "NavMesh Wait <100ms",
+                "NavMesh Wait <1s",
+                "NavMesh Wait <10s",
+                "NavMesh Wait >=10s",
                 "NavMesh DbJobs Write",
                 "NavMesh DbJobs Read",
                 "NavMesh DbCache Get",
@@ -122,10 +129,48 @@ namespace Resource
                 "NavMesh CachedTiles",
                 "NavMesh Cache Get",
                 "NavMesh Cache Hit",
+                "NavMesh StaticLayer Tiles",
+                "NavMesh StaticLayer Get",
+                "NavMesh StaticLayer Hit",
                 "NavMesh Recast Tiles",
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
                 "NavMesh Recast Water",
+                "NavMesh Recast Memory",
+                "NavMesh Recast Geometry",
+                "NavMesh Recast Geometry Memory",
+                "NavMesh Recast Geometry Get",
+                "NavMesh Recast Geometry Hit",
+            };
+
+            constexpr std::string_view physics[] = {
+                "Physics Actors Sleeping",
+                "Physics Animated Updated",
+                "Physics Workers Busy us",
+                "Physics Workers Idle us",
+                "Physics Workers MaxBusy us",
+                "Physics LOS Cache Size",
+                "Physics LOS Cache Get",
+                "Physics LOS Cache Hit",
+                "Physics Broadphase Static",
+                "Physics Broadphase Dynamic",
+                "Physics Broadphase Pairs",
+                "Physics Broadphase AABB Updates",
+            };
+
+            constexpr std::string_view skinning[] = {
+                "Skinning Performed",
+                "Skinning Skipped",
+            };
+
+            constexpr std::string_view objectPaging[] = {
+                "Object Chunk Memory",
+                "Object Chunk Build us",
+            };
+
+            constexpr std::string_view terrain[] = {
+                "Terrain Chunk Memory",
+                "Terrain Chunks Built/s",
             };
 
             std::vector<std::string> statNames;
@@ -149,6 +194,27 @@ namespace Resource
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            for (std::string_view name : physics)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : skinning)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : objectPaging)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : terrain)
+                statNames.emplace_back(name);
+
             return statNames;
         }
 
@@ -0,0 +1,471 @@
+#include "geometrydiskcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/atomicfile.hpp>
+#include <components/files/conversion.hpp>
+#include <components/misc/strings/conversion.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+
+#include <smhasher/MurmurHash3.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Increment when the header or the data layout is changed
+        constexpr std::uint32_t formatVersion = 1;
+
+        constexpr std::uint32_t magic = 0x4d4f4547; // "GEOM" for little endian
+
+        struct Header
+        {
+            std::uint32_t mMagic = magic;
+            std::uint32_t mFormatVersion = formatVersion;
+            std::uint32_t mNumStateSets = 0;
+            std::uint32_t mDataSize = 0;
+            std::array<std::uint64_t, 2> mDataHash{ 0, 0 };
+        };
+
+        enum class NodeType : std::uint8_t
+        {
+            Group = 0,
+            Geometry = 1,
+        };
+
+        std::array<std::uint64_t, 2> getHash(const void* data, std::size_t size)
+        {
+            std::array<std::uint64_t, 2> result{ 0, 0 };
+            MurmurHash3_x64_128(data, static_cast<int>(size), 0, result.data());
+            return result;
+        }
+
+        bool isSupported(osg::Array::Type type)
+        {
+            switch (type)
+            {
+                case osg::Array::FloatArrayType:
+                case osg::Array::Vec2ArrayType:
+                case osg::Array::Vec3ArrayType:
+                case osg::Array::Vec4ArrayType:
+                case osg::Array::Vec4ubArrayType:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool isSupported(osg::PrimitiveSet::Type type)
+        {
+            switch (type)
+            {
+                case osg::PrimitiveSet::DrawArraysPrimitiveType:
+                case osg::PrimitiveSet::DrawElementsUBytePrimitiveType:
+                case osg::PrimitiveSet::DrawElementsUShortPrimitiveType:
+                case osg::PrimitiveSet::DrawElementsUIntPrimitiveType:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool hasCallbacks(const osg::Node& node)
+        {
+            return node.getUpdateCallback() != nullptr || node.getEventCallback() != nullptr
+                || node.getCullCallback() != nullptr;
+        }
+
+        class Writer
+        {
+        public:
+            explicit Writer(std::span<osg::StateSet* const> stateSets)
+            {
+                for (std::size_t i = 0; i < stateSets.size(); ++i)
+                    mStateSetIndices.emplace(stateSets[i], static_cast<std::int32_t>(i));
+            }
+
+            const std::string& getData() const { return mData; }
+
+            bool writeNode(const osg::Node& node)
+            {
+                if (hasCallbacks(node) || node.getUserDataContainer() != nullptr)
+                    return false;
+                if (typeid(node) == typeid(osg::Group))
+                    return writeGroup(static_cast<const osg::Group&>(node));
+                if (typeid(node) == typeid(osg::Geometry))
+                    return writeGeometry(static_cast<const osg::Geometry&>(node));
+                return false;
+            }
+
+        private:
+            std::string mData;
+            std::unordered_map<const osg::StateSet*, std::int32_t> mStateSetIndices;
+
+            template <class T>
+            void write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                writeBytes(&value, sizeof(value));
+            }
+
+            void writeBytes(const void* data, std::size_t size) { mData.append(static_cast<const char*>(data), size); }
+
+            bool writeNodeHeader(const osg::Node& node, NodeType type)
+            {
+                std::int32_t stateSet = -1;
+                if (const osg::StateSet* value = node.getStateSet())
+                {
+                    const auto it = mStateSetIndices.find(value);
+                    if (it == mStateSetIndices.end())
+                        return false;
+                    stateSet = it->second;
+                }
+                write(type);
+                write(static_cast<std::uint32_t>(node.getNodeMask()));
+                write(stateSet);
+                return true;
+            }
+
+            bool writeGroup(const osg::Group& group)
+            {
+                if (!writeNodeHeader(group, NodeType::Group))
+                    return false;
+                write(static_cast<std::uint32_t>(group.getNumChildren()));
+                for (unsigned int i = 0; i < group.getNumChildren(); ++i)
+                    if (!writeNode(*group.getChild(i)))
+                        return false;
+                return true;
+            }
+
+            bool writeArray(const osg::Array* array)
+            {
+                if (array == nullptr)
+                {
+                    write(std::uint8_t{ 0 });
+                    return true;
+                }
+                if (!isSupported(array->getType()))
+                    return false;
+                write(std::uint8_t{ 1 });
+                write(static_cast<std::int32_t>(array->getType()));
+                write(static_cast<std::int32_t>(array->getBinding()));
+                write(static_cast<std::uint8_t>(array->getNormalize()));
+                write(static_cast<std::uint32_t>(array->getNumElements()));
+                writeBytes(array->getDataPointer(), array->getTotalDataSize());
+                return true;
+            }
+
+            bool writeArrayList(const osg::Geometry::ArrayList& arrays)
+            {
+                write(static_cast<std::uint32_t>(arrays.size()));
+                for (const osg::ref_ptr<osg::Array>& array : arrays)
+                    if (!writeArray(array))
+                        return false;
+                return true;
+            }
+
+            bool writePrimitiveSet(const osg::PrimitiveSet& primitiveSet)
+            {
+                if (!isSupported(primitiveSet.getType()))
+                    return false;
+                write(static_cast<std::int32_t>(primitiveSet.getType()));
+                write(static_cast<std::uint32_t>(primitiveSet.getMode()));
+                write(static_cast<std::int32_t>(primitiveSet.getNumInstances()));
+                if (primitiveSet.getType() == osg::PrimitiveSet::DrawArraysPrimitiveType)
+                {
+                    const auto& drawArrays = static_cast<const osg::DrawArrays&>(primitiveSet);
+                    write(static_cast<std::int32_t>(drawArrays.getFirst()));
+                    write(static_cast<std::int32_t>(drawArrays.getCount()));
+                    return true;
+                }
+                write(static_cast<std::uint32_t>(primitiveSet.getNumIndices()));
+                writeBytes(primitiveSet.getDataPointer(), primitiveSet.getTotalDataSize());
+                return true;
+            }
+
+            bool writeGeometry(const osg::Geometry& geometry)
+            {
+                if (geometry.getDrawCallback() != nullptr || geometry.getComputeBoundingBoxCallback() != nullptr)
+                    return false;
+                if (!writeNodeHeader(geometry, NodeType::Geometry))
+                    return false;
+                write(static_cast<std::uint8_t>(geometry.getUseDisplayList()));
+                write(static_cast<std::uint8_t>(geometry.getUseVertexBufferObjects()));
+                if (!writeArray(geometry.getVertexArray()) || !writeArray(geometry.getNormalArray())
+                    || !writeArray(geometry.getColorArray()) || !writeArray(geometry.getSecondaryColorArray())
+                    || !writeArray(geometry.getFogCoordArray()) || !writeArrayList(geometry.getTexCoordArrayList())
+                    || !writeArrayList(geometry.getVertexAttribArrayList()))
+                    return false;
+                write(static_cast<std::uint32_t>(geometry.getNumPrimitiveSets()));
+                for (unsigned int i = 0; i < geometry.getNumPrimitiveSets(); ++i)
+                    if (!writePrimitiveSet(*geometry.getPrimitiveSet(i)))
+                        return false;
+                return true;
+            }
+        };
+
+        class Reader
+        {
+        public:
+            explicit Reader(std::string_view data, std::span<osg::StateSet* const> stateSets)
+                : mData(data)
+                , mStateSets(stateSets)
+            {
+            }
+
+            bool isEnd() const { return mPosition == mData.size(); }
+
+            osg::ref_ptr<osg::Node> readNode()
+            {
+                const NodeType type = read<NodeType>();
+                const std::uint32_t nodeMask = read<std::uint32_t>();
+                const std::int32_t stateSet = read<std::int32_t>();
+                osg::ref_ptr<osg::Node> node;
+                switch (type)
+                {
+                    case NodeType::Group:
+                        node = readGroup();
+                        break;
+                    case NodeType::Geometry:
+                        node = readGeometry();
+                        break;
+                    default:
+                        throw std::runtime_error("Invalid node type: " + std::to_string(static_cast<int>(type)));
+                }
+                node->setNodeMask(nodeMask);
+                node->setDataVariance(osg::Object::STATIC);
+                if (stateSet >= 0)
+                {
+                    if (static_cast<std::size_t>(stateSet) >= mStateSets.size())
+                        throw std::runtime_error("Invalid state set index: " + std::to_string(stateSet));
+                    node->setStateSet(mStateSets[static_cast<std::size_t>(stateSet)]);
+                }
+                return node;
+            }
+
+        private:
+            std::string_view mData;
+            std::span<osg::StateSet* const> mStateSets;
+            std::size_t mPosition = 0;
+
+            template <class T>
+            T read()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value;
+                readBytes(&value, sizeof(value));
+                return value;
+            }
+
+            void readBytes(void* data, std::size_t size)
+            {
+                if (size > mData.size() - mPosition)
+                    throw std::runtime_error("Unexpected end of data");
+                std::memcpy(data, mData.data() + mPosition, size);
+                mPosition += size;
+            }
+
+            osg::ref_ptr<osg::Node> readGroup()
+            {
+                osg::ref_ptr<osg::Group> group = new osg::Group;
+                const std::uint32_t numChildren = read<std::uint32_t>();
+                for (std::uint32_t i = 0; i < numChildren; ++i)
+                    group->addChild(readNode());
+                return group;
+            }
+
+            template <class T>
+            osg::ref_ptr<osg::Array> readArrayData(std::uint32_t numElements)
+            {
+                osg::ref_ptr<T> array = new T(numElements);
+                readBytes(array->asVector().data(), array->getTotalDataSize());
+                return array;
+            }
+
+            osg::ref_ptr<osg::Array> readArray()
+            {
+                if (read<std::uint8_t>() == 0)
+                    return nullptr;
+                const auto type = static_cast<osg::Array::Type>(read<std::int32_t>());
+                const auto binding = static_cast<osg::Array::Binding>(read<std::int32_t>());
+                const bool normalize = read<std::uint8_t>() != 0;
+                const std::uint32_t numElements = read<std::uint32_t>();
+                osg::ref_ptr<osg::Array> array;
+                switch (type)
+                {
+                    case osg::Array::FloatArrayType:
+                        array = readArrayData<osg::FloatArray>(numElements);
+                        break;
+                    case osg::Array::Vec2ArrayType:
+                        array = readArrayData<osg::Vec2Array>(numElements);
+                        break;
+                    case osg::Array::Vec3ArrayType:
+                        array = readArrayData<osg::Vec3Array>(numElements);
+                        break;
+                    case osg::Array::Vec4ArrayType:
+                        array = readArrayData<osg::Vec4Array>(numElements);
+                        break;
+                    case osg::Array::Vec4ubArrayType:
+                        array = readArrayData<osg::Vec4ubArray>(numElements);
+                        break;
+                    default:
+                        throw std::runtime_error("Unsupported array type: " + std::to_string(static_cast<int>(type)));
+                }
+                array->setBinding(binding);
+                array->setNormalize(normalize);
+                return array;
+            }
+
+            template <class T>
+            osg::ref_ptr<osg::PrimitiveSet> readDrawElements(GLenum mode)
+            {
+                const std::uint32_t numIndices = read<std::uint32_t>();
+                osg::ref_ptr<T> result = new T(mode, numIndices);
+                readBytes(result->asVector().data(), result->getTotalDataSize());
+                return result;
+            }
+
+            osg::ref_ptr<osg::PrimitiveSet> readPrimitiveSet()
+            {
+                const auto type = static_cast<osg::PrimitiveSet::Type>(read<std::int32_t>());
+                const auto mode = static_cast<GLenum>(read<std::uint32_t>());
+                const std::int32_t numInstances = read<std::int32_t>();
+                osg::ref_ptr<osg::PrimitiveSet> result;
+                switch (type)
+                {
+                    case osg::PrimitiveSet::DrawArraysPrimitiveType:
+                    {
+                        const std::int32_t first = read<std::int32_t>();
+                        const std::int32_t count = read<std::int32_t>();
+                        result = new osg::DrawArrays(mode, first, count);
+                        break;
+                    }
+                    case osg::PrimitiveSet::DrawElementsUBytePrimitiveType:
+                        result = readDrawElements<osg::DrawElementsUByte>(mode);
+                        break;
+                    case osg::PrimitiveSet::DrawElementsUShortPrimitiveType:
+                        result = readDrawElements<osg::DrawElementsUShort>(mode);
+                        break;
+                    case osg::PrimitiveSet::DrawElementsUIntPrimitiveType:
+                        result = readDrawElements<osg::DrawElementsUInt>(mode);
+                        break;
+                    default:
+                        throw std::runtime_error(
+                            "Unsupported primitive set type: " + std::to_string(static_cast<int>(type)));
+                }
+                result->setNumInstances(numInstances);
+                return result;
+            }
+
+            osg::ref_ptr<osg::Node> readGeometry()
+            {
+                osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+                geometry->setUseDisplayList(read<std::uint8_t>() != 0);
+                geometry->setUseVertexBufferObjects(read<std::uint8_t>() != 0);
+                geometry->setVertexArray(readArray());
+                geometry->setNormalArray(readArray());
+                geometry->setColorArray(readArray());
+                geometry->setSecondaryColorArray(readArray());
+                geometry->setFogCoordArray(readArray());
+                const std::uint32_t numTexCoordArrays = read<std::uint32_t>();
+                for (std::uint32_t i = 0; i < numTexCoordArrays; ++i)
+                    geometry->setTexCoordArray(i, readArray());
+                const std::uint32_t numVertexAttribArrays = read<std::uint32_t>();
+                for (std::uint32_t i = 0; i < numVertexAttribArrays; ++i)
+                    geometry->setVertexAttribArray(i, readArray());
+                const std::uint32_t numPrimitiveSets = read<std::uint32_t>();
+                for (std::uint32_t i = 0; i < numPrimitiveSets; ++i)
+                    geometry->addPrimitiveSet(readPrimitiveSet());
+                return geometry;
+            }
+        };
+    }
+
+    GeometryDiskCache::GeometryDiskCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to create geometry cache directory " << Files::pathToUnicodeString(mPath)
+                                << ": " << ec.message();
+    }
+
+    osg::ref_ptr<osg::Group> GeometryDiskCache::load(
+        std::string_view key, std::span<osg::StateSet* const> stateSets) const
+    {
+        const std::filesystem::path filePath = getFilePath(key);
+        std::ifstream stream(filePath, std::ios::binary);
+        if (!stream)
+            return nullptr;
+
+        Header header;
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.mMagic != magic
+            || header.mFormatVersion != formatVersion || header.mNumStateSets != stateSets.size())
+            return nullptr;
+
+        std::string data(header.mDataSize, '\0');
+        if (!stream.read(data.data(), static_cast<std::streamsize>(data.size()))
+            || getHash(data.data(), data.size()) != header.mDataHash)
+        {
+            Log(Debug::Warning) << "Ignoring corrupted geometry cache file " << Files::pathToUnicodeString(filePath);
+            return nullptr;
+        }
+
+        try
+        {
+            Reader reader(data, stateSets);
+            osg::ref_ptr<osg::Node> node = reader.readNode();
+            if (!reader.isEnd() || node->asGroup() == nullptr)
+                throw std::runtime_error("Unexpected data after root node");
+            return node->asGroup();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Ignoring invalid geometry cache file " << Files::pathToUnicodeString(filePath)
+                                << ": " << e.what();
+            return nullptr;
+        }
+    }
+
+    bool GeometryDiskCache::store(
+        std::string_view key, const osg::Group& group, std::span<osg::StateSet* const> stateSets) const
+    {
+        Writer writer(stateSets);
+        if (!writer.writeNode(group))
+            return false;
+
+        const std::string& data = writer.getData();
+        Header header;
+        header.mNumStateSets = static_cast<std::uint32_t>(stateSets.size());
+        header.mDataSize = static_cast<std::uint32_t>(data.size());
+        header.mDataHash = getHash(data.data(), data.size());
+
+        return Files::writeFileAtomically(getFilePath(key), [&](std::ostream& stream) {
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            return static_cast<bool>(stream);
+        });
+    }
+
+    std::filesystem::path GeometryDiskCache::getFilePath(std::string_view key) const
+    {
+        const std::array<std::uint64_t, 2> hash = getHash(key.data(), key.size());
+        std::string name = Misc::StringUtils::toHex(
+            std::string_view(reinterpret_cast<const char*>(hash.data()), sizeof(hash)));
+        name += ".geom";
+        return mPath / name;
+    }
+}
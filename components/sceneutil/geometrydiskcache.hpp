@@ -0,0 +1,41 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_GEOMETRYDISKCACHE_H
+#define OPENMW_COMPONENTS_SCENEUTIL_GEOMETRYDISKCACHE_H
+
+#include <osg/ref_ptr>
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace osg
+{
+    class Group;
+    class StateSet;
+}
+
+namespace SceneUtil
+{
+    /// Stores static subgraphs made of plain groups and geometries on disk, e.g. merged geometry of object paging
+    /// chunks. State sets are not serialized but referenced by index in a list provided by the caller, so the same list
+    /// has to be used for loading and storing.
+    /// @note May be used from any thread.
+    class GeometryDiskCache
+    {
+    public:
+        explicit GeometryDiskCache(const std::filesystem::path& path);
+
+        /// Key has to identify everything the subgraph is built from.
+        /// @return nullptr when there is no valid file for the key.
+        osg::ref_ptr<osg::Group> load(std::string_view key, std::span<osg::StateSet* const> stateSets) const;
+
+        /// @return false when the subgraph has nodes, callbacks, arrays or state sets that can't be stored.
+        bool store(std::string_view key, const osg::Group& group, std::span<osg::StateSet* const> stateSets) const;
+
+    private:
+        std::filesystem::path mPath;
+
+        std::filesystem::path getFilePath(std::string_view key) const;
+    };
+}
+
+#endif
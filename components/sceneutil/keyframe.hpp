@@ -35,6 +35,10 @@ namespace SceneUtil
 
         virtual KfTransform getCurrentTransformation(osg::NodeVisitor* nv) { return KfTransform(); }
 
+        /// Computes the transformation for the current input value in advance so the update traversal only has to
+        /// apply it. Requires a source not using the node visitor. Different controllers may be prepared concurrently.
+        virtual void prepareTransformation() {}
+
         /// @note We could drop this function in favour of osg::Object::asCallback from OSG 3.6 on.
         virtual osg::Callback* getAsCallback() = 0;
     };
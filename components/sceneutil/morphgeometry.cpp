@@ -2,14 +2,56 @@
 
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
 #include <cassert>
 #include <components/resource/scenemanager.hpp>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        void addDenseOffsets(const osg::Vec3Array& offsets, float weight, std::size_t size, osg::Vec3f* destination)
+        {
+            // Process components as a flat array so the loop is vectorized
+            static_assert(sizeof(osg::Vec3f) == 3 * sizeof(float));
+            const float* const source = offsets.front().ptr();
+            float* const result = destination->ptr();
+            const std::size_t count = std::min(offsets.size(), size) * 3;
+            for (std::size_t i = 0; i < count; ++i)
+                result[i] += source[i] * weight;
+        }
+
+        void addSparseOffsets(const osg::UIntArray& indices, const osg::Vec3Array& offsets, float weight,
+            std::size_t size, osg::Vec3f* destination)
+        {
+            assert(indices.size() == offsets.size());
+            for (std::size_t i = 0; i < indices.size(); ++i)
+                if (indices[i] < size)
+                    destination[indices[i]] += offsets[i] * weight;
+        }
+    }
+
+    void blendMorphTargets(const MorphGeometry::MorphTargetList& targets, osg::Vec3f* destination)
+    {
+        const osg::Vec3Array& positions = *targets[0].getOffsets();
+        std::copy(positions.begin(), positions.end(), destination);
+
+        for (std::size_t i = 1; i < targets.size(); ++i)
+        {
+            const MorphGeometry::MorphTarget& target = targets[i];
+            const float weight = target.getWeight();
+            if (weight == 0.f || target.getOffsets()->empty())
+                continue;
+            if (target.isSparse())
+                addSparseOffsets(*target.getIndices(), *target.getOffsets(), weight, positions.size(), destination);
+            else
+                addDenseOffsets(*target.getOffsets(), weight, positions.size(), destination);
+        }
+    }
 
     MorphGeometry::MorphGeometry()
-        : mLastFrameNumber(0)
+        : mCurrentGeometry(0)
+        , mLastFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
     {
@@ -18,6 +60,7 @@ namespace SceneUtil
     MorphGeometry::MorphGeometry(const MorphGeometry& copy, const osg::CopyOp& copyop)
         : osg::Drawable(copy, copyop)
         , mMorphTargets(copy.mMorphTargets)
+        , mCurrentGeometry(0)
         , mLastFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
@@ -71,6 +114,14 @@ namespace SceneUtil
         dirty();
     }
 
+    void MorphGeometry::addMorphTarget(osg::UIntArray* indices, osg::Vec3Array* offsets, float weight)
+    {
+        assert(!mMorphTargets.empty());
+        mMorphTargets.push_back(MorphTarget(indices, offsets, weight));
+        mMorphedBoundingBox = false;
+        dirty();
+    }
+
     void MorphGeometry::dirty()
     {
         mDirty = true;
@@ -111,7 +162,7 @@ namespace SceneUtil
 
     void MorphGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
+        mGeometry[mCurrentGeometry]->accept(func);
     }
 
     osg::BoundingBox MorphGeometry::computeBoundingBox() const
@@ -151,9 +202,13 @@ namespace SceneUtil
             for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
             {
                 const osg::Vec3Array& offsets = *mMorphTargets[i].getOffsets();
-                for (unsigned int j = 0; j < offsets.size() && j < vertBounds.size(); ++j)
+                const osg::UIntArray* indices = mMorphTargets[i].getIndices();
+                for (unsigned int j = 0; j < offsets.size(); ++j)
                 {
-                    osg::BoundingBox& bounds = vertBounds[j];
+                    const unsigned int vertex = indices != nullptr ? (*indices)[j] : j;
+                    if (vertex >= vertBounds.size())
+                        continue;
+                    osg::BoundingBox& bounds = vertBounds[vertex];
                     bounds.expandBy(bounds._max + offsets[j]);
                     bounds.expandBy(bounds._min + offsets[j]);
                 }
@@ -172,9 +227,10 @@ namespace SceneUtil
 
     void MorphGeometry::cull(osg::NodeVisitor* nv)
     {
+        // Weights are changed only by the animation so the previous result is kept until it moves
         if (mLastFrameNumber == nv->getTraversalNumber() || !mDirty || mMorphTargets.size() == 0)
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+            osg::Geometry& geom = *mGeometry[mCurrentGeometry];
             nv->pushOntoNodePath(&geom);
             nv->apply(geom);
             nv->popFromNodePath();
@@ -183,23 +239,12 @@ namespace SceneUtil
 
         mDirty = false;
         mLastFrameNumber = nv->getTraversalNumber();
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+        mCurrentGeometry = 1 - mCurrentGeometry;
+        osg::Geometry& geom = *mGeometry[mCurrentGeometry];
 
-        const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
         osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        assert(positionSrc->size() == positionDst->size());
-        for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-            (*positionDst)[vertex] = (*positionSrc)[vertex];
-
-        for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
-        {
-            float weight = mMorphTargets[i].getWeight();
-            if (weight == 0.f)
-                continue;
-            const osg::Vec3Array* offsets = mMorphTargets[i].getOffsets();
-            for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-                (*positionDst)[vertex] += (*offsets)[vertex] * weight;
-        }
+        assert(mMorphTargets[0].getOffsets()->size() == positionDst->size());
+        blendMorphTargets(mMorphTargets, positionDst->asVector().data());
 
         positionDst->dirty();
 
@@ -210,9 +255,4 @@ namespace SceneUtil
         nv->popFromNodePath();
     }
 
-    osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
-    {
-        return mGeometry[frame % 2];
-    }
-
 }
@@ -3,6 +3,8 @@
 
 #include <osg/Geometry>
 
+#include <vector>
+
 namespace SceneUtil
 {
 
@@ -31,6 +33,8 @@ namespace SceneUtil
         {
         protected:
             osg::ref_ptr<osg::Vec3Array> mOffsets;
+            // Vertex index for each offset, null when there is an offset for every vertex
+            osg::ref_ptr<osg::UIntArray> mIndices;
             float mWeight;
 
         public:
@@ -39,17 +43,30 @@ namespace SceneUtil
                 , mWeight(w)
             {
             }
+            MorphTarget(osg::UIntArray* indices, osg::Vec3Array* offsets, float w = 1.0)
+                : mOffsets(offsets)
+                , mIndices(indices)
+                , mWeight(w)
+            {
+            }
             void setWeight(float weight) { mWeight = weight; }
             float getWeight() const { return mWeight; }
             osg::Vec3Array* getOffsets() { return mOffsets.get(); }
             const osg::Vec3Array* getOffsets() const { return mOffsets.get(); }
             void setOffsets(osg::Vec3Array* offsets) { mOffsets = offsets; }
+            const osg::UIntArray* getIndices() const { return mIndices.get(); }
+            bool isSparse() const { return mIndices != nullptr; }
         };
 
         typedef std::vector<MorphTarget> MorphTargetList;
 
+        /// @note The first target holds the base vertex positions, the following ones hold offsets from them.
         virtual void addMorphTarget(osg::Vec3Array* offsets, float weight = 1.0);
 
+        /// Adds a target moving only the vertices with the given indices. Saves memory and blending time for targets
+        /// affecting a small part of the mesh, such as facial animation. Can't be the first target.
+        void addMorphTarget(osg::UIntArray* indices, osg::Vec3Array* offsets, float weight = 1.0);
+
         /** Set the MorphGeometry dirty.*/
         void dirty();
 
@@ -81,7 +98,9 @@ namespace SceneUtil
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
-        osg::Geometry* getGeometry(unsigned int frame) const;
+        // Index of the geometry holding the latest blending result. A new result is written into the other one which
+        // was not drawn by the previous frame.
+        unsigned int mCurrentGeometry;
 
         unsigned int mLastFrameNumber;
         bool mDirty; // Have any morph targets changed?
@@ -89,6 +108,10 @@ namespace SceneUtil
         mutable bool mMorphedBoundingBox;
     };
 
+    /// Writes positions of the first target with offsets of the others applied according to their weights.
+    /// @note Destination has to have the size of the first target.
+    void blendMorphTargets(const MorphGeometry::MorphTargetList& targets, osg::Vec3f* destination);
+
 }
 
 #endif
@@ -0,0 +1,89 @@
+#include "paralleljobs.hpp"
+
+#include "workqueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        class ParallelJobs
+        {
+        public:
+            explicit ParallelJobs(std::size_t count, std::function<void(std::size_t)>&& job)
+                : mCount(count)
+                , mJob(std::move(job))
+            {
+            }
+
+            void run()
+            {
+                std::size_t index = 0;
+                while ((index = mNext.fetch_add(1, std::memory_order_relaxed)) < mCount)
+                {
+                    mJob(index);
+                    if (mDone.fetch_add(1, std::memory_order_acq_rel) + 1 == mCount)
+                    {
+                        const std::lock_guard lock(mMutex);
+                        mHasFinished.notify_all();
+                    }
+                }
+            }
+
+            void wait()
+            {
+                std::unique_lock lock(mMutex);
+                mHasFinished.wait(lock, [&] { return mDone.load(std::memory_order_acquire) == mCount; });
+            }
+
+        private:
+            const std::size_t mCount;
+            // Captures of the job may be dangling once the caller has returned but then there is nothing to call
+            const std::function<void(std::size_t)> mJob;
+            std::atomic_size_t mNext{ 0 };
+            std::atomic_size_t mDone{ 0 };
+            std::mutex mMutex;
+            std::condition_variable mHasFinished;
+        };
+
+        class ParallelJobsWorkItem final : public WorkItem
+        {
+        public:
+            explicit ParallelJobsWorkItem(std::shared_ptr<ParallelJobs> jobs)
+                : mJobs(std::move(jobs))
+            {
+            }
+
+            void doWork() override { mJobs->run(); }
+
+        private:
+            std::shared_ptr<ParallelJobs> mJobs;
+        };
+    }
+
+    void runParallelJobs(WorkQueue* workQueue, std::size_t count, std::function<void(std::size_t)> job)
+    {
+        if (count == 0)
+            return;
+
+        // The calling thread takes one share so more work items than threads would only wait in the queue
+        const std::size_t workItems = workQueue == nullptr ? 0 : std::min(count - 1, workQueue->getNumThreads());
+        if (workItems == 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                job(i);
+            return;
+        }
+
+        const auto jobs = std::make_shared<ParallelJobs>(count, std::move(job));
+        for (std::size_t i = 0; i < workItems; ++i)
+            workQueue->addWorkItem(new ParallelJobsWorkItem(jobs), true);
+        jobs->run();
+        jobs->wait();
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_PARALLELJOBS_H
+#define OPENMW_COMPONENTS_SCENEUTIL_PARALLELJOBS_H
+
+#include <cstddef>
+#include <functional>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+
+    /// @brief Calls job for each index in [0, count) from the calling thread and the work queue threads and returns
+    /// when all calls are done.
+    /// @par Work items are added to the front of the queue to not wait behind loading tasks. The calling thread does
+    /// the jobs nobody has started, so it never waits for work queue threads busy with something else.
+    /// @param workQueue May be nullptr to run all jobs on the calling thread.
+    void runParallelJobs(WorkQueue* workQueue, std::size_t count, std::function<void(std::size_t)> job);
+}
+
+#endif
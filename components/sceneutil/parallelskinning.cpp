@@ -0,0 +1,56 @@
+#include "parallelskinning.hpp"
+
+#include "paralleljobs.hpp"
+#include "riggeometry.hpp"
+#include "workqueue.hpp"
+
+#include <osg/Geometry>
+
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        struct SkinningJob
+        {
+            osg::ref_ptr<RigGeometry> mRig;
+            osg::ref_ptr<osg::Geometry> mTarget;
+        };
+
+        // Each cull thread has its own traversal
+        thread_local std::vector<SkinningJob>* sDeferredJobs = nullptr;
+    }
+
+    ParallelSkinningCallback::ParallelSkinningCallback(osg::ref_ptr<WorkQueue> workQueue)
+        : mWorkQueue(std::move(workQueue))
+    {
+    }
+
+    ParallelSkinningCallback::~ParallelSkinningCallback() = default;
+
+    void ParallelSkinningCallback::operator()(osg::Node* node, osg::NodeVisitor* nv)
+    {
+        // Nested traversal is covered by the outer one
+        if (sDeferredJobs != nullptr)
+        {
+            traverse(node, nv);
+            return;
+        }
+
+        std::vector<SkinningJob> jobs;
+        sDeferredJobs = &jobs;
+        traverse(node, nv);
+        sDeferredJobs = nullptr;
+
+        runParallelJobs(mWorkQueue.get(), jobs.size(), [&](std::size_t i) { jobs[i].mRig->skin(*jobs[i].mTarget); });
+    }
+
+    bool deferSkinning(RigGeometry& rig, osg::Geometry& target)
+    {
+        if (sDeferredJobs == nullptr)
+            return false;
+        sDeferredJobs->push_back(SkinningJob{ .mRig = &rig, .mTarget = &target });
+        return true;
+    }
+}
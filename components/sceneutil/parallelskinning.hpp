@@ -0,0 +1,40 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_PARALLELSKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_PARALLELSKINNING_H
+
+#include "nodecallback.hpp"
+
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class Geometry;
+}
+
+namespace SceneUtil
+{
+    class RigGeometry;
+    class WorkQueue;
+
+    /// @brief Cull callback deferring skinning of all RigGeometry culled below the node until its traversal is done.
+    /// Deferred skinning is done in parallel by the cull thread and the work queue threads before the callback
+    /// returns, so the results are ready before drawing.
+    class ParallelSkinningCallback : public SceneUtil::NodeCallback<ParallelSkinningCallback>
+    {
+    public:
+        explicit ParallelSkinningCallback(osg::ref_ptr<WorkQueue> workQueue);
+
+        ~ParallelSkinningCallback();
+
+        void operator()(osg::Node* node, osg::NodeVisitor* nv);
+
+    private:
+        osg::ref_ptr<WorkQueue> mWorkQueue;
+    };
+
+    /// Called from the cull traversal.
+    /// @return false when no ParallelSkinningCallback is running on this thread and skinning has to be done by the
+    /// caller.
+    bool deferSkinning(RigGeometry& rig, osg::Geometry& target);
+}
+
+#endif
@@ -4,10 +4,13 @@
 
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
+
 #include <components/debug/debuglog.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/resource/scenemanager.hpp>
 
+#include "parallelskinning.hpp"
 #include "skeleton.hpp"
 #include "util.hpp"
 
@@ -146,78 +149,81 @@ namespace SceneUtil
                 return;
         }
 
-        unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        const unsigned int traversalNumber = nv->getTraversalNumber();
+        // The result is shared by all cull passes of a frame (main, shadow and reflection cameras) and kept while the
+        // skeleton is inactive or a distant geometry waits for its next update
+        if (mLastFrameNumber == traversalNumber
+            || (mLastFrameNumber != 0 && (!mSkeleton->getActive() || !isSkinningDue(*nv, traversalNumber))))
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+            mLastFrameNumber = traversalNumber;
+            sSkinningSkipped.fetch_add(1, std::memory_order_relaxed);
+            osg::Geometry& geom = *mGeometry[mCurrentGeometry];
             nv->pushOntoNodePath(&geom);
             nv->apply(geom);
             nv->popFromNodePath();
             return;
         }
         mLastFrameNumber = traversalNumber;
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+        mLastSkinnedFrameNumber = traversalNumber;
+        mCurrentGeometry = 1 - mCurrentGeometry;
+        sSkinningPerformed.fetch_add(1, std::memory_order_relaxed);
+        osg::Geometry& geom = *mGeometry[mCurrentGeometry];
 
         mSkeleton->updateBoneMatrices(traversalNumber);
 
-        // skinning
-        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-        const osg::Vec4Array* tangentSrc = mSourceTangents;
-
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
-
-        std::vector<osg::Matrixf> boneMatrices(mNodes.size());
-        std::vector<Bone*>::const_iterator bone = mNodes.begin();
-        std::vector<BoneInfo>::const_iterator boneInfo = mData->mBones.begin();
-        for (osg::Matrixf& boneMat : boneMatrices)
+        mBoneMatrices.resize(mNodes.size());
+        for (std::size_t i = 0; i < mNodes.size(); ++i)
         {
-            if (*bone != nullptr)
-                boneMat = boneInfo->mInvBindMatrix * (*bone)->mMatrixInSkeletonSpace;
-            ++bone;
-            ++boneInfo;
+            // Zero matrix has no influence on the blended one
+            if (mNodes[i] != nullptr)
+                mBoneMatrices[i] = mData->mBones[i].mInvBindMatrix * mNodes[i]->mMatrixInSkeletonSpace;
+            else
+                mBoneMatrices[i].set(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
         }
 
-        osg::Matrixf transform;
         if (mSkinToSkelMatrix)
-            transform = (*mSkinToSkelMatrix) * mData->mTransform;
+            mSkinTransform = (*mSkinToSkelMatrix) * mData->mTransform;
         else
-            transform = mData->mTransform;
+            mSkinTransform = mData->mTransform;
 
-        for (const auto& [influences, vertices] : mData->mInfluences)
-        {
-            osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+        if (!deferSkinning(*this, geom))
+            skin(geom);
 
-            for (const auto& [index, weight] : influences)
-            {
-                if (mNodes[index] == nullptr)
-                    continue;
-                const float* boneMatPtr = boneMatrices[index].ptr();
-                float* resultMatPtr = resultMat.ptr();
-                for (int i = 0; i < 16; ++i, ++resultMatPtr, ++boneMatPtr)
-                    if (i % 4 != 3)
-                        *resultMatPtr += *boneMatPtr * weight;
-            }
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+    }
 
-            resultMat *= transform;
+    bool RigGeometry::isSkinningDue(osg::NodeVisitor& nv, unsigned int traversalNumber) const
+    {
+        if (sSkinningLodDistance <= 0 || traversalNumber - mLastSkinnedFrameNumber >= sSkinningLodInterval)
+            return true;
+        // Shadow cameras use the main camera as reference view point so all passes agree on the distance
+        return nv.getDistanceToViewPoint(getBound().center(), true) <= sSkinningLodDistance;
+    }
 
-            for (unsigned short vertex : vertices)
-            {
-                (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-                if (normalDst)
-                    (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+    void RigGeometry::skin(osg::Geometry& geom) const
+    {
+        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+        const osg::Vec4Array* tangentSrc = mSourceTangents;
 
-                if (tangentDst)
-                {
-                    const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                    osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(
-                        osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                    (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-                }
-            }
-        }
+        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+
+        const SkinSource source{
+            .mPositions = positionSrc->asVector().data(),
+            .mNormals = normalSrc != nullptr ? normalSrc->asVector().data() : nullptr,
+            .mTangents = tangentSrc != nullptr ? tangentSrc->asVector().data() : nullptr,
+        };
+        const SkinDestination destination{
+            .mPositions = positionDst->asVector().data(),
+            .mNormals = normalDst != nullptr ? normalDst->asVector().data() : nullptr,
+            .mTangents = tangentDst != nullptr ? tangentDst->asVector().data() : nullptr,
+        };
+
+        skinVertices(mData->mInfluences, mBoneMatrices, mSkinTransform, source, destination);
 
         positionDst->dirty();
         if (normalDst)
@@ -226,10 +232,6 @@ namespace SceneUtil
             tangentDst->dirty();
 
         geom.osg::Drawable::dirtyGLObjects();
-
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
     }
 
     void RigGeometry::updateBounds(osg::NodeVisitor* nv)
@@ -336,13 +338,7 @@ namespace SceneUtil
         if (!mData)
             mData = new InfluenceData;
 
-        std::map<BoneWeights, VertexList> influencesToVertices;
-        for (size_t i = 0; i < influences.size(); i++)
-            influencesToVertices[influences[i]].emplace_back(static_cast<VertexList::value_type>(i));
-        influencesToVertices.erase(BoneWeights());
-
-        mData->mInfluences.reserve(influencesToVertices.size());
-        mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mData->mInfluences = groupSkinInfluences(influences);
     }
 
     void RigGeometry::setTransform(osg::Matrixf&& transform)
@@ -389,12 +385,21 @@ namespace SceneUtil
 
     void RigGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
+        mGeometry[mCurrentGeometry]->accept(func);
+    }
+
+    void RigGeometry::setSkinningLod(float distance, unsigned interval)
+    {
+        sSkinningLodDistance = distance;
+        sSkinningLodInterval = std::max(interval, 1u);
     }
 
-    osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
+    RigGeometry::SkinningStats RigGeometry::takeSkinningStats()
     {
-        return mGeometry[frame % 2].get();
+        return SkinningStats{
+            .mPerformed = sSkinningPerformed.exchange(0, std::memory_order_relaxed),
+            .mSkipped = sSkinningSkipped.exchange(0, std::memory_order_relaxed),
+        };
     }
 
 }
@@ -4,7 +4,12 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <atomic>
+#include <cstddef>
 #include <string_view>
+#include <vector>
+
+#include "skinning.hpp"
 
 namespace SceneUtil
 {
@@ -45,13 +50,16 @@ namespace SceneUtil
             osg::Matrixf mInvBindMatrix;
         };
 
-        using BoneWeight = std::pair<size_t, float>;
-        using BoneWeights = std::vector<BoneWeight>;
+        using BoneWeight = SceneUtil::BoneWeight;
+        using BoneWeights = SceneUtil::BoneWeights;
 
         void setBoneInfo(std::vector<BoneInfo>&& bones);
         // Convert influences in bone and weight list per vertex format
         void setInfluences(const std::vector<BoneWeights>& influences);
 
+        /// @note Has to be called after setInfluences.
+        const SkinInfluences& getInfluences() const { return mData->mInfluences; }
+
         /// Initialize this geometry from the source geometry.
         /// @note The source geometry will not be modified.
         void setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom);
@@ -66,6 +74,23 @@ namespace SceneUtil
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
 
+        /// Updates the internal geometry using bone matrices collected by the last cull traversal. Called by the cull
+        /// traversal itself or by ParallelSkinningCallback when skinning is deferred.
+        void skin(osg::Geometry& geom) const;
+
+        struct SkinningStats
+        {
+            std::size_t mPerformed = 0;
+            std::size_t mSkipped = 0;
+        };
+
+        /// Beyond the given distance to the view point the skinning is updated only once per given number of frames.
+        /// Zero distance or interval of 1 updates every frame.
+        static void setSkinningLod(float distance, unsigned interval);
+
+        /// Returns the number of cull passes which skinned geometry or reused a previous result since the last call.
+        static SkinningStats takeSkinningStats();
+
         struct CopyBoundingBoxCallback : osg::Drawable::ComputeBoundingBoxCallback
         {
             osg::BoundingBox boundingBox;
@@ -85,7 +110,9 @@ namespace SceneUtil
         void updateBounds(osg::NodeVisitor* nv);
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
-        osg::Geometry* getGeometry(unsigned int frame) const;
+        // Index of the geometry holding the latest skinning result. A new result is written into the other one which
+        // was not drawn by the previous frame.
+        unsigned int mCurrentGeometry{ 0 };
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
         osg::ref_ptr<const osg::Vec4Array> mSourceTangents;
@@ -93,22 +120,33 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::RefMatrix> mSkinToSkelMatrix;
 
-        using VertexList = std::vector<unsigned short>;
         struct InfluenceData : public osg::Referenced
         {
             std::vector<BoneInfo> mBones;
-            std::vector<std::pair<BoneWeights, VertexList>> mInfluences;
+            SkinInfluences mInfluences;
             osg::Matrixf mTransform;
             std::string mRootBone;
         };
         osg::ref_ptr<InfluenceData> mData;
         std::vector<Bone*> mNodes;
 
+        // Collected by the cull traversal for skinning which may be deferred
+        std::vector<osg::Matrixf> mBoneMatrices;
+        osg::Matrixf mSkinTransform;
+
         unsigned int mLastFrameNumber{ 0 };
+        unsigned int mLastSkinnedFrameNumber{ 0 };
         bool mBoundsFirstFrame{ true };
 
+        static inline float sSkinningLodDistance = 0;
+        static inline unsigned sSkinningLodInterval = 1;
+        static inline std::atomic_size_t sSkinningPerformed{ 0 };
+        static inline std::atomic_size_t sSkinningSkipped{ 0 };
+
         bool initFromParentSkeleton(osg::NodeVisitor* nv);
 
+        bool isSkinningDue(osg::NodeVisitor& nv, unsigned int traversalNumber) const;
+
         void updateSkinToSkelMatrix(const osg::NodePath& nodePath);
     };
 
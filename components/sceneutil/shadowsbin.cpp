@@ -115,6 +115,11 @@ namespace SceneUtil
                     state.mImportantState = true;
             }
 
+            // Instanced drawables need their divisors and the instancing uniform also when casting shadows.
+            found = attributes.lower_bound(std::make_pair(osg::StateAttribute::VERTEX_ATTRIB_DIVISOR, 0u));
+            if (found != attributes.end() && found->first.first == osg::StateAttribute::VERTEX_ATTRIB_DIVISOR)
+                state.mImportantState = true;
+
             if ((*itr) != sg && !state.interesting())
                 uninterestingCache.insert(*itr);
         }
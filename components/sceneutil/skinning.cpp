@@ -0,0 +1,106 @@
+#include "skinning.hpp"
+
+#include <map>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // First 3 columns of osg::Matrixf. The last column of an affine matrix is always (0, 0, 0, 1) so there is no
+        // need to blend it and to do perspective division done by osg::Matrixf::preMult. Fixed size loops without
+        // branches over plain float arrays are vectorized by compilers for the target instruction set.
+        struct AffineMatrix
+        {
+            float mValues[4][3];
+        };
+
+        void accumulate(const osg::Matrixf& bone, float weight, AffineMatrix& result)
+        {
+            for (int row = 0; row < 4; ++row)
+                for (int column = 0; column < 3; ++column)
+                    result.mValues[row][column] += bone(row, column) * weight;
+        }
+
+        AffineMatrix multiply(const AffineMatrix& lhs, const osg::Matrixf& rhs)
+        {
+            AffineMatrix result;
+            for (int row = 0; row < 4; ++row)
+                for (int column = 0; column < 3; ++column)
+                    result.mValues[row][column] = lhs.mValues[row][0] * rhs(0, column)
+                        + lhs.mValues[row][1] * rhs(1, column) + lhs.mValues[row][2] * rhs(2, column);
+            for (int column = 0; column < 3; ++column)
+                result.mValues[3][column] += rhs(3, column);
+            return result;
+        }
+
+        osg::Vec3f transformDirection(const AffineMatrix& matrix, const osg::Vec3f& value)
+        {
+            const auto& m = matrix.mValues;
+            return osg::Vec3f(m[0][0] * value.x() + m[1][0] * value.y() + m[2][0] * value.z(),
+                m[0][1] * value.x() + m[1][1] * value.y() + m[2][1] * value.z(),
+                m[0][2] * value.x() + m[1][2] * value.y() + m[2][2] * value.z());
+        }
+
+        osg::Vec3f transformPosition(const AffineMatrix& matrix, const osg::Vec3f& value)
+        {
+            const auto& m = matrix.mValues;
+            return transformDirection(matrix, value) + osg::Vec3f(m[3][0], m[3][1], m[3][2]);
+        }
+
+        // Optional arrays are checked once per call instead of once per vertex
+        template <bool withNormals, bool withTangents>
+        void skin(const SkinInfluences& influences, std::span<const osg::Matrixf> boneMatrices,
+            const osg::Matrixf& transform, const SkinSource& source, const SkinDestination& destination)
+        {
+            for (const auto& [weights, vertices] : influences)
+            {
+                AffineMatrix blended{};
+                for (const auto& [index, weight] : weights)
+                    accumulate(boneMatrices[index], weight, blended);
+
+                const AffineMatrix matrix = multiply(blended, transform);
+
+                for (const unsigned short vertex : vertices)
+                {
+                    destination.mPositions[vertex] = transformPosition(matrix, source.mPositions[vertex]);
+
+                    if constexpr (withNormals)
+                        destination.mNormals[vertex] = transformDirection(matrix, source.mNormals[vertex]);
+
+                    if constexpr (withTangents)
+                    {
+                        const osg::Vec4f& tangent = source.mTangents[vertex];
+                        destination.mTangents[vertex] = osg::Vec4f(
+                            transformDirection(matrix, osg::Vec3f(tangent.x(), tangent.y(), tangent.z())), tangent.w());
+                    }
+                }
+            }
+        }
+    }
+
+    SkinInfluences groupSkinInfluences(const std::vector<BoneWeights>& influences)
+    {
+        std::map<BoneWeights, SkinVertexList> influencesToVertices;
+        for (std::size_t i = 0; i < influences.size(); i++)
+            influencesToVertices[influences[i]].emplace_back(static_cast<SkinVertexList::value_type>(i));
+        influencesToVertices.erase(BoneWeights());
+
+        return SkinInfluences(influencesToVertices.begin(), influencesToVertices.end());
+    }
+
+    void skinVertices(const SkinInfluences& influences, std::span<const osg::Matrixf> boneMatrices,
+        const osg::Matrixf& transform, const SkinSource& source, const SkinDestination& destination)
+    {
+        const bool withNormals = source.mNormals != nullptr && destination.mNormals != nullptr;
+        const bool withTangents = source.mTangents != nullptr && destination.mTangents != nullptr;
+
+        if (withNormals && withTangents)
+            skin<true, true>(influences, boneMatrices, transform, source, destination);
+        else if (withNormals)
+            skin<true, false>(influences, boneMatrices, transform, source, destination);
+        else if (withTangents)
+            skin<false, true>(influences, boneMatrices, transform, source, destination);
+        else
+            skin<false, false>(influences, boneMatrices, transform, source, destination);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+#include <osg/Vec4f>
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    using BoneWeight = std::pair<std::size_t, float>;
+    using BoneWeights = std::vector<BoneWeight>;
+    using SkinVertexList = std::vector<unsigned short>;
+
+    // Vertices with the same bone weights share the blended matrix
+    using SkinInfluences = std::vector<std::pair<BoneWeights, SkinVertexList>>;
+
+    // Converts bone weights per vertex into vertices per bone weights, vertices without weights are dropped
+    SkinInfluences groupSkinInfluences(const std::vector<BoneWeights>& influences);
+
+    struct SkinSource
+    {
+        const osg::Vec3f* mPositions = nullptr;
+        const osg::Vec3f* mNormals = nullptr;
+        const osg::Vec4f* mTangents = nullptr;
+    };
+
+    struct SkinDestination
+    {
+        osg::Vec3f* mPositions = nullptr;
+        osg::Vec3f* mNormals = nullptr;
+        osg::Vec4f* mTangents = nullptr;
+    };
+
+    /// Blends bone matrices for each group of vertices, applies the transform and transforms positions, normals and
+    /// tangents. Normals and tangents are transformed only when both source and destination are set.
+    /// @param boneMatrices bone to skin space matrices, have to be zero for missing bones.
+    /// @note All matrices are expected to be affine.
+    void skinVertices(const SkinInfluences& influences, std::span<const osg::Matrixf> boneMatrices,
+        const osg::Matrixf& transform, const SkinSource& source, const SkinDestination& destination);
+}
+
+#endif
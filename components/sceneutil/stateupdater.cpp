@@ -88,6 +88,7 @@ namespace SceneUtil
         stateset->addUniform(new osg::Uniform("windSpeed", 0.0f));
         stateset->addUniform(new osg::Uniform("playerPos", osg::Vec3f(0.f, 0.f, 0.f)));
         stateset->addUniform(new osg::Uniform("useTreeAnim", false));
+        stateset->addUniform(new osg::Uniform("useInstancing", false));
     }
 
     void SharedUniformStateUpdater::apply(osg::StateSet* stateset, osg::NodeVisitor* nv)
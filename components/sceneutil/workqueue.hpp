@@ -66,6 +66,9 @@ namespace SceneUtil
 
         size_t getNumActiveThreads() const;
 
+        /// Not synchronized with start() and stop().
+        size_t getNumThreads() const { return mThreads.size(); }
+
     private:
         bool mIsReleased;
         std::deque<osg::ref_ptr<WorkItem>> mQueue;
@@ -32,6 +32,11 @@ namespace Settings
         SettingValue<bool> mGmstOverridesL10n{ mIndex, "General", "gmst overrides l10n" };
         SettingValue<std::size_t> mLogBufferSize{ mIndex, "General", "log buffer size" };
         SettingValue<std::size_t> mConsoleHistoryBufferSize{ mIndex, "General", "console history buffer size" };
+        SettingValue<bool> mParallelSkinning{ mIndex, "General", "parallel skinning" };
+        SettingValue<bool> mParallelAnimationUpdate{ mIndex, "General", "parallel animation update" };
+        SettingValue<float> mSkinningLodDistance{ mIndex, "General", "skinning lod distance",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<int> mSkinningLodInterval{ mIndex, "General", "skinning lod interval", makeMaxSanitizerInt(1) };
     };
 }
 
@@ -21,6 +21,8 @@ namespace Settings
         SettingValue<int> mAsyncNumThreads{ mIndex, "Physics", "async num threads", makeMaxSanitizerInt(0) };
         SettingValue<int> mLineofsightKeepInactiveCache{ mIndex, "Physics", "lineofsight keep inactive cache",
             makeMaxSanitizerInt(-1) };
+        SettingValue<bool> mEnableBvhDiskCache{ mIndex, "Physics", "enable bvh disk cache" };
+        SettingValue<bool> mSplitStaticBroadphase{ mIndex, "Physics", "split static broadphase" };
     };
 }
 
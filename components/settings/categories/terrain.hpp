@@ -21,9 +21,11 @@ namespace Settings
         SettingValue<bool> mDistantTerrain{ mIndex, "Terrain", "distant terrain" };
         SettingValue<float> mLodFactor{ mIndex, "Terrain", "lod factor", makeMaxStrictSanitizerFloat(0) };
         SettingValue<int> mVertexLodMod{ mIndex, "Terrain", "vertex lod mod" };
+        SettingValue<bool> mCompactVertices{ mIndex, "Terrain", "compact vertices" };
         SettingValue<int> mCompositeMapLevel{ mIndex, "Terrain", "composite map level", makeMaxSanitizerInt(-3) };
         SettingValue<int> mCompositeMapResolution{ mIndex, "Terrain", "composite map resolution",
             makeMaxSanitizerInt(1) };
+        SettingValue<bool> mCompositeMapDiskCache{ mIndex, "Terrain", "composite map disk cache" };
         SettingValue<float> mMaxCompositeGeometrySize{ mIndex, "Terrain", "max composite geometry size",
             makeMaxSanitizerFloat(1) };
         SettingValue<bool> mDebugChunks{ mIndex, "Terrain", "debug chunks" };
@@ -37,6 +39,10 @@ namespace Settings
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mObjectPagingMinSizeCostMultiplier{ mIndex, "Terrain",
             "object paging min size cost multiplier", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<bool> mObjectPagingInstancing{ mIndex, "Terrain", "object paging instancing" };
+        SettingValue<int> mObjectPagingInstancingMinVertices{ mIndex, "Terrain",
+            "object paging instancing min vertices", makeMaxSanitizerInt(0) };
+        SettingValue<bool> mObjectPagingDiskCache{ mIndex, "Terrain", "object paging disk cache" };
         SettingValue<bool> mWaterCulling{ mIndex, "Terrain", "water culling" };
     };
 }
@@ -782,6 +782,7 @@ namespace Shader
             { "distorionRTRatio", "0" },
             { "numViews", "1" },
             { "particle", "0" },
+            { "instancing", "0" },
             { "particlePointLighting", "1" },
         };
     }
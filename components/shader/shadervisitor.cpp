@@ -652,6 +652,10 @@ namespace Shader
         node.getUserValue("particleOcclusion", particleOcclusion);
         defineMap["particleOcclusion"] = particleOcclusion && mWeatherParticleOcclusion ? "1" : "0";
 
+        bool instancing = false;
+        node.getUserValue("instancing", instancing);
+        defineMap["instancing"] = instancing ? "1" : "0";
+
         if (reqs.mAlphaBlend && mSupportsNormalsRT)
         {
             if (reqs.mSoftParticles)
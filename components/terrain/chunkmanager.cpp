@@ -1,24 +1,126 @@
 #include "chunkmanager.hpp"
 
 #include <osg/Material>
+#include <osg/Stats>
 #include <osg/Texture2D>
 
 #include <osgUtil/IncrementalCompileOperation>
 
 #include <components/esm/util.hpp>
+#include <components/misc/cachekey.hpp>
 #include <components/resource/objectcache.hpp>
 #include <components/resource/scenemanager.hpp>
 
 #include <components/sceneutil/lightmanager.hpp>
 
+#include <smhasher/MurmurHash3.h>
+
+#include "compositemapcache.hpp"
 #include "compositemaprenderer.hpp"
 #include "material.hpp"
 #include "storage.hpp"
 #include "terraindrawable.hpp"
 #include "texturemanager.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
 namespace Terrain
 {
+    namespace
+    {
+        struct CompactVertices
+        {
+            osg::ref_ptr<osg::Vec3sArray> mPositions;
+            osg::ref_ptr<osg::Vec3bArray> mNormals;
+            osg::Matrix mDecodeMatrix;
+        };
+
+        // Positions are stored as grid indices and heights in whole units relative to the lowest point of the chunk,
+        // which is exact for ESM3 land and keeps vertices shared by neighbouring chunks identical.
+        std::optional<CompactVertices> makeCompactVertices(
+            const osg::Vec3Array& positions, const osg::Vec3Array& normals, float gridStep)
+        {
+            if (positions.empty() || gridStep <= 0)
+                return std::nullopt;
+
+            osg::BoundingBox bounds;
+            for (const osg::Vec3f& position : positions)
+                bounds.expandBy(position);
+
+            constexpr float minValue = std::numeric_limits<std::int16_t>::min();
+            constexpr float maxValue = std::numeric_limits<std::int16_t>::max();
+            const float heightOffset = std::floor(bounds.zMin()) - minValue;
+            if (bounds.zMax() - heightOffset > maxValue || (bounds.xMax() - bounds.xMin()) / gridStep > maxValue
+                || (bounds.yMax() - bounds.yMin()) / gridStep > maxValue)
+                return std::nullopt;
+
+            CompactVertices result;
+            result.mPositions = new osg::Vec3sArray(positions.size());
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                const osg::Vec3f& position = positions[i];
+                (*result.mPositions)[i]
+                    = osg::Vec3s(static_cast<short>(std::lround((position.x() - bounds.xMin()) / gridStep)),
+                        static_cast<short>(std::lround((position.y() - bounds.yMin()) / gridStep)),
+                        static_cast<short>(std::lround(position.z() - heightOffset)));
+            }
+
+            const auto toByte = [](float value) {
+                return static_cast<signed char>(std::lround(std::clamp(value, -1.f, 1.f) * 127));
+            };
+            result.mNormals = new osg::Vec3bArray(normals.size());
+            result.mNormals->setNormalize(true);
+            for (std::size_t i = 0; i < normals.size(); ++i)
+            {
+                const osg::Vec3f& normal = normals[i];
+                (*result.mNormals)[i] = osg::Vec3b(toByte(normal.x()), toByte(normal.y()), toByte(normal.z()));
+            }
+
+            result.mDecodeMatrix = osg::Matrix::scale(gridStep, gridStep, 1)
+                * osg::Matrix::translate(bounds.xMin(), bounds.yMin(), heightOffset);
+            return result;
+        }
+
+        // Composite maps depend on land only through blendmaps, so their contents are hashed instead of land records
+        void appendPassesToKey(const std::vector<LayerInfo>& layers,
+            const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, int tileCount, std::string& key)
+        {
+            Misc::appendToKey(key, tileCount);
+            Misc::appendToKey(key, static_cast<std::uint64_t>(layers.size()));
+            for (const LayerInfo& layer : layers)
+                Misc::appendStringToKey(key, layer.mDiffuseMap.value());
+            for (const osg::ref_ptr<osg::Image>& blendmap : blendmaps)
+            {
+                std::array<std::uint64_t, 2> hash{ 0, 0 };
+                MurmurHash3_x64_128(
+                    blendmap->data(), static_cast<int>(blendmap->getTotalSizeInBytes()), 0, hash.data());
+                Misc::appendToKey(key, blendmap->s());
+                Misc::appendToKey(key, blendmap->t());
+                Misc::appendToKey(key, hash[0]);
+                Misc::appendToKey(key, hash[1]);
+            }
+        }
+
+        void setVertexArrays(osg::Array* positions, osg::Array* normals, osg::Array* colors, TerrainDrawable& geometry)
+        {
+            osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
+            positions->setVertexBufferObject(vbo);
+            normals->setVertexBufferObject(vbo);
+            colors->setVertexBufferObject(vbo);
+
+            geometry.setVertexArray(positions);
+            geometry.setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+            geometry.setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+        }
+    }
 
     struct UpdateTextureFilteringFunctor
     {
@@ -49,6 +151,7 @@ namespace Terrain
         , mCompositeMapSize(512)
         , mCompositeMapLevel(1.f)
         , mMaxCompGeometrySize(1.f)
+        , mCompactVertices(false)
     {
         mMultiPassRoot = new osg::StateSet;
         mMultiPassRoot->setRenderingHint(osg::StateSet::OPAQUE_BIN);
@@ -88,6 +191,15 @@ namespace Terrain
     void ChunkManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Terrain Chunk", frameNumber, mCache->getStats(), *stats);
+
+        std::size_t memory = 0;
+        mCache->call([&](const ChunkKey& /*key*/, osg::Object* obj) {
+            const TerrainDrawable& geometry = static_cast<const TerrainDrawable&>(*obj);
+            for (const osg::Array* array :
+                { geometry.getVertexArray(), geometry.getNormalArray(), geometry.getColorArray() })
+                memory += array->getTotalDataSize();
+        });
+        stats->setAttribute(frameNumber, "Terrain Chunk Memory", static_cast<double>(memory));
     }
 
     void ChunkManager::clearCache()
@@ -116,56 +228,83 @@ namespace Terrain
         return texture;
     }
 
-    void ChunkManager::createCompositeMapGeometry(
-        float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& compositeMap)
+    struct ChunkManager::Blendmaps
+    {
+        std::vector<LayerInfo> mLayers;
+        std::vector<osg::ref_ptr<osg::Image>> mImages;
+        int mTileCount = 0;
+    };
+
+    struct ChunkManager::CompositeMapPart
+    {
+        osg::Vec4f mTexCoords;
+        Blendmaps mBlendmaps;
+    };
+
+    ChunkManager::Blendmaps ChunkManager::getBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter)
+    {
+        Blendmaps result;
+        mStorage->getBlendmaps(chunkSize, chunkCenter, result.mImages, result.mLayers, mWorldspace);
+        result.mTileCount = mStorage->getTextureTileCount(chunkSize, mWorldspace);
+        return result;
+    }
+
+    void ChunkManager::getCompositeMapParts(float chunkSize, const osg::Vec2f& chunkCenter,
+        const osg::Vec4f& texCoords, std::vector<CompositeMapPart>& parts)
     {
         if (chunkSize > mMaxCompGeometrySize)
         {
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, chunkSize / 4.f),
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, chunkSize / 4.f),
                 osg::Vec4f(
                     texCoords.x() + texCoords.z() / 2.f, texCoords.y(), texCoords.z() / 2.f, texCoords.w() / 2.f),
-                compositeMap);
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, chunkSize / 4.f),
-                osg::Vec4f(texCoords.x(), texCoords.y(), texCoords.z() / 2.f, texCoords.w() / 2.f), compositeMap);
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, -chunkSize / 4.f),
+                parts);
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, chunkSize / 4.f),
+                osg::Vec4f(texCoords.x(), texCoords.y(), texCoords.z() / 2.f, texCoords.w() / 2.f), parts);
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(chunkSize / 4.f, -chunkSize / 4.f),
                 osg::Vec4f(texCoords.x() + texCoords.z() / 2.f, texCoords.y() + texCoords.w() / 2.f,
                     texCoords.z() / 2.f, texCoords.w() / 2.f),
-                compositeMap);
-            createCompositeMapGeometry(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, -chunkSize / 4.f),
+                parts);
+            getCompositeMapParts(chunkSize / 2.f, chunkCenter + osg::Vec2f(-chunkSize / 4.f, -chunkSize / 4.f),
                 osg::Vec4f(
                     texCoords.x(), texCoords.y() + texCoords.w() / 2.f, texCoords.z() / 2.f, texCoords.w() / 2.f),
-                compositeMap);
+                parts);
         }
         else
         {
-            float left = texCoords.x() * 2.f - 1;
-            float top = texCoords.y() * 2.f - 1;
-            float width = texCoords.z() * 2.f;
-            float height = texCoords.w() * 2.f;
+            parts.push_back(
+                CompositeMapPart{ .mTexCoords = texCoords, .mBlendmaps = getBlendmaps(chunkSize, chunkCenter) });
+        }
+    }
 
-            std::vector<osg::ref_ptr<osg::StateSet>> passes = createPasses(chunkSize, chunkCenter, true);
-            for (std::vector<osg::ref_ptr<osg::StateSet>>::iterator it = passes.begin(); it != passes.end(); ++it)
-            {
-                osg::ref_ptr<osg::Geometry> geom = osg::createTexturedQuadGeometry(
-                    osg::Vec3(left, top, 0), osg::Vec3(width, 0, 0), osg::Vec3(0, height, 0));
-                geom->setUseDisplayList(
-                    false); // don't bother making a display list for an object that is just rendered once.
-                geom->setUseVertexBufferObjects(false);
-                geom->setTexCoordArray(1, geom->getTexCoordArray(0), osg::Array::BIND_PER_VERTEX);
+    void ChunkManager::createCompositeMapGeometry(const CompositeMapPart& part, CompositeMap& compositeMap)
+    {
+        const osg::Vec4f& texCoords = part.mTexCoords;
+        float left = texCoords.x() * 2.f - 1;
+        float top = texCoords.y() * 2.f - 1;
+        float width = texCoords.z() * 2.f;
+        float height = texCoords.w() * 2.f;
+
+        std::vector<osg::ref_ptr<osg::StateSet>> passes = createPasses(part.mBlendmaps, true);
+        for (std::vector<osg::ref_ptr<osg::StateSet>>::iterator it = passes.begin(); it != passes.end(); ++it)
+        {
+            osg::ref_ptr<osg::Geometry> geom = osg::createTexturedQuadGeometry(
+                osg::Vec3(left, top, 0), osg::Vec3(width, 0, 0), osg::Vec3(0, height, 0));
+            geom->setUseDisplayList(
+                false); // don't bother making a display list for an object that is just rendered once.
+            geom->setUseVertexBufferObjects(false);
+            geom->setTexCoordArray(1, geom->getTexCoordArray(0), osg::Array::BIND_PER_VERTEX);
 
-                geom->setStateSet(*it);
+            geom->setStateSet(*it);
 
-                compositeMap.mDrawables.emplace_back(geom);
-            }
+            compositeMap.mDrawables.emplace_back(geom);
         }
     }
 
-    std::vector<osg::ref_ptr<osg::StateSet>> ChunkManager::createPasses(
-        float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap)
+    std::vector<osg::ref_ptr<osg::StateSet>> ChunkManager::createPasses(const Blendmaps& input, bool forCompositeMap)
     {
-        std::vector<LayerInfo> layerList;
-        std::vector<osg::ref_ptr<osg::Image>> blendmaps;
-        mStorage->getBlendmaps(chunkSize, chunkCenter, blendmaps, layerList, mWorldspace);
+        const std::vector<LayerInfo>& layerList = input.mLayers;
+        const std::vector<osg::ref_ptr<osg::Image>>& blendmaps = input.mImages;
+        const int tileCount = input.mTileCount;
 
         std::vector<TextureLayer> layers;
         {
@@ -195,8 +334,6 @@ namespace Terrain
             blendmapTextures.push_back(texture);
         }
 
-        int tileCount = mStorage->getTextureTileCount(chunkSize, mWorldspace);
-
         return ::Terrain::createPasses(mSceneManager, layers, blendmapTextures, tileCount,
             static_cast<float>(tileCount), forCompositeMap, ESM::isEsm4Ext(mWorldspace));
     }
@@ -206,23 +343,40 @@ namespace Terrain
     {
         osg::ref_ptr<TerrainDrawable> geometry(new TerrainDrawable);
 
+        unsigned int numVerts
+            = static_cast<unsigned>((mStorage->getCellVertices(mWorldspace) - 1) * chunkSize / (1 << lod) + 1);
+
         if (!templateGeometry)
         {
-            osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
-            osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
             osg::ref_ptr<osg::Vec4ubArray> colors(new osg::Vec4ubArray);
             colors->setNormalize(true);
 
-            mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, mWorldspace, *positions, *normals, *colors);
+            if (mCompactVertices)
+            {
+                // Full precision arrays are only needed for encoding, so they are reused by all chunks a thread builds.
+                thread_local const osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+                thread_local const osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+
+                mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, mWorldspace, *positions, *normals, *colors);
+
+                const float gridStep = chunkSize * mStorage->getCellWorldSize(mWorldspace) / (numVerts - 1);
+                if (std::optional<CompactVertices> compact = makeCompactVertices(*positions, *normals, gridStep))
+                {
+                    setVertexArrays(compact->mPositions, compact->mNormals, colors, *geometry);
+                    geometry->setVertexDecodeMatrix(compact->mDecodeMatrix);
+                }
+                else
+                    setVertexArrays(new osg::Vec3Array(*positions), new osg::Vec3Array(*normals), colors, *geometry);
+            }
+            else
+            {
+                osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+                osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
 
-            osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
-            positions->setVertexBufferObject(vbo);
-            normals->setVertexBufferObject(vbo);
-            colors->setVertexBufferObject(vbo);
+                mStorage->fillVertexBuffers(lod, chunkSize, chunkCenter, mWorldspace, *positions, *normals, *colors);
 
-            geometry->setVertexArray(positions);
-            geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
-            geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+                setVertexArrays(positions, normals, colors, *geometry);
+            }
         }
         else
         {
@@ -234,14 +388,8 @@ namespace Terrain
             osg::ref_ptr<osg::Array> colors
                 = static_cast<osg::Array*>(templateGeometry->getColorArray()->clone(osg::CopyOp::DEEP_COPY_ALL));
 
-            osg::ref_ptr<osg::VertexBufferObject> vbo(new osg::VertexBufferObject);
-            positions->setVertexBufferObject(vbo);
-            normals->setVertexBufferObject(vbo);
-            colors->setVertexBufferObject(vbo);
-
-            geometry->setVertexArray(positions);
-            geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
-            geometry->setColorArray(colors, osg::Array::BIND_PER_VERTEX);
+            setVertexArrays(positions, normals, colors, *geometry);
+            geometry->setVertexDecodeMatrix(templateGeometry->getVertexDecodeMatrix());
         }
 
         geometry->setUseDisplayList(false);
@@ -250,9 +398,6 @@ namespace Terrain
         if (chunkSize <= 1.f)
             geometry->setLightListCallback(new SceneUtil::LightListCallback);
 
-        unsigned int numVerts
-            = static_cast<unsigned>((mStorage->getCellVertices(mWorldspace) - 1) * chunkSize / (1 << lod) + 1);
-
         geometry->addPrimitiveSet(mBufferCache.getIndexBuffer(numVerts, lodFlags));
 
         bool useCompositeMap = chunkSize >= mCompositeMapLevel;
@@ -280,12 +425,42 @@ namespace Terrain
                 osg::ref_ptr<CompositeMap> compositeMap = new CompositeMap;
                 compositeMap->mTexture = createCompositeMapRTT();
 
-                createCompositeMapGeometry(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), *compositeMap);
-
-                mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
-
-                geometry->setCompositeMap(compositeMap);
-                geometry->setCompositeMapRenderer(mCompositeMapRenderer);
+                std::vector<CompositeMapPart> parts;
+                getCompositeMapParts(chunkSize, chunkCenter, osg::Vec4f(0, 0, 1, 1), parts);
+
+                osg::ref_ptr<osg::Image> image;
+                if (mCompositeMapCache)
+                {
+                    std::string& key = compositeMap->mCacheKey;
+                    Misc::appendStringToKey(key, mWorldspace.serializeText());
+                    Misc::appendToKey(key, chunkCenter);
+                    Misc::appendToKey(key, chunkSize);
+                    Misc::appendToKey(key, mCompositeMapSize);
+                    Misc::appendToKey(key, mMaxCompGeometrySize);
+                    for (const CompositeMapPart& part : parts)
+                        appendPassesToKey(part.mBlendmaps.mLayers, part.mBlendmaps.mImages,
+                            part.mBlendmaps.mTileCount, key);
+                    image = mCompositeMapCache->load(key);
+                }
+
+                if (image)
+                {
+                    // Loaded composite map is complete, so the renderer doesn't need to know about it
+                    compositeMap->mTexture->setImage(image);
+                    compositeMap->mTexture->setUnRefImageDataAfterApply(true);
+                    compositeMap->mCacheKey.clear();
+                    geometry->setCompositeMap(compositeMap);
+                }
+                else
+                {
+                    for (const CompositeMapPart& part : parts)
+                        createCompositeMapGeometry(part, *compositeMap);
+
+                    mCompositeMapRenderer->addCompositeMap(compositeMap.get(), false);
+
+                    geometry->setCompositeMap(compositeMap);
+                    geometry->setCompositeMapRenderer(mCompositeMapRenderer);
+                }
 
                 TextureLayer layer;
                 layer.mDiffuseMap = compositeMap->mTexture;
@@ -296,7 +471,7 @@ namespace Terrain
             }
             else
             {
-                geometry->setPasses(createPasses(chunkSize, chunkCenter, false));
+                geometry->setPasses(createPasses(getBlendmaps(chunkSize, chunkCenter), false));
             }
         }
 
@@ -1,7 +1,10 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 #define OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 
+#include <memory>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include <components/resource/resourcemanager.hpp>
 
@@ -23,6 +26,7 @@ namespace Terrain
 {
 
     class TextureManager;
+    class CompositeMapCache;
     class CompositeMapRenderer;
     class Storage;
     class CompositeMap;
@@ -84,6 +88,13 @@ namespace Terrain
         void setCompositeMapSize(unsigned int size) { mCompositeMapSize = size; }
         void setCompositeMapLevel(float level) { mCompositeMapLevel = level; }
         void setMaxCompositeGeometrySize(float maxCompGeometrySize) { mMaxCompGeometrySize = maxCompGeometrySize; }
+        /// Store positions and normals of new chunks as 16 and 8 bit integers.
+        void setCompactVertices(bool compact) { mCompactVertices = compact; }
+        /// Composite maps of new chunks are loaded from the cache when possible.
+        void setCompositeMapCache(std::shared_ptr<const CompositeMapCache> cache)
+        {
+            mCompositeMapCache = std::move(cache);
+        }
 
         void updateTextureFiltering();
 
@@ -102,11 +113,18 @@ namespace Terrain
 
         osg::ref_ptr<osg::Texture2D> createCompositeMapRTT();
 
-        void createCompositeMapGeometry(
-            float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords, CompositeMap& map);
+        struct Blendmaps;
+        struct CompositeMapPart;
 
-        std::vector<osg::ref_ptr<osg::StateSet>> createPasses(
-            float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap);
+        Blendmaps getBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter);
+
+        /// Collects blendmaps of each part of the composite map drawn by a separate geometry.
+        void getCompositeMapParts(float chunkSize, const osg::Vec2f& chunkCenter, const osg::Vec4f& texCoords,
+            std::vector<CompositeMapPart>& parts);
+
+        void createCompositeMapGeometry(const CompositeMapPart& part, CompositeMap& map);
+
+        std::vector<osg::ref_ptr<osg::StateSet>> createPasses(const Blendmaps& input, bool forCompositeMap);
 
         Terrain::Storage* mStorage;
         Resource::SceneManager* mSceneManager;
@@ -121,6 +139,8 @@ namespace Terrain
         unsigned int mCompositeMapSize;
         float mCompositeMapLevel;
         float mMaxCompGeometrySize;
+        bool mCompactVertices;
+        std::shared_ptr<const CompositeMapCache> mCompositeMapCache;
     };
 
 }
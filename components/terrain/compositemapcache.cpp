@@ -0,0 +1,280 @@
+#include "compositemapcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/atomicfile.hpp>
+#include <components/files/conversion.hpp>
+#include <components/misc/strings/conversion.hpp>
+
+#include <osg/Image>
+#include <osg/Texture>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <smhasher/MurmurHash3.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace Terrain
+{
+    namespace
+    {
+        // Increment when the way composite maps are encoded is changed
+        constexpr std::uint32_t formatVersion = 1;
+
+        using Color = std::array<int, 3>;
+
+        std::uint16_t toRgb565(const Color& color)
+        {
+            return static_cast<std::uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+        }
+
+        Color fromRgb565(std::uint16_t value)
+        {
+            const int r = (value >> 11) & 0x1f;
+            const int g = (value >> 5) & 0x3f;
+            const int b = value & 0x1f;
+            return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+        }
+
+        Color interpolate(const Color& first, const Color& second)
+        {
+            Color result;
+            for (std::size_t c = 0; c < 3; ++c)
+                result[c] = (2 * first[c] + second[c]) / 3;
+            return result;
+        }
+
+        int getDistance(const Color& first, const Color& second)
+        {
+            int result = 0;
+            for (std::size_t c = 0; c < 3; ++c)
+                result += (first[c] - second[c]) * (first[c] - second[c]);
+            return result;
+        }
+
+        void writeLittleEndian(std::uint32_t value, std::size_t size, std::vector<unsigned char>& out)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+
+        // Uses the bounding box of block colors as endpoints which is fast and good enough for blurry terrain textures
+        void compressBlock(const std::array<Color, 16>& pixels, std::vector<unsigned char>& out)
+        {
+            Color min{ 255, 255, 255 };
+            Color max{ 0, 0, 0 };
+            for (const Color& pixel : pixels)
+            {
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    min[c] = std::min(min[c], pixel[c]);
+                    max[c] = std::max(max[c], pixel[c]);
+                }
+            }
+
+            // Pick the bounding box diagonal following colors correlation relative to green
+            int covarianceRG = 0;
+            int covarianceBG = 0;
+            for (const Color& pixel : pixels)
+            {
+                const int g = pixel[1] - (min[1] + max[1]) / 2;
+                covarianceRG += (pixel[0] - (min[0] + max[0]) / 2) * g;
+                covarianceBG += (pixel[2] - (min[2] + max[2]) / 2) * g;
+            }
+            if (covarianceRG < 0)
+                std::swap(min[0], max[0]);
+            if (covarianceBG < 0)
+                std::swap(min[2], max[2]);
+
+            // Move endpoints a bit inside to reduce the error for colors in between
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                const int inset = (max[c] - min[c]) / 16;
+                min[c] += inset;
+                max[c] -= inset;
+            }
+
+            std::uint16_t color0 = toRgb565(max);
+            std::uint16_t color1 = toRgb565(min);
+            // 4 color mode requires the first endpoint to be greater
+            if (color0 < color1)
+                std::swap(color0, color1);
+
+            std::uint32_t indices = 0;
+            if (color0 != color1)
+            {
+                const Color endpoint0 = fromRgb565(color0);
+                const Color endpoint1 = fromRgb565(color1);
+                const std::array<Color, 4> palette{ endpoint0, endpoint1, interpolate(endpoint0, endpoint1),
+                    interpolate(endpoint1, endpoint0) };
+                for (std::size_t i = 0; i < pixels.size(); ++i)
+                {
+                    std::uint32_t best = 0;
+                    for (std::uint32_t j = 1; j < palette.size(); ++j)
+                        if (getDistance(pixels[i], palette[j]) < getDistance(pixels[i], palette[best]))
+                            best = j;
+                    indices |= best << (2 * i);
+                }
+            }
+
+            writeLittleEndian(color0, 2, out);
+            writeLittleEndian(color1, 2, out);
+            writeLittleEndian(indices, 4, out);
+        }
+
+        void compressLevel(
+            const std::vector<unsigned char>& rgb, int width, int height, std::vector<unsigned char>& out)
+        {
+            for (int blockY = 0; blockY < height; blockY += 4)
+            {
+                for (int blockX = 0; blockX < width; blockX += 4)
+                {
+                    std::array<Color, 16> pixels;
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        for (int x = 0; x < 4; ++x)
+                        {
+                            // Blocks of levels smaller than 4x4 repeat edge pixels
+                            const int pixelX = std::min(blockX + x, width - 1);
+                            const int pixelY = std::min(blockY + y, height - 1);
+                            const unsigned char* pixel = &rgb[(pixelY * width + pixelX) * 3];
+                            pixels[y * 4 + x] = Color{ pixel[0], pixel[1], pixel[2] };
+                        }
+                    }
+                    compressBlock(pixels, out);
+                }
+            }
+        }
+
+        std::vector<unsigned char> downsample(const std::vector<unsigned char>& rgb, int width, int height)
+        {
+            const int newWidth = std::max(1, width / 2);
+            const int newHeight = std::max(1, height / 2);
+            std::vector<unsigned char> result(static_cast<std::size_t>(newWidth * newHeight * 3));
+            for (int y = 0; y < newHeight; ++y)
+            {
+                const int y0 = std::min(2 * y, height - 1);
+                const int y1 = std::min(2 * y + 1, height - 1);
+                for (int x = 0; x < newWidth; ++x)
+                {
+                    const int x0 = std::min(2 * x, width - 1);
+                    const int x1 = std::min(2 * x + 1, width - 1);
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const int sum = rgb[(y0 * width + x0) * 3 + c] + rgb[(y0 * width + x1) * 3 + c]
+                            + rgb[(y1 * width + x0) * 3 + c] + rgb[(y1 * width + x1) * 3 + c];
+                        result[(y * newWidth + x) * 3 + c] = static_cast<unsigned char>((sum + 2) / 4);
+                    }
+                }
+            }
+            return result;
+        }
+    }
+
+    osg::ref_ptr<osg::Image> compressDxt1(const osg::Image& image)
+    {
+        int width = image.s();
+        int height = image.t();
+
+        std::vector<unsigned char> level(static_cast<std::size_t>(width * height * 3));
+        for (int y = 0; y < height; ++y)
+            std::memcpy(&level[static_cast<std::size_t>(y * width * 3)], image.data(0, y),
+                static_cast<std::size_t>(width * 3));
+
+        std::vector<unsigned char> data;
+        osg::Image::MipmapDataType mipmapOffsets;
+        while (true)
+        {
+            compressLevel(level, width, height, data);
+            if (width == 1 && height == 1)
+                break;
+            level = downsample(level, width, height);
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+            mipmapOffsets.push_back(static_cast<unsigned int>(data.size()));
+        }
+
+        unsigned char* buffer = new unsigned char[data.size()];
+        std::memcpy(buffer, data.data(), data.size());
+
+        osg::ref_ptr<osg::Image> result = new osg::Image;
+        result->setImage(image.s(), image.t(), 1, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+            GL_UNSIGNED_BYTE, buffer, osg::Image::USE_NEW_DELETE);
+        result->setMipmapLevels(mipmapOffsets);
+        return result;
+    }
+
+    CompositeMapCache::CompositeMapCache(const std::filesystem::path& path)
+        : mPath(path)
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("dds"))
+    {
+        if (mReaderWriter == nullptr)
+            Log(Debug::Warning) << "Composite map cache is disabled: no 'dds' readerwriter found";
+
+        std::error_code ec;
+        std::filesystem::create_directories(mPath, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to create composite map cache directory "
+                                << Files::pathToUnicodeString(mPath) << ": " << ec.message();
+    }
+
+    osg::ref_ptr<osg::Image> CompositeMapCache::load(std::string_view key) const
+    {
+        if (mReaderWriter == nullptr)
+            return nullptr;
+
+        const std::filesystem::path filePath = getFilePath(key);
+        std::ifstream stream(filePath, std::ios::binary);
+        if (!stream)
+            return nullptr;
+
+        osgDB::ReaderWriter::ReadResult result = mReaderWriter->readImage(stream);
+        if (!result.success() || result.getImage() == nullptr || !result.getImage()->isCompressed())
+        {
+            Log(Debug::Warning) << "Ignoring invalid composite map cache file " << Files::pathToUnicodeString(filePath);
+            return nullptr;
+        }
+
+        return result.getImage();
+    }
+
+    bool CompositeMapCache::store(std::string_view key, const osg::Image& image) const
+    {
+        if (mReaderWriter == nullptr || image.getPixelFormat() != GL_RGB || image.getDataType() != GL_UNSIGNED_BYTE)
+            return false;
+
+        const osg::ref_ptr<osg::Image> compressed = compressDxt1(image);
+
+        // Rows are stored in OpenGL order, so they are uploaded the same way after loading
+        const osg::ref_ptr<osgDB::Options> options = new osgDB::Options("ddsNoAutoFlipWrite");
+
+        return Files::writeFileAtomically(getFilePath(key), [&](std::ostream& stream) {
+            const osgDB::ReaderWriter::WriteResult result = mReaderWriter->writeImage(*compressed, stream, options);
+            if (!result.success())
+            {
+                Log(Debug::Warning) << "Failed to write composite map cache image: " << result.message();
+                return false;
+            }
+            return static_cast<bool>(stream);
+        });
+    }
+
+    std::filesystem::path CompositeMapCache::getFilePath(std::string_view key) const
+    {
+        std::string data(reinterpret_cast<const char*>(&formatVersion), sizeof(formatVersion));
+        data += key;
+        std::array<std::uint64_t, 2> hash{ 0, 0 };
+        MurmurHash3_x64_128(data.data(), static_cast<int>(data.size()), 0, hash.data());
+        std::string name
+            = Misc::StringUtils::toHex(std::string_view(reinterpret_cast<const char*>(hash.data()), sizeof(hash)));
+        name += ".dds";
+        return mPath / name;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+#define OPENMW_COMPONENTS_TERRAIN_COMPOSITEMAPCACHE_H
+
+#include <osg/ref_ptr>
+
+#include <filesystem>
+#include <string_view>
+
+namespace osg
+{
+    class Image;
+}
+
+namespace osgDB
+{
+    class ReaderWriter;
+}
+
+namespace Terrain
+{
+    /// Stores rendered composite maps on disk as DXT1 compressed DDS files, so they don't have to be rendered again.
+    /// @note May be used from any thread.
+    class CompositeMapCache
+    {
+    public:
+        explicit CompositeMapCache(const std::filesystem::path& path);
+
+        /// Key has to identify everything the composite map is rendered from.
+        /// @return nullptr when there is no valid file for the key.
+        osg::ref_ptr<osg::Image> load(std::string_view key) const;
+
+        /// Image has to be GL_RGB with 8 bits per channel. It's compressed before being written.
+        bool store(std::string_view key, const osg::Image& image) const;
+
+    private:
+        std::filesystem::path mPath;
+        osgDB::ReaderWriter* mReaderWriter;
+
+        std::filesystem::path getFilePath(std::string_view key) const;
+    };
+
+    /// Compresses GL_RGB image with 8 bits per channel into DXT1 with a full mipmap chain.
+    osg::ref_ptr<osg::Image> compressDxt1(const osg::Image& image);
+}
+
+#endif
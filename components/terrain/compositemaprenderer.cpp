@@ -1,13 +1,41 @@
 #include "compositemaprenderer.hpp"
 
+#include <osg/BufferObject>
 #include <osg/FrameBufferObject>
+#include <osg/Image>
 #include <osg/RenderInfo>
 #include <osg/Texture2D>
 
+#include <components/sceneutil/workqueue.hpp>
+
+#include "compositemapcache.hpp"
+
 #include <algorithm>
+#include <cstring>
 
 namespace Terrain
 {
+    namespace
+    {
+        class StoreCompositeMapWorkItem : public SceneUtil::WorkItem
+        {
+        public:
+            StoreCompositeMapWorkItem(
+                std::shared_ptr<const CompositeMapCache> cache, std::string key, osg::ref_ptr<osg::Image> image)
+                : mCache(std::move(cache))
+                , mKey(std::move(key))
+                , mImage(std::move(image))
+            {
+            }
+
+            void doWork() override { mCache->store(mKey, *mImage); }
+
+        private:
+            std::shared_ptr<const CompositeMapCache> mCache;
+            std::string mKey;
+            osg::ref_ptr<osg::Image> mImage;
+        };
+    }
 
     CompositeMapRenderer::CompositeMapRenderer()
         : mTargetFrameRate(120)
@@ -26,6 +54,10 @@ namespace Terrain
         double dt = mTimer.time_s();
         dt = std::min(dt, 0.2);
         mTimer.setStartTick();
+
+        // Started at least a frame ago, so the copies are most likely done and mapping doesn't wait for the GPU
+        finishReadBacks(*renderInfo.getState());
+
         double targetFrameTime = 1.0 / static_cast<double>(mTargetFrameRate);
         double conservativeTimeRatio(0.75);
         double availableTime = std::max((targetFrameTime - dt) * conservativeTimeRatio, mMinimumTimeAvailable);
@@ -123,14 +155,70 @@ namespace Terrain
             compositeMap.mDrawables[i] = nullptr;
         }
         if (compositeMap.mCompiled == compositeMap.mDrawables.size())
+        {
             compositeMap.mDrawables = std::vector<osg::ref_ptr<osg::Drawable>>();
 
+            if (!compositeMap.mCacheKey.empty() && mCompositeMapCache && mWorkQueue)
+                startReadBack(compositeMap, state);
+        }
+
         state.haveAppliedAttribute(osg::StateAttribute::VIEWPORT);
 
         GLuint fboId = state.getGraphicsContext() ? state.getGraphicsContext()->getDefaultFboId() : 0;
         ext->glBindFramebuffer(GL_FRAMEBUFFER_EXT, fboId);
     }
 
+    void CompositeMapRenderer::startReadBack(CompositeMap& compositeMap, osg::State& state) const
+    {
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        if (!ext->isPBOSupported)
+            return;
+
+        const int width = compositeMap.mTexture->getTextureWidth();
+        const int height = compositeMap.mTexture->getTextureHeight();
+
+        GLuint buffer = 0;
+        ext->glGenBuffers(1, &buffer);
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, buffer);
+        ext->glBufferData(GL_PIXEL_PACK_BUFFER_ARB, static_cast<GLsizeiptr>(width) * height * 3, nullptr,
+            GL_STREAM_READ_ARB);
+
+        // With a pixel pack buffer bound the copy is only queued, so the draw thread doesn't wait for it
+        mFBO->apply(state, osg::FrameBufferObject::READ_FRAMEBUFFER);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+        mPendingReadBacks.push_back(PendingReadBack{
+            .mBuffer = buffer, .mWidth = width, .mHeight = height, .mCacheKey = std::move(compositeMap.mCacheKey) });
+        compositeMap.mCacheKey.clear();
+    }
+
+    void CompositeMapRenderer::finishReadBacks(osg::State& state) const
+    {
+        if (mPendingReadBacks.empty())
+            return;
+
+        osg::GLExtensions* ext = state.get<osg::GLExtensions>();
+        for (PendingReadBack& readBack : mPendingReadBacks)
+        {
+            ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, readBack.mBuffer);
+            if (const void* data = ext->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB))
+            {
+                // Compression and writing happen in the background
+                osg::ref_ptr<osg::Image> image = new osg::Image;
+                image->allocateImage(readBack.mWidth, readBack.mHeight, 1, GL_RGB, GL_UNSIGNED_BYTE, 1);
+                std::memcpy(image->data(), data, image->getTotalSizeInBytes());
+                ext->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+                mWorkQueue->addWorkItem(new StoreCompositeMapWorkItem(
+                    mCompositeMapCache, std::move(readBack.mCacheKey), std::move(image)));
+            }
+            ext->glDeleteBuffers(1, &readBack.mBuffer);
+        }
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+        mPendingReadBacks.clear();
+    }
+
     void CompositeMapRenderer::setMinimumTimeAvailableForCompile(double time)
     {
         mMinimumTimeAvailable = time;
@@ -163,6 +251,13 @@ namespace Terrain
         }
     }
 
+    void CompositeMapRenderer::setCompositeMapCache(
+        std::shared_ptr<const CompositeMapCache> cache, SceneUtil::WorkQueue* workQueue)
+    {
+        mCompositeMapCache = std::move(cache);
+        mWorkQueue = workQueue;
+    }
+
     size_t CompositeMapRenderer::getCompileSetSize() const
     {
         std::lock_guard<std::mutex> lock(mMutex);
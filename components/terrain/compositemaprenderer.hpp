@@ -3,18 +3,28 @@
 
 #include <osg/Drawable>
 
+#include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace osg
 {
     class FrameBufferObject;
     class RenderInfo;
+    class State;
     class Texture2D;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
+    class CompositeMapCache;
 
     class CompositeMap : public osg::Referenced
     {
@@ -24,6 +34,8 @@ namespace Terrain
         std::vector<osg::ref_ptr<osg::Drawable>> mDrawables;
         osg::ref_ptr<osg::Texture2D> mTexture;
         size_t mCompiled;
+        /// Composite maps with a key are stored in the CompositeMapCache once they are fully rendered.
+        std::string mCacheKey;
     };
 
     /**
@@ -54,7 +66,24 @@ namespace Terrain
 
         size_t getCompileSetSize() const;
 
+        /// Fully rendered composite maps with a cache key are read back and stored using the work queue.
+        void setCompositeMapCache(std::shared_ptr<const CompositeMapCache> cache, SceneUtil::WorkQueue* workQueue);
+
     private:
+        struct PendingReadBack
+        {
+            GLuint mBuffer;
+            int mWidth;
+            int mHeight;
+            std::string mCacheKey;
+        };
+
+        /// Queue copying of a fully rendered composite map into a pixel buffer object.
+        void startReadBack(CompositeMap& compositeMap, osg::State& state) const;
+
+        /// Pass pixels of read backs started by previous frames to the cache.
+        void finishReadBacks(osg::State& state) const;
+
         float mTargetFrameRate;
         double mMinimumTimeAvailable;
         mutable osg::Timer mTimer;
@@ -67,6 +96,10 @@ namespace Terrain
         mutable std::mutex mMutex;
 
         osg::ref_ptr<osg::FrameBufferObject> mFBO;
+
+        std::shared_ptr<const CompositeMapCache> mCompositeMapCache;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        mutable std::vector<PendingReadBack> mPendingReadBacks;
     };
 
 }
@@ -5,14 +5,20 @@
 #include <osg/ShapeDrawable>
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
 #include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include <components/esm/util.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
 #include <components/misc/mathutil.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/paralleljobs.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "chunkmanager.hpp"
 #include "compositemaprenderer.hpp"
@@ -403,6 +409,7 @@ namespace Terrain
                     pat->addChild(n);
             }
             entry.mRenderingNode = pat;
+            mChunksBuilt.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
@@ -468,6 +475,13 @@ namespace Terrain
             callback->setLowZ(lowZ);
             cv->popCurrentMask();
         }
+
+        // Chunks are small relative to their distance away from the view point when they are chosen by
+        // DefaultLodCallback, so the ratio approximates how much a missing chunk would be visible
+        float getScreenSpaceError(const QuadTreeNode& node, const osg::Vec3f& viewPoint, float cellWorldSize)
+        {
+            return node.getSize() * cellWorldSize / std::max(node.distance(viewPoint), 1.f);
+        }
     }
 
     void QuadTreeWorld::accept(osg::NodeVisitor& nv)
@@ -558,12 +572,35 @@ namespace Terrain
 
         reporter.addTotal(vd->getNumEntries());
 
-        for (unsigned int i = 0, n = vd->getNumEntries(); i < n && !abort; ++i)
+        if (vd->getNumEntries() == 0)
+            return;
+
+        // Node index is only read when loading the entries, so they can be loaded concurrently once it's built
+        if (vd->hasChanged())
+            vd->buildNodeIndex();
+
+        std::vector<std::pair<float, ViewDataEntry*>> prioritized;
+        prioritized.reserve(vd->getNumEntries());
+        for (unsigned int i = 0, n = vd->getNumEntries(); i < n; ++i)
         {
             ViewDataEntry& entry = vd->getEntry(i);
-            loadRenderingNode(entry, vd, cellWorldSize, grid, true);
-            reporter.addProgress(1);
+            prioritized.emplace_back(getScreenSpaceError(*entry.mNode, viewPoint, cellWorldSize), &entry);
         }
+        std::sort(prioritized.begin(), prioritized.end(),
+            [](const auto& l, const auto& r) { return l.first > r.first; });
+
+        std::vector<ViewDataEntry*> entries;
+        entries.reserve(prioritized.size());
+        for (const auto& [error, entry] : prioritized)
+            entries.push_back(entry);
+
+        // Entries claimed after an abort are skipped
+        SceneUtil::runParallelJobs(mWorkQueue.get(), entries.size(), [&](std::size_t i) {
+            if (abort)
+                return;
+            loadRenderingNode(*entries[i], vd, cellWorldSize, grid, true);
+            reporter.addProgress(1);
+        });
     }
 
     void QuadTreeWorld::reportStats(unsigned int frameNumber, osg::Stats* stats)
@@ -571,6 +608,18 @@ namespace Terrain
         if (mCompositeMapRenderer)
             stats->setAttribute(
                 frameNumber, "Composite", static_cast<double>(mCompositeMapRenderer->getCompileSetSize()));
+
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - mLastStatsTime).count();
+        mLastStatsTime = now;
+        const std::size_t chunksBuilt = mChunksBuilt.exchange(0, std::memory_order_relaxed);
+        if (seconds > 0)
+            stats->setAttribute(frameNumber, "Terrain Chunks Built/s", static_cast<double>(chunksBuilt) / seconds);
+    }
+
+    void QuadTreeWorld::setWorkQueue(SceneUtil::WorkQueue* workQueue)
+    {
+        mWorkQueue = workQueue;
     }
 
     void QuadTreeWorld::loadCell(int x, int y)
@@ -4,6 +4,8 @@
 #include "terraingrid.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
@@ -16,6 +18,11 @@ namespace osg
     class Stats;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
     class RootNode;
@@ -56,6 +63,9 @@ namespace Terrain
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) override;
 
+        /// Chunks are preloaded by the preloading thread alone when no work queue is set.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
         class ChunkManager
         {
         public:
@@ -106,6 +116,9 @@ namespace Terrain
         float mMinSize;
         bool mDebugTerrainChunks;
         std::unique_ptr<DebugChunkManager> mDebugChunkManager;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::atomic<std::size_t> mChunksBuilt{ 0 };
+        std::chrono::steady_clock::time_point mLastStatsTime = std::chrono::steady_clock::now();
     };
 
 }
@@ -16,6 +16,7 @@ namespace Terrain
 
     TerrainDrawable::TerrainDrawable(const TerrainDrawable& copy, const osg::CopyOp& copyop)
         : osg::Geometry(copy, copyop)
+        , mVertexDecodeMatrix(copy.mVertexDecodeMatrix)
         , mPasses(copy.mPasses)
         , mLightListCallback(copy.mLightListCallback)
     {
@@ -84,9 +85,13 @@ namespace Terrain
         if (osg::isNaN(depth))
             return;
 
+        osg::RefMatrix* drawMatrix = &matrix;
+        if (hasCompactVertices())
+            drawMatrix = cv->createOrReuseMatrix(mVertexDecodeMatrix * matrix);
+
         if (shadowcam)
         {
-            cv->addDrawableAndDepth(this, &matrix, depth);
+            cv->addDrawableAndDepth(this, drawMatrix, depth);
             return;
         }
 
@@ -105,7 +110,7 @@ namespace Terrain
         for (PassVector::const_iterator it = mPasses.begin(); it != mPasses.end(); ++it)
         {
             cv->pushStateSet(*it);
-            cv->addDrawableAndDepth(this, &matrix, depth);
+            cv->addDrawableAndDepth(this, drawMatrix, depth);
             cv->popStateSet();
         }
 
@@ -115,6 +120,57 @@ namespace Terrain
             cv->popStateSet();
     }
 
+    template <class Functor>
+    void acceptPrimitives(
+        const osg::Vec3Array& vertices, const osg::Geometry::PrimitiveSetList& primitiveSets, Functor& functor)
+    {
+        if (vertices.empty())
+            return;
+        functor.setVertexArray(vertices.getNumElements(), &vertices.front());
+        for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : primitiveSets)
+            primitiveSet->accept(functor);
+    }
+
+    void TerrainDrawable::accept(osg::PrimitiveFunctor& functor) const
+    {
+        if (hasCompactVertices())
+            acceptPrimitives(*getModelVertices(), getPrimitiveSetList(), functor);
+        else
+            osg::Geometry::accept(functor);
+    }
+
+    void TerrainDrawable::accept(osg::PrimitiveIndexFunctor& functor) const
+    {
+        if (hasCompactVertices())
+            acceptPrimitives(*getModelVertices(), getPrimitiveSetList(), functor);
+        else
+            osg::Geometry::accept(functor);
+    }
+
+    void TerrainDrawable::setVertexDecodeMatrix(const osg::Matrix& matrix)
+    {
+        mVertexDecodeMatrix = matrix;
+        dirtyBound();
+    }
+
+    bool TerrainDrawable::hasCompactVertices() const
+    {
+        const osg::Array* vertices = getVertexArray();
+        return vertices != nullptr && vertices->getType() == osg::Array::Vec3sArrayType;
+    }
+
+    osg::ref_ptr<const osg::Vec3Array> TerrainDrawable::getModelVertices() const
+    {
+        if (!hasCompactVertices())
+            return static_cast<const osg::Vec3Array*>(getVertexArray());
+
+        const osg::Vec3sArray& compact = static_cast<const osg::Vec3sArray&>(*getVertexArray());
+        osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array(compact.size());
+        for (std::size_t i = 0; i < compact.size(); ++i)
+            (*vertices)[i] = osg::Vec3f(compact[i].x(), compact[i].y(), compact[i].z()) * mVertexDecodeMatrix;
+        return vertices;
+    }
+
     void TerrainDrawable::createClusterCullingCallback()
     {
         mClusterCullingCallback = new osg::ClusterCullingCallback(this);
@@ -132,7 +188,7 @@ namespace Terrain
 
     void TerrainDrawable::setupWaterBoundingBox(float waterheight, float margin)
     {
-        osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>(getVertexArray());
+        const osg::ref_ptr<const osg::Vec3Array> vertices = getModelVertices();
         for (unsigned int i = 0; i < vertices->size(); ++i)
         {
             const osg::Vec3f& vertex = (*vertices)[i];
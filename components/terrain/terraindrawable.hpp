@@ -46,6 +46,10 @@ namespace Terrain
         void accept(osg::NodeVisitor& nv) override;
         void cull(osgUtil::CullVisitor* cv);
 
+        /// Primitive functors get model space vertices also for compact vertex arrays.
+        void accept(osg::PrimitiveFunctor& functor) const override;
+        void accept(osg::PrimitiveIndexFunctor& functor) const override;
+
         typedef std::vector<osg::ref_ptr<osg::StateSet>> PassVector;
         void setPasses(const PassVector& passes);
         const PassVector& getPasses() const { return mPasses; }
@@ -56,6 +60,12 @@ namespace Terrain
 
         void compileGLObjects(osg::RenderInfo& renderInfo) const override;
 
+        /// Compact vertices are stored as osg::Vec3sArray and mapped into model space by this matrix, which is applied
+        /// as part of the model view matrix at draw time.
+        void setVertexDecodeMatrix(const osg::Matrix& matrix);
+        const osg::Matrix& getVertexDecodeMatrix() const { return mVertexDecodeMatrix; }
+        bool hasCompactVertices() const;
+
         void setupWaterBoundingBox(float waterheight, float margin);
         const osg::BoundingBox& getWaterBoundingBox() const { return mWaterBoundingBox; }
 
@@ -64,6 +74,9 @@ namespace Terrain
         void setCompositeMapRenderer(CompositeMapRenderer* renderer) { mCompositeMapRenderer = renderer; }
 
     private:
+        osg::ref_ptr<const osg::Vec3Array> getModelVertices() const;
+
+        osg::Matrix mVertexDecodeMatrix;
         osg::BoundingBox mWaterBoundingBox;
         PassVector mPasses;
 
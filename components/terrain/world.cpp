@@ -124,6 +124,17 @@ namespace Terrain
         mCompositeMapRenderer->setTargetFrameRate(rate);
     }
 
+    void World::setCompactVertices(bool compact)
+    {
+        mChunkManager->setCompactVertices(compact);
+    }
+
+    void World::setCompositeMapCache(std::shared_ptr<const CompositeMapCache> cache, SceneUtil::WorkQueue* workQueue)
+    {
+        mChunkManager->setCompositeMapCache(cache);
+        mCompositeMapRenderer->setCompositeMapCache(std::move(cache), workQueue);
+    }
+
     float World::getHeightAt(const osg::Vec3f& worldPos)
     {
         return mStorage->getHeightAt(worldPos, mWorldspace);
@@ -28,12 +28,18 @@ namespace Loading
     class Reporter;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
     class Storage;
 
     class TextureManager;
     class ChunkManager;
+    class CompositeMapCache;
     class CompositeMapRenderer;
     class View;
     class HeightCullCallback;
@@ -58,6 +64,13 @@ namespace Terrain
         /// See CompositeMapRenderer::setTargetFrameRate
         void setTargetFrameRate(float rate);
 
+        /// See ChunkManager::setCompactVertices
+        /// @note Requires the terrainCompactVertices shader define to be set to the same value.
+        void setCompactVertices(bool compact);
+
+        /// Load composite maps from the cache and store rendered ones to it using the work queue.
+        void setCompositeMapCache(std::shared_ptr<const CompositeMapCache> cache, SceneUtil::WorkQueue* workQueue);
+
         /// Apply the scene manager's texture filtering settings to all cached textures.
         /// @note Thread safe.
         void updateTextureFiltering();
@@ -89,6 +89,29 @@
 --     radius = 10,
 -- })
 
+---
+-- A single request for @{#nearby.castRays}
+-- @type CastRaysRequest
+-- @field openmw.util#Vector3 from Start point of the ray.
+-- @field openmw.util#Vector3 to End point of the ray.
+-- @field #any ignore An @{openmw.core#GameObject} or @{openmw.core#ObjectList} to ignore
+-- @field #number collisionType Object types to work with (see @{openmw.nearby#COLLISION_TYPE})
+-- @field #number radius The radius of the ray (zero by default). If not zero then a sphere with given radius is cast.
+--  NOTE: currently `ignore` is not supported if `radius>0`.
+
+---
+-- Cast multiple rays at once and return the first collision of each one.
+-- Gives the same results as calling @{#nearby.castRay} for each request but is much cheaper for many rays because
+-- they are processed by several physics threads in parallel (if `async num threads` physics setting is greater than 0).
+-- @function [parent=#nearby] castRays
+-- @param #list<#CastRaysRequest> requests
+-- @return #list<#RayCastingResult> Results in the same order as requests.
+-- @usage local results = nearby.castRays({
+--     {from = self.position, to = pointA, ignore = self},
+--     {from = self.position, to = pointB, ignore = self},
+-- })
+-- for i, res in ipairs(results) do if res.hit then print(i, res.hitPos) end end
+
 ---
 -- A table of parameters for @{#nearby.castRenderingRay} and @{#nearby.asyncCastRenderingRay}
 -- @type CastRenderingRayOptions
@@ -68,6 +68,10 @@ varying vec4 passTangent;
 #include "compatibility/normals.glsl"
 #include "lib/view/depth.glsl"
 
+#if @instancing
+#include "lib/util/instancing.glsl"
+#endif
+
 #if @particleOcclusion
 varying vec3 orthoDepthMapCoord;
 
@@ -79,22 +83,33 @@ uniform vec2 screenRes;
 
 void main(void)
 {
+#if @instancing
+    vec4 vertex = instanceVertex(gl_Vertex);
+    vec3 normal = instanceDirection(gl_Normal.xyz);
+#else
+    vec4 vertex = gl_Vertex;
+    vec3 normal = gl_Normal.xyz;
+#endif
+
 #if @particleOcclusion
     mat4 model = osg_ViewMatrixInverse * gl_ModelViewMatrix;
-    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(gl_Vertex.xyz, 1.0)).xyz;
+    orthoDepthMapCoord = ((depthSpaceMatrix * model) * vec4(vertex.xyz, 1.0)).xyz;
 #endif
 
-    gl_Position = modelToClip(gl_Vertex);
+    gl_Position = modelToClip(vertex);
 
-    vec4 viewPos = modelToView(gl_Vertex);
+    vec4 viewPos = modelToView(vertex);
     gl_ClipVertex = viewPos;
     passColor = gl_Color;
     passViewPos = viewPos.xyz;
-    passNormal = gl_Normal.xyz;
+    passNormal = normal;
     normalToViewMatrix = gl_NormalMatrix;
 
 #if @normalMap || @diffuseParallax
     passTangent = gl_MultiTexCoord7.xyzw;
+#if @instancing
+    passTangent.xyz = instanceDirection(passTangent.xyz);
+#endif
     normalToViewMatrix *= generateTangentSpace(passTangent, passNormal);
 #endif
 
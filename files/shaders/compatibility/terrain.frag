@@ -72,7 +72,7 @@ void main()
 #endif
     vec3 viewNormal = normalToView(normal);
 #else
-    vec3 viewNormal = normalize(gl_NormalMatrix * passNormal);
+    vec3 viewNormal = normalToView(passNormal);
 #endif
 
     float shadowing = unshadowedLightRatio(linearDepth);
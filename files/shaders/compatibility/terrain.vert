@@ -40,7 +40,16 @@ void main(void)
     passColor = gl_Color;
     passNormal = gl_Normal.xyz;
     passViewPos = viewPos.xyz;
-    normalToViewMatrix = gl_NormalMatrix;
+
+    mat3 normalMatrix = gl_NormalMatrix;
+#if @terrainCompactVertices
+    // Compact vertices are scaled into model space by the model view matrix, which must not apply to normals
+    mat3 modelToViewMatrix = mat3(gl_ModelViewMatrix);
+    normalMatrix *= mat3(length(modelToViewMatrix[0]), 0.0, 0.0,
+                         0.0, length(modelToViewMatrix[1]), 0.0,
+                         0.0, 0.0, length(modelToViewMatrix[2]));
+#endif
+    normalToViewMatrix = normalMatrix;
 
 #if @normalMap
     mat3 tbnMatrix = generateTangentSpace(vec4(1.0, 0.0, 0.0, 1.0), passNormal);
@@ -49,7 +58,7 @@ void main(void)
 #endif
 
 #if !PER_PIXEL_LIGHTING || @shadows_enabled
-    vec3 viewNormal = normalize(gl_NormalMatrix * passNormal);
+    vec3 viewNormal = normalize(normalMatrix * passNormal);
 #endif
 
 #if !PER_PIXEL_LIGHTING
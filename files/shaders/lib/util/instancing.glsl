@@ -0,0 +1,34 @@
+#ifndef LIB_UTIL_INSTANCING
+#define LIB_UTIL_INSTANCING
+
+// Per instance data bound with a vertex attribute divisor: position relative to the drawable and uniform scale,
+// rotation as ESM angles applied in the same order as Misc::Convert::makeOsgQuat.
+attribute vec4 aOffset;
+attribute vec3 aRotation;
+
+mat3 instanceRotation(vec3 angle)
+{
+    float sin_x = sin(angle.x);
+    float cos_x = cos(angle.x);
+    float sin_y = sin(angle.y);
+    float cos_y = cos(angle.y);
+    float sin_z = sin(angle.z);
+    float cos_z = cos(angle.z);
+
+    return mat3(
+        cos_z*cos_y+sin_x*sin_y*sin_z, -sin_z*cos_x, cos_z*sin_y+sin_z*sin_x*cos_y,
+        sin_z*cos_y+cos_z*sin_x*sin_y, cos_z*cos_x, sin_z*sin_y-cos_z*sin_x*cos_y,
+        -sin_y*cos_x, sin_x, cos_x*cos_y);
+}
+
+vec4 instanceVertex(vec4 vertex)
+{
+    return vec4(instanceRotation(aRotation) * (vertex.xyz * aOffset.w) + aOffset.xyz, 1.0);
+}
+
+vec3 instanceDirection(vec3 direction)
+{
+    return instanceRotation(aRotation) * direction;
+}
+
+#endif